@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench_pin.hpp"
+
+// logger_bench [--cpu=N] [Google Benchmark flags]
+//
+// --cpu=N pins the main thread to CPU N and benchmark threads to the CPUs
+// after it (default 0; -1 leaves scheduling to the OS). For numbers that
+// compare across commits, also pass --benchmark_out=<file>
+// --benchmark_out_format=json, or use the run_benchmarks target.
+int main(int argc, char** argv)
+{
+    int cpu = 0;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--cpu=", 6) == 0)
+            cpu = std::atoi(argv[i] + 6);
+        else
+            args.push_back(argv[i]);
+    }
+
+    if (!bench::init_pinning(cpu))
+    {
+        std::fprintf(stderr, "logger_bench: CPU %d is not available to this process\n", cpu);
+        return 1;
+    }
+    bench::pin_index(0);
+    benchmark::AddCustomContext("pinned_cpu", bench::cpu_for(0) < 0 ? "none" : std::to_string(bench::cpu_for(0)));
+
+    int n = static_cast<int>(args.size());
+    benchmark::Initialize(&n, args.data());
+    if (benchmark::ReportUnrecognizedArguments(n, args.data()))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
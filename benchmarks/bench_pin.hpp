@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+// CPU pinning for the benchmarks. bench_main picks the first CPU (--cpu=N);
+// benchmark thread i, and any thread a benchmark starts itself, runs on
+// the i-th allowed CPU from there, wrapping around.
+namespace bench
+{
+    inline std::vector<int> g_cpus;     // CPUs the process may use, captured before pinning
+    inline std::size_t      g_first = 0;
+    inline bool             g_pinned = false;
+
+    // False if `first_cpu` is not one the process may run on. A negative
+    // first_cpu turns pinning off.
+    inline bool init_pinning(int first_cpu) noexcept
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) != 0)
+            return false;
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set))
+                g_cpus.push_back(c);
+
+        if (first_cpu < 0)
+            return true;
+        for (std::size_t i = 0; i < g_cpus.size(); ++i)
+            if (g_cpus[i] == first_cpu)
+            {
+                g_first = i;
+                g_pinned = true;
+                return true;
+            }
+        return false;
+    }
+
+    // -1 when pinning is off.
+    inline int cpu_for(std::size_t index) noexcept
+    {
+        return g_pinned ? g_cpus[(g_first + index) % g_cpus.size()] : -1;
+    }
+
+    inline void pin_index(std::size_t index) noexcept
+    {
+        const int cpu = cpu_for(index);
+        if (cpu < 0)
+            return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+} // namespace bench
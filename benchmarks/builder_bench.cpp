@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <tuple>
+
+#include "bench_pin.hpp"
+#include "logger/registry/builder.hpp"
+#include "logger/registry/header_args.hpp"
+
+using logger::registry::Builder;
+using logger::registry::PayloadRegister;
+
+namespace
+{
+    constexpr std::string_view kPath = "/api/v1/orders/42";
+
+    // What Handler::log did before LogEngine::emplace: pack the arguments,
+    // then Builder::build a payload from them.
+    void BM_Builder_Build_Generic(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        std::uint64_t ts = 0;
+        for (auto _ : state)
+        {
+            auto args = logger::registry::pack_header_args(Severity::Info, ++ts, std::uint32_t{7}, std::uint32_t{9},
+                                                           std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1});
+            auto payload = Builder::build<MsgTag::Generic>(args);
+            benchmark::DoNotOptimize(payload);
+        }
+    }
+
+    void BM_Builder_Build_Request(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        std::uint64_t ts = 0;
+        for (auto _ : state)
+        {
+            ++ts;
+            auto args = logger::registry::pack_header_args(Severity::Info, ts, std::uint32_t{7}, std::uint32_t{9},
+                                                           std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1},
+                                                           ts, kPath);
+            auto payload = Builder::build<MsgTag::Request>(args);
+            benchmark::DoNotOptimize(payload);
+        }
+    }
+
+    // LogEngine::emplace's step: fields assigned into a payload already
+    // in place.
+    void BM_Builder_Assign_Request(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        using P = PayloadRegister<MsgTag::Request>::payload_type;
+        alignas(P) unsigned char storage[sizeof(P)];
+        std::uint64_t ts = 0;
+        for (auto _ : state)
+        {
+            P* payload = new (storage) P{};
+            ++ts;
+            Builder::assign<MsgTag::Request>(*payload, std::forward_as_tuple(
+                Severity::Info, ts, std::uint32_t{7}, std::uint32_t{9},
+                std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1}, ts, kPath));
+            benchmark::DoNotOptimize(payload);
+            benchmark::ClobberMemory();
+        }
+    }
+} // namespace
+
+BENCHMARK(BM_Builder_Build_Generic);
+BENCHMARK(BM_Builder_Build_Request);
+BENCHMARK(BM_Builder_Assign_Request);
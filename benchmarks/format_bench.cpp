@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "bench_pin.hpp"
+#include "logger/core/stream_adapter.hpp"
+#include "logger/registry/payload_register.hpp"
+#include "publisher/sink_publisher.hpp"
+
+using logger::core::detail::SpanStringBuf;
+using Request = logger::registry::RequestPayload;
+
+namespace
+{
+    Request sample()
+    {
+        Request p{};
+        p.severity       = Severity::Warn;
+        p.timestamp      = 1'760'000'000'000'000ull;    // us since the epoch
+        p.thread_id      = 7;
+        p.request_id     = 4242;
+        p.class_id       = static_cast<std::uint16_t>(LogClassId::Handler);
+        p.method_id      = static_cast<std::uint16_t>(MethodId::Handler_Run);
+        p.schema_version = 1;
+        p.req_unique_id  = 99;
+        p.path           = "/api/v1/orders/42";
+        return p;
+    }
+
+    // The worker's fallback for envelopes without format_to: debug_print
+    // through an ostream over the staging buffer.
+    void BM_Format_DebugPrint(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        const Request p = sample();
+        char out[1024];
+        SpanStringBuf buf;
+        std::ostream os(&buf);
+        for (auto _ : state)
+        {
+            buf.reset(out, sizeof(out));
+            p.debug_print(os);
+            benchmark::DoNotOptimize(buf.written());
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // The same text without iostreams (PayloadBase::format_to).
+    void BM_Format_FormatTo(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        const Request p = sample();
+        char out[1024];
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(p.format_to(out, sizeof(out)));
+            benchmark::ClobberMemory();
+        }
+    }
+
+    std::string sample_line()
+    {
+        char out[1024];
+        const Request p = sample();
+        return std::string(out, p.format_to(out, sizeof(out)));
+    }
+
+    // TextSink on a debug_print line: date, class and method names.
+    void BM_TextSink_FormatImpl(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        const std::string line = sample_line();
+        for (auto _ : state)
+        {
+            std::string text = TextSink::format_impl(line);
+            benchmark::DoNotOptimize(text);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * line.size()));
+    }
+
+    void BM_TextSink_FormatTo(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        const std::string line = sample_line();
+        char out[TextSink::kStackLine];
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(TextSink::format_to(line, out, sizeof(out)));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * line.size()));
+    }
+} // namespace
+
+BENCHMARK(BM_Format_DebugPrint);
+BENCHMARK(BM_Format_FormatTo);
+BENCHMARK(BM_TextSink_FormatImpl);
+BENCHMARK(BM_TextSink_FormatTo);
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+
+#include "bench_pin.hpp"
+#include "logger/core/lockfree_queue.hpp"
+#include "logger/core/log_record.hpp"
+#include "logger/core/tagged_freelist.hpp"
+
+using logger::core::detail::FreeList;
+using logger::core::detail::FreeNode;
+using logger::core::detail::LogRecord;
+using logger::core::detail::TaggedFreeList;
+
+namespace
+{
+    constexpr std::size_t kPool = 1024;
+
+    template <typename List>
+    struct Pool
+    {
+        std::unique_ptr<LogRecord[]> records = std::make_unique<LogRecord[]>(kPool);
+        List list;
+
+        Pool()
+        {
+            list.attach(records.get(), kPool);
+            for (std::size_t i = 0; i < kPool; ++i)
+                list.push(&records[i]);
+        }
+    };
+
+    template <typename List>
+    std::unique_ptr<Pool<List>> g_pool;
+
+    // Every thread takes a record and gives it back, as producers and the
+    // worker do with the LogEngine pool; all threads hit the same head.
+    template <typename List>
+    void BM_FreeList_PopPush(benchmark::State& state)
+    {
+        bench::pin_index(static_cast<std::size_t>(state.thread_index()));
+        if (state.thread_index() == 0)
+            g_pool<List> = std::make_unique<Pool<List>>();
+
+        std::size_t empty = 0;
+        for (auto _ : state)
+        {
+            List& list = g_pool<List>->list;
+            FreeNode* n = list.try_pop();
+            if (!n) [[unlikely]]
+            {
+                ++empty;
+                continue;
+            }
+            benchmark::DoNotOptimize(n);
+            list.push(n);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["empty"] = benchmark::Counter(static_cast<double>(empty));
+    }
+} // namespace
+
+BENCHMARK(BM_FreeList_PopPush<FreeList>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_FreeList_PopPush<TaggedFreeList>)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "bench_pin.hpp"
+#include "logger/logger.hpp"
+
+using logger::core::EngineConfig;
+using logger::core::LogClock;
+using logger::core::SinkFormat;
+using logger::core::detail::LogEngine;
+
+namespace
+{
+    // The real LogEngine, writing binary frames to /dev/null so the sink
+    // costs the worker next to nothing. Its worker thread is started from
+    // a thread pinned to the last CPU in the rotation, away from the
+    // benchmark threads, and inherits that pinning.
+    LogEngine& engine()
+    {
+        static LogEngine& eng = []() -> LogEngine& {
+            EngineConfig cfg;
+            cfg.sink_format = SinkFormat::Binary;
+            cfg.binary_file.path = "/dev/null";
+            cfg.pool_size = 1u << 16;
+
+            LogEngine& e = LogEngine::instance();
+            if (!e.configure(cfg))
+            {
+                std::fprintf(stderr, "handler_bench: LogEngine::configure failed\n");
+                std::abort();
+            }
+
+            std::thread starter([] {
+                bench::pin_index(bench::g_cpus.size() - 1);
+                logger::Handler::log<MsgTag::Generic>(Severity::Info, std::uint64_t{0}, std::uint32_t{0},
+                                                      std::uint32_t{0}, std::uint16_t{0}, std::uint16_t{0},
+                                                      std::uint16_t{1});
+            });
+            starter.join();
+            return e;
+        }();
+        return eng;
+    }
+
+    // Cost of the two clock reads around each call, taken off every sample.
+    std::uint64_t clock_overhead_ns()
+    {
+        const LogClock& clock = LogClock::instance();
+        std::vector<std::uint64_t> d(10'000);
+        for (auto& v : d)
+        {
+            const std::uint64_t t0 = clock.now_ns();
+            v = clock.now_ns() - t0;
+        }
+        std::nth_element(d.begin(), d.begin() + d.size() / 2, d.end());
+        return d[d.size() / 2];
+    }
+
+    double percentile(const std::vector<std::uint64_t>& sorted, double q)
+    {
+        if (sorted.empty())
+            return 0;
+        const auto i = std::min(sorted.size() - 1, static_cast<std::size_t>(q * static_cast<double>(sorted.size())));
+        return static_cast<double>(sorted[i]);
+    }
+
+    // Producer-side latency of one Handler::log call (emplace into a pool
+    // record, DropNewest), every call timed. Counters are nanoseconds per
+    // call, averaged over the threads; dropped is the share of calls that
+    // found the pool empty.
+    void BM_HandlerLog_Latency(benchmark::State& state)
+    {
+        bench::pin_index(static_cast<std::size_t>(state.thread_index()));
+        LogEngine& eng = engine();
+        const LogClock& clock = LogClock::instance();
+        const std::uint64_t overhead = clock_overhead_ns();
+
+        constexpr std::size_t kMaxSamples = 1u << 22;
+        std::vector<std::uint64_t> samples;
+        samples.reserve(kMaxSamples);
+
+        const std::uint64_t dropped_before = eng.dropped();
+        std::uint64_t ts = 0;
+        for (auto _ : state)
+        {
+            const std::uint64_t t0 = clock.now_ns();
+            logger::Handler::log<MsgTag::Generic>(Severity::Info, ++ts, std::uint32_t{7}, std::uint32_t{9},
+                                                  std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1});
+            const std::uint64_t d = clock.now_ns() - t0;
+            if (samples.size() < kMaxSamples)
+                samples.push_back(d > overhead ? d - overhead : 0);
+        }
+
+        std::sort(samples.begin(), samples.end());
+        using benchmark::Counter;
+        state.counters["p50_ns"]  = Counter(percentile(samples, 0.50), Counter::kAvgThreads);
+        state.counters["p90_ns"]  = Counter(percentile(samples, 0.90), Counter::kAvgThreads);
+        state.counters["p99_ns"]  = Counter(percentile(samples, 0.99), Counter::kAvgThreads);
+        state.counters["p999_ns"] = Counter(percentile(samples, 0.999), Counter::kAvgThreads);
+        state.counters["max_ns"]  = Counter(samples.empty() ? 0.0 : static_cast<double>(samples.back()),
+                                            Counter::kAvgThreads);
+        if (state.thread_index() == 0)
+            state.counters["dropped"] = static_cast<double>(eng.dropped() - dropped_before) /
+                                        static_cast<double>(state.iterations() * static_cast<std::uint64_t>(state.threads()));
+        state.SetItemsProcessed(state.iterations());
+    }
+} // namespace
+
+BENCHMARK(BM_HandlerLog_Latency)->ThreadRange(1, 4)->UseRealTime();
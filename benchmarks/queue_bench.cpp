@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bench_pin.hpp"
+#include "logger/core/lockfree_queue.hpp"
+
+using logger::core::detail::MpscNode;
+using logger::core::detail::MpscQueue;
+
+namespace
+{
+    // One producer and the consumer on the same thread: the cost of a
+    // push and a pop with no contention.
+    void BM_MpscQueue_PushPop(benchmark::State& state)
+    {
+        bench::pin_index(0);
+        constexpr std::size_t kBatch = 64;
+        std::vector<MpscNode> nodes(kBatch + 1);
+        MpscQueue q;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kBatch; ++i)
+                q.push(&nodes[i]);
+            for (std::size_t i = 0; i < kBatch; ++i)
+                benchmark::DoNotOptimize(q.pop());
+            // The last node popped is the queue's dummy head until the
+            // next push; hand it a fresh one so no node is pushed twice.
+            q.reset();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    }
+
+    // range(0) producers push kPerProducer nodes each while one consumer
+    // pops them all; time from the start signal to the last pop.
+    void BM_MpscQueue_Throughput(benchmark::State& state)
+    {
+        const auto producers = static_cast<std::size_t>(state.range(0));
+        constexpr std::size_t kPerProducer = 100'000;
+
+        std::vector<std::unique_ptr<MpscNode[]>> nodes;
+        for (std::size_t p = 0; p < producers; ++p)
+            nodes.push_back(std::make_unique<MpscNode[]>(kPerProducer));
+
+        for (auto _ : state)
+        {
+            MpscQueue q;
+            std::atomic<bool> go{false};
+            std::vector<std::thread> threads;
+            for (std::size_t p = 0; p < producers; ++p)
+                threads.emplace_back([&, p] {
+                    bench::pin_index(p + 1);
+                    while (!go.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    for (std::size_t i = 0; i < kPerProducer; ++i)
+                        q.push(&nodes[p][i]);
+                });
+
+            bench::pin_index(0);
+            const auto t0 = std::chrono::steady_clock::now();
+            go.store(true, std::memory_order_release);
+            std::size_t popped = 0;
+            while (popped < producers * kPerProducer)
+                if (q.pop())
+                    ++popped;
+            const auto t1 = std::chrono::steady_clock::now();
+
+            for (auto& t : threads)
+                t.join();
+            state.SetIterationTime(std::chrono::duration<double>(t1 - t0).count());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * producers * kPerProducer));
+    }
+} // namespace
+
+BENCHMARK(BM_MpscQueue_PushPop);
+BENCHMARK(BM_MpscQueue_Throughput)->ArgName("producers")->Arg(1)->Arg(2)->Arg(4)->UseManualTime();
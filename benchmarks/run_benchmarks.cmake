@@ -0,0 +1,40 @@
+# cmake -DBENCH=<logger_bench> -DCPU=<n> -DOUT=<file.json> -DSOURCE_DIR=<repo> -P run_benchmarks.cmake
+#
+# Runs the suite once with JSON output; the git commit (and whether the
+# tree was dirty) goes into the JSON context next to the host details
+# Google Benchmark records itself.
+
+execute_process(
+    COMMAND git rev-parse --short=12 HEAD
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE commit
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+if(NOT commit)
+    set(commit unknown)
+endif()
+
+execute_process(
+    COMMAND git status --porcelain --untracked-files=no
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE dirty
+    OUTPUT_STRIP_TRAILING_WHITESPACE
+    ERROR_QUIET
+)
+if(dirty)
+    set(commit ${commit}-dirty)
+endif()
+
+execute_process(
+    COMMAND ${BENCH}
+        --cpu=${CPU}
+        --benchmark_out=${OUT}
+        --benchmark_out_format=json
+        --benchmark_context=git_commit=${commit}
+    RESULT_VARIABLE rc
+)
+if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "logger_bench failed: ${rc}")
+endif()
+message(STATUS "Results: ${OUT}")
@@ -8,3 +8,14 @@ enum class MsgTag  : std::uint8_t {
 #undef X
   Count
 };
+
+[[nodiscard]] constexpr const char* toString(MsgTag tag) noexcept
+{
+    switch (tag)
+    {
+#define X(M) case MsgTag::M: return #M;
+#include "common/messages/log_message.def"
+#undef X
+        default: return "UnknownTag";
+    }
+}
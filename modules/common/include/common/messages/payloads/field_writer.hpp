@@ -0,0 +1,91 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+// Text writer behind PayloadBase::format_to. Appends into a caller-owned
+// [dst, dst + cap) with std::to_chars, no streambuf and no locale, and keeps
+// counting once the buffer is full so size() is always the length the whole
+// text needs (snprintf-style).
+//
+// Types are written as operator<< would write them with default flags,
+// except that 1-byte integers are numbers rather than characters.
+class FieldWriter
+{
+public:
+    FieldWriter(char* dst, std::size_t cap) noexcept
+        : begin_(dst), p_(dst), end_(dst + cap) {}
+
+    void put(char c) noexcept
+    {
+        if (p_ != end_)
+            *p_++ = c;
+        ++need_;
+    }
+
+    void put(std::string_view s) noexcept
+    {
+        const std::size_t room = static_cast<std::size_t>(end_ - p_);
+        const std::size_t n = s.size() < room ? s.size() : room;
+        std::memcpy(p_, s.data(), n);
+        p_ += n;
+        need_ += s.size();
+    }
+
+    void put(const char* s) noexcept { put(std::string_view{s}); }
+
+    template <typename T>
+        requires (std::integral<T> && !std::same_as<T, char> && !std::same_as<T, bool>)
+    void put(T v) noexcept
+    {
+        using Wide = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+        put_chars(static_cast<Wide>(v));
+    }
+
+    void put(bool v) noexcept { put(v ? '1' : '0'); }
+
+    template <std::floating_point T>
+    void put(T v) noexcept
+    {
+        // %g with the default precision, as std::ostream.
+        put_chars(v, std::chars_format::general, 6);
+    }
+
+    // Enums with a toString(E) overload, e.g. Severity.
+    template <typename E>
+        requires (std::is_enum_v<E> && requires(E e) { { toString(e) } -> std::convertible_to<std::string_view>; })
+    void put(E v) noexcept { put(std::string_view{toString(v)}); }
+
+    // Bytes the full text needs; written() < size() means it was truncated.
+    std::size_t size()    const noexcept { return need_; }
+    std::size_t written() const noexcept { return static_cast<std::size_t>(p_ - begin_); }
+
+private:
+    // Wide enough for any 64-bit integer and a %g double.
+    static constexpr std::size_t kScratch = 32;
+
+    template <typename T, typename... Fmt>
+    void put_chars(T v, Fmt... fmt) noexcept
+    {
+        if (static_cast<std::size_t>(end_ - p_) >= kScratch)
+        {
+            char* const next = std::to_chars(p_, end_, v, fmt...).ptr;
+            need_ += static_cast<std::size_t>(next - p_);
+            p_ = next;
+            return;
+        }
+
+        char tmp[kScratch];
+        const char* const next = std::to_chars(tmp, tmp + kScratch, v, fmt...).ptr;
+        put(std::string_view{tmp, static_cast<std::size_t>(next - tmp)});
+    }
+
+    char* const begin_;
+    char*       p_;
+    char* const end_;
+    std::size_t need_ = 0;
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "common/messages/payloads/field_writer.hpp"
+
+// JSON string values through FieldWriter: the quotes, with '"', '\\' and
+// control characters escaped (\n, \r, \t, else \u00XX). Other bytes,
+// UTF-8 included, are copied as they are.
+
+// The escape sequence for one byte that needs it.
+inline void put_json_escape(FieldWriter& w, unsigned char c) noexcept
+{
+    static constexpr char kHex[] = "0123456789abcdef";
+    switch (c)
+    {
+        case '"':  w.put("\\\""); break;
+        case '\\': w.put("\\\\"); break;
+        case '\n': w.put("\\n");  break;
+        case '\r': w.put("\\r");  break;
+        case '\t': w.put("\\t");  break;
+        default:
+        {
+            const char u[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+            w.put(std::string_view{u, sizeof(u)});
+        }
+    }
+}
+
+[[nodiscard]] constexpr bool json_needs_escape(unsigned char c) noexcept
+{
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+// Byte at a time; the reference for put_json_string and its tail.
+inline void put_json_chars_scalar(FieldWriter& w, std::string_view s) noexcept
+{
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < s.size(); ++i)
+    {
+        const auto c = static_cast<unsigned char>(s[i]);
+        if (!json_needs_escape(c))
+            continue;
+        w.put(s.substr(run, i - run));
+        put_json_escape(w, c);
+        run = i + 1;
+    }
+    w.put(s.substr(run));
+}
+
+// Escaped contents without the quotes. With SSE2 the string is scanned 16
+// bytes at a time and clean runs are copied whole, so a path with nothing
+// to escape costs one compare per 16 bytes and one memcpy.
+inline void put_json_chars(FieldWriter& w, std::string_view s) noexcept
+{
+#if defined(__SSE2__)
+    const char* const p = s.data();
+    const std::size_t n = s.size();
+    const __m128i quote     = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i ctrl_max  = _mm_set1_epi8(0x1F);
+
+    std::size_t run = 0;    // start of the bytes not yet written
+    std::size_t i = 0;
+    while (i + 16 <= n)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        const __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+            _mm_cmpeq_epi8(_mm_min_epu8(v, ctrl_max), v));      // v <= 0x1F, unsigned
+        auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+        if (mask == 0)
+        {
+            i += 16;
+            continue;
+        }
+
+        while (mask)
+        {
+            const std::size_t at = i + static_cast<std::size_t>(__builtin_ctz(mask));
+            w.put(std::string_view{p + run, at - run});
+            put_json_escape(w, static_cast<unsigned char>(p[at]));
+            run = at + 1;
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+    w.put(std::string_view{p + run, i - run});
+    put_json_chars_scalar(w, s.substr(i));
+#else
+    put_json_chars_scalar(w, s);
+#endif
+}
+
+inline void put_json_string(FieldWriter& w, std::string_view s) noexcept
+{
+    w.put('"');
+    put_json_chars(w, s);
+    w.put('"');
+}
@@ -7,6 +7,7 @@
 #include <string_view>
 
 #include "common/messages/log_message.hpp"
+#include "common/messages/payloads/field_writer.hpp"
 
 template<std::size_t N>
 struct Padding
@@ -21,6 +22,17 @@ struct Padding<0>
 
 enum class Severity : std::uint8_t { Info, Warn, Error };
 
+constexpr std::string_view toString(Severity s) noexcept
+{
+    switch (s)
+    {
+        case Severity::Info:  return "Info";
+        case Severity::Warn:  return "Warn";
+        case Severity::Error: return "Error";
+    }
+    return "Unknown";
+}
+
 inline std::ostream& operator<<(std::ostream& os, Severity s)
 {
     switch (s)
@@ -94,6 +106,33 @@ struct PayloadBase
     {
         static_cast<const Derived*>(this)->debug_impl(os);
     }
+
+    // print_header without iostreams: field names are literals from the
+    // .def, values go through std::to_chars.
+    void format_header(FieldWriter& w) const
+    {
+        w.put("[tag=");
+        w.put(static_cast<int>(type_id));
+        w.put("] ");
+
+        #define X(C,F) w.put(#F "="); w.put(F); w.put(' ');
+        #include "common/messages/payloads/log_payloads.def"
+        #undef X
+    }
+
+    // Same text as debug_print, written into [dst, dst + cap). Returns the
+    // length the full text needs; anything past cap is cut off.
+    // Derived types that print more than the header provide
+    // format_impl(FieldWriter&) next to debug_impl.
+    std::size_t format_to(char* dst, std::size_t cap) const
+    {
+        FieldWriter w{dst, cap};
+        if constexpr (requires(const Derived& d) { d.format_impl(w); })
+            static_cast<const Derived*>(this)->format_impl(w);
+        else
+            format_header(w);
+        return w.size();
+    }
 };
 
 template<MsgTag Tag, typename Derived>
@@ -17,4 +17,11 @@ struct alignas(64) RequestPayload  : PayloadBase<MsgTag::Request, RequestPayload
     #undef X
 }
 
+  void format_impl(FieldWriter& w) const {
+    format_header(w);
+    #define X(C,F) w.put(#F "="); w.put(F); w.put(' ');
+    #include "common/messages/payloads/log_requestpayload.def"
+    #undef X
+  }
+
 };
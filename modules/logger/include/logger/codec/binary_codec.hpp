@@ -0,0 +1,400 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "common/messages/log_message.hpp"
+#include "common/messages/payloads/payloads.hpp"
+#include "logger/codec/json_codec.hpp"
+#include "logger/log_limit.hpp"
+#include "logger/registry/payload_register.hpp"
+
+// Binary (deferred-formatting) log encoding.
+//
+// The worker copies payload fields into frames instead of formatting text;
+// logdecode turns a file of frames back into text or JSON. Both sides walk
+// PayloadRegister<Tag>::field_ptrs, i.e. the X-macro schema in
+// log_payloads.def and the per-tag body .def files.
+//
+// File:  FileHeader, then frames back to back.
+// Frame: u16 frame_len | u8 MsgTag | u16 schema_version | fields...
+//        frame_len counts every byte after itself, so a reader can skip
+//        frames it cannot parse. kFoldedFlag in the tag byte: the fields
+//        are followed by u64 suppressed (limit::Folded); readers that do
+//        not know the flag skip the frame as an unknown tag. kTextTag: the
+//        rest of the frame is the text of an envelope outside the schema.
+// Field: arithmetic and enum types raw (sizeof(T) bytes, host byte order —
+//        the header records which); std::string_view as u16 length + bytes,
+//        truncated to what fits.
+namespace logger::codec
+{
+    inline constexpr std::array<char, 8> kFileMagic{'M', 'Y', 'S', 'L', 'O', 'G', 'B', '1'};
+    inline constexpr std::uint16_t kFormatVersion = 1;
+    inline constexpr std::uint16_t kByteOrderMark = 0x0102;
+
+    struct FileHeader
+    {
+        std::array<char, 8> magic = kFileMagic;
+        std::uint16_t version     = kFormatVersion;
+        std::uint16_t byte_order  = kByteOrderMark;
+    };
+    static_assert(sizeof(FileHeader) == 12 && std::is_trivially_copyable_v<FileHeader>);
+
+    inline constexpr std::size_t kFramePrefix = sizeof(std::uint16_t) + sizeof(std::uint8_t) + sizeof(std::uint16_t);
+    inline constexpr std::size_t kMaxFrame    = sizeof(std::uint16_t) + 0xFFFF;
+    inline constexpr std::uint8_t kFoldedFlag = 0x80;
+    inline constexpr std::uint8_t kTextTag    = 0x7F;
+
+    static_assert(static_cast<std::uint8_t>(MsgTag::Count) < kTextTag);
+
+    // Payload types the codec knows the layout of.
+    template <typename E>
+    concept BinaryEncodable = Encodable<E>;
+
+    namespace detail
+    {
+        template <typename T>
+        concept RawField = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+        template <RawField T>
+        bool put(char*& p, const char* end, const T& v) noexcept
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(T))
+                return false;
+            std::memcpy(p, &v, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+
+        inline bool put(char*& p, const char* end, std::string_view v) noexcept
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(std::uint16_t))
+                return false;
+
+            std::size_t n = v.size();
+            const std::size_t room = static_cast<std::size_t>(end - p) - sizeof(std::uint16_t);
+            if (n > room)   n = room;
+            if (n > 0xFFFF) n = 0xFFFF;
+
+            const auto len = static_cast<std::uint16_t>(n);
+            put(p, end, len);
+            std::memcpy(p, v.data(), n);
+            p += n;
+            return true;
+        }
+
+        template <RawField T>
+        bool get(const char*& p, const char* end, T& v) noexcept
+        {
+            if (static_cast<std::size_t>(end - p) < sizeof(T))
+                return false;
+            std::memcpy(&v, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+
+        // The view points into the input buffer.
+        inline bool get(const char*& p, const char* end, std::string_view& v) noexcept
+        {
+            std::uint16_t len = 0;
+            if (!get(p, end, len) || static_cast<std::size_t>(end - p) < len)
+                return false;
+            v = std::string_view{p, len};
+            p += len;
+            return true;
+        }
+    } // namespace detail
+
+    // Encode one frame into [dst, dst + cap); returns its size, or 0 if
+    // even the fixed-size fields do not fit.
+    template <BinaryEncodable Payload>
+    std::size_t encode(const Payload& obj, char* dst, std::size_t cap) noexcept
+    {
+        using Reg = registry::PayloadRegister<Payload::type_id>;
+
+        if (cap > kMaxFrame)
+            cap = kMaxFrame;
+        if (cap < kFramePrefix)
+            return 0;
+
+        char* p = dst + kFramePrefix;
+        const char* end = dst + cap;
+
+        const bool ok = std::apply([&](auto... ptr) {
+            return (detail::put(p, end, obj.*ptr) && ...);
+        }, Reg::field_ptrs);
+        if (!ok)
+            return 0;
+
+        auto tag = static_cast<std::uint8_t>(Payload::type_id);
+        if constexpr (registry::FoldedPayload<Payload>)
+        {
+            if (!detail::put(p, end, static_cast<std::uint64_t>(obj.suppressed)))
+                return 0;
+            tag |= kFoldedFlag;
+        }
+
+        const auto size = static_cast<std::size_t>(p - dst);
+        char* q = dst;
+        detail::put(q, end, static_cast<std::uint16_t>(size - sizeof(std::uint16_t)));
+        detail::put(q, end, tag);
+        detail::put(q, end, obj.schema_version);
+        return size;
+    }
+
+    // A text frame holding what fill(dst, room) writes, for envelopes the
+    // schema does not cover; fill returns the length of its text, which
+    // is cut to room. Returns the frame size, or 0 if the prefix does not
+    // fit.
+    template <typename Fill>
+    std::size_t encode_text(char* dst, std::size_t cap, Fill&& fill)
+    {
+        if (cap > kMaxFrame)
+            cap = kMaxFrame;
+        if (cap < kFramePrefix)
+            return 0;
+
+        const std::size_t room = cap - kFramePrefix;
+        std::size_t n = fill(dst + kFramePrefix, room);
+        if (n > room)
+            n = room;
+
+        const std::size_t size = kFramePrefix + n;
+        char* q = dst;
+        const char* end = dst + cap;
+        detail::put(q, end, static_cast<std::uint16_t>(size - sizeof(std::uint16_t)));
+        detail::put(q, end, kTextTag);
+        detail::put(q, end, std::uint16_t{0});
+        return size;
+    }
+
+    // One frame located in a buffer; body views into it. A folded frame's
+    // body stops before its suppressed count.
+    struct Frame
+    {
+        MsgTag           tag{};
+        std::uint16_t    schema_version{0};
+        std::string_view body;
+        bool             folded{false};
+        std::uint64_t    suppressed{0};
+    };
+
+    enum class DecodeStatus : std::uint8_t
+    {
+        Ok,
+        NeedMore,       // buffer ends inside a frame
+        BadFrame,       // frame length/fields inconsistent; skip it
+        UnknownTag,     // tag not in log_message.def; skip it
+        Text            // text frame (encode_text); body is the text
+    };
+
+    [[nodiscard]] inline bool read_file_header(std::string_view in, FileHeader& out) noexcept
+    {
+        if (in.size() < sizeof(FileHeader))
+            return false;
+        std::memcpy(&out, in.data(), sizeof(FileHeader));
+        return out.magic == kFileMagic && out.version == kFormatVersion;
+    }
+
+    // Split the next frame off `in`; on anything but NeedMore `in`
+    // advances past the frame.
+    inline DecodeStatus next_frame(std::string_view& in, Frame& out) noexcept
+    {
+        const char* p   = in.data();
+        const char* end = in.data() + in.size();
+
+        std::uint16_t len = 0;
+        if (!detail::get(p, end, len) || static_cast<std::size_t>(end - p) < len)
+            return DecodeStatus::NeedMore;
+
+        const char* frame_end = p + len;
+        in.remove_prefix(sizeof(std::uint16_t) + len);
+
+        std::uint8_t tag = 0;
+        if (!detail::get(p, frame_end, tag) || !detail::get(p, frame_end, out.schema_version))
+            return DecodeStatus::BadFrame;
+        if (tag == kTextTag)
+        {
+            out.folded = false;
+            out.body   = std::string_view{p, static_cast<std::size_t>(frame_end - p)};
+            return DecodeStatus::Text;
+        }
+        out.folded     = (tag & kFoldedFlag) != 0;
+        out.suppressed = 0;
+        tag &= static_cast<std::uint8_t>(~kFoldedFlag);
+        if (tag >= static_cast<std::uint8_t>(MsgTag::Count))
+            return DecodeStatus::UnknownTag;
+
+        if (out.folded)
+        {
+            if (static_cast<std::size_t>(frame_end - p) < sizeof(std::uint64_t))
+                return DecodeStatus::BadFrame;
+            frame_end -= sizeof(std::uint64_t);
+            const char* trailer = frame_end;
+            detail::get(trailer, trailer + sizeof(std::uint64_t), out.suppressed);
+        }
+
+        out.tag  = static_cast<MsgTag>(tag);
+        out.body = std::string_view{p, static_cast<std::size_t>(frame_end - p)};
+        return DecodeStatus::Ok;
+    }
+
+    // Decode the fields of `frame` into payload_type of its tag and call
+    // vis(payload); a folded frame's count is in frame.suppressed. BadFrame
+    // unless the body is consumed exactly.
+    template <typename Visitor>
+    DecodeStatus visit_frame(const Frame& frame, Visitor&& vis)
+    {
+        auto decode_as = [&]<MsgTag Tag>() -> DecodeStatus {
+            using Reg = registry::PayloadRegister<Tag>;
+            typename Reg::payload_type obj{};
+
+            const char* p   = frame.body.data();
+            const char* end = p + frame.body.size();
+            const bool ok = std::apply([&](auto... ptr) {
+                return (detail::get(p, end, obj.*ptr) && ...);
+            }, Reg::field_ptrs);
+            if (!ok || p != end || obj.schema_version != frame.schema_version)
+                return DecodeStatus::BadFrame;
+
+            vis(obj);
+            return DecodeStatus::Ok;
+        };
+
+        switch (frame.tag)
+        {
+#define X(M) case MsgTag::M: return decode_as.template operator()<MsgTag::M>();
+#include "common/messages/log_message.def"
+#undef X
+            default: return DecodeStatus::UnknownTag;
+        }
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        void write_value(std::ostream& os, const T& v)
+        {
+            if constexpr (sizeof(T) == 1 && !std::is_enum_v<T>)
+                os << static_cast<int>(v);
+            else
+                os << v;
+        }
+    } // namespace detail
+
+    // Text in the same shape as PayloadBase::print_header, one record per line.
+    template <typename Payload>
+    void write_text(std::ostream& os, const Payload& obj)
+    {
+        using Reg = registry::PayloadRegister<Payload::type_id>;
+        os << "[tag=" << static_cast<int>(Payload::type_id) << "] ";
+
+        std::size_t i = 0;
+        std::apply([&](auto... ptr) {
+            ((os << Reg::field_names[i++] << '=', detail::write_value(os, obj.*ptr), os << ' '), ...);
+        }, Reg::field_ptrs);
+        if constexpr (registry::FoldedPayload<Payload>)
+            os << "suppressed=" << obj.suppressed << ' ';
+        os << '\n';
+    }
+
+    // One JSON object per line (json_codec.hpp).
+    template <typename Payload>
+    void write_json(std::ostream& os, const Payload& obj)
+    {
+        char buf[1024];
+        const std::size_t need = encode_json(obj, buf, sizeof(buf));
+        if (need <= sizeof(buf))
+            os.write(buf, static_cast<std::streamsize>(need));
+        else
+        {
+            std::string big(need, '\0');
+            encode_json(obj, big.data(), big.size());
+            os << big;
+        }
+        os << '\n';
+    }
+
+    enum class OutputFormat : std::uint8_t { Text, Json };
+
+    // A text frame's line as it was, or as {"text":"..."}.
+    inline void write_text_frame(std::ostream& os, std::string_view text, OutputFormat fmt)
+    {
+        if (!text.empty() && text.back() == '\n')
+            text.remove_suffix(1);
+        if (fmt == OutputFormat::Text)
+            os << text;
+        else
+        {
+            std::string buf(text.size() * 6 + 12, '\0');
+            FieldWriter w{buf.data(), buf.size()};
+            w.put("{\"text\":");
+            put_json_string(w, text);
+            w.put('}');
+            os.write(buf.data(), static_cast<std::streamsize>(w.size()));
+        }
+        os << '\n';
+    }
+
+    struct DecodeSummary
+    {
+        bool        header_ok = false;
+        bool        truncated = false;  // file ends inside a frame
+        std::size_t records   = 0;
+        std::size_t text      = 0;      // text frames
+        std::size_t skipped   = 0;      // BadFrame / UnknownTag
+    };
+
+    // Decode a whole binary log (header + frames) to `out`.
+    inline DecodeSummary decode_to(std::string_view file, std::ostream& out, OutputFormat fmt)
+    {
+        DecodeSummary sum{};
+        FileHeader header{};
+        if (!read_file_header(file, header) || header.byte_order != kByteOrderMark)
+            return sum;
+        sum.header_ok = true;
+        file.remove_prefix(sizeof(FileHeader));
+
+        while (!file.empty())
+        {
+            Frame frame{};
+            DecodeStatus st = next_frame(file, frame);
+            if (st == DecodeStatus::NeedMore)
+            {
+                sum.truncated = true;
+                break;
+            }
+            if (st == DecodeStatus::Text)
+            {
+                write_text_frame(out, frame.body, fmt);
+                ++sum.text;
+                continue;
+            }
+            if (st == DecodeStatus::Ok)
+            {
+                st = visit_frame(frame, [&](const auto& obj) {
+                    auto write = [&](const auto& rec) {
+                        if (fmt == OutputFormat::Json) write_json(out, rec);
+                        else                           write_text(out, rec);
+                    };
+                    if (frame.folded)
+                        write(limit::Folded<std::decay_t<decltype(obj)>>{obj, frame.suppressed});
+                    else
+                        write(obj);
+                });
+            }
+            if (st == DecodeStatus::Ok) ++sum.records;
+            else                        ++sum.skipped;
+        }
+        return sum;
+    }
+} // namespace logger::codec
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "common/messages/log_message.hpp"
+#include "common/messages/payloads/field_writer.hpp"
+#include "common/messages/payloads/json_escape.hpp"
+#include "logger/registry/payload_register.hpp"
+
+// JSON encoding of registered payloads, generated from the same X-macro
+// schema as the binary codec (PayloadRegister<Tag>::field_ptrs, i.e.
+// log_payloads.def plus the per-tag body .def files).
+//
+// One object per record, fields in schema order:
+//     {"tag":"Request","severity":"Error","timestamp":99,...,"path":"/a"}
+// Keys are string literals built at compile time, quotes, comma and colon
+// included, so each field costs one literal copy and its value. Integers
+// are numbers (1-byte ones too), enums their toString() name in quotes,
+// non-finite floats null.
+namespace logger::codec
+{
+    // Payloads the codecs write: registered ones, and limit::Folded around
+    // one, which adds "suppressed" after the schema's fields.
+    template <typename E>
+    concept Encodable = registry::RegisteredPayload<E> || registry::FoldedPayload<E>;
+
+    namespace detail
+    {
+        // Schema field names are identifiers, so the key needs no escaping.
+        constexpr bool is_plain_key(std::string_view s) noexcept
+        {
+            if (s.empty())
+                return false;
+            for (const char c : s)
+                if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+                    return false;
+            return true;
+        }
+
+        template <std::size_t N>
+        constexpr std::array<char, N> json_literal(std::string_view prefix, std::string_view name,
+                                                   std::string_view suffix) noexcept
+        {
+            std::array<char, N> out{};
+            std::size_t i = 0;
+            for (const char c : prefix) out[i++] = c;
+            for (const char c : name)   out[i++] = c;
+            for (const char c : suffix) out[i++] = c;
+            return out;
+        }
+
+        // ,"<field I>":
+        template <MsgTag Tag, std::size_t I>
+        struct JsonKey
+        {
+            static constexpr std::string_view name = registry::PayloadRegister<Tag>::field_names[I];
+            static_assert(is_plain_key(name), "schema field name needs JSON escaping");
+
+            static constexpr auto bytes = json_literal<name.size() + 4>(",\"", name, "\":");
+            static constexpr std::string_view value{bytes.data(), bytes.size()};
+        };
+
+        // {"tag":"<Tag>"
+        template <MsgTag Tag>
+        struct JsonOpen
+        {
+            static constexpr std::string_view name = toString(Tag);
+            static_assert(is_plain_key(name), "tag name needs JSON escaping");
+
+            static constexpr auto bytes = json_literal<name.size() + 9>("{\"tag\":\"", name, "\"");
+            static constexpr std::string_view value{bytes.data(), bytes.size()};
+        };
+
+        // At most n bytes of s, not ending inside a UTF-8 sequence.
+        constexpr std::string_view clip_utf8(std::string_view s, std::size_t n) noexcept
+        {
+            if (s.size() <= n)
+                return s;
+            while (n > 0 && (static_cast<unsigned char>(s[n]) & 0xC0) == 0x80)
+                --n;
+            return s.substr(0, n);
+        }
+
+        template <typename T>
+        void put_json_value(FieldWriter& w, const T& v, std::size_t max_string) noexcept
+        {
+            if constexpr (std::is_same_v<T, std::string_view>)
+                put_json_string(w, clip_utf8(v, max_string));
+            else if constexpr (std::is_enum_v<T>)
+            {
+                w.put('"');
+                w.put(v);
+                w.put('"');
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+                w.put(v ? std::string_view{"true"} : std::string_view{"false"});
+            else if constexpr (std::floating_point<T>)
+            {
+                if (std::isfinite(v)) w.put(v);
+                else                  w.put("null");
+            }
+            else
+                w.put(v);
+        }
+
+        template <Encodable Payload>
+        void write_json_object(FieldWriter& w, const Payload& obj, std::size_t max_string) noexcept
+        {
+            using Reg = registry::PayloadRegister<Payload::type_id>;
+            constexpr std::size_t kFields = std::tuple_size_v<std::remove_const_t<decltype(Reg::field_ptrs)>>;
+
+            w.put(JsonOpen<Payload::type_id>::value);
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((w.put(JsonKey<Payload::type_id, I>::value),
+                  put_json_value(w, obj.*std::get<I>(Reg::field_ptrs), max_string)), ...);
+            }(std::make_index_sequence<kFields>{});
+            if constexpr (registry::FoldedPayload<Payload>)
+            {
+                w.put(",\"suppressed\":");
+                w.put(obj.suppressed);
+            }
+            w.put('}');
+        }
+
+        template <Encodable Payload>
+        std::size_t longest_string(const Payload& obj) noexcept
+        {
+            using Reg = registry::PayloadRegister<Payload::type_id>;
+            std::size_t longest = 0;
+            std::apply([&](auto... ptr) {
+                ([&](const auto& v) {
+                    if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string_view>)
+                        longest = v.size() > longest ? v.size() : longest;
+                }(obj.*ptr), ...);
+            }, Reg::field_ptrs);
+            return longest;
+        }
+    } // namespace detail
+
+    // One JSON object, no newline, into [dst, dst + cap). Returns the length
+    // the whole object needs; anything past cap is cut off.
+    template <Encodable Payload>
+    std::size_t encode_json(const Payload& obj, char* dst, std::size_t cap) noexcept
+    {
+        FieldWriter w{dst, cap};
+        detail::write_json_object(w, obj, static_cast<std::size_t>(-1));
+        return w.size();
+    }
+
+    // As encode_json, but always a whole object: when it does not fit,
+    // string fields are shortened (at a UTF-8 boundary) until it does.
+    // Returns the length written, or 0 if even empty strings do not fit.
+    template <Encodable Payload>
+    std::size_t encode_json_clipped(const Payload& obj, char* dst, std::size_t cap) noexcept
+    {
+        std::size_t need = encode_json(obj, dst, cap);
+        if (need <= cap)
+            return need;
+
+        // Each retry takes the overflow off every string; escaping can make
+        // a byte worth more than one, hence the loop.
+        std::size_t max_string = detail::longest_string(obj);
+        while (max_string > 0)
+        {
+            const std::size_t over = need - cap;
+            max_string = max_string > over ? max_string - over : 0;
+
+            FieldWriter w{dst, cap};
+            detail::write_json_object(w, obj, max_string);
+            need = w.size();
+            if (need <= cap)
+                return need;
+        }
+        return 0;
+    }
+} // namespace logger::codec
@@ -0,0 +1,319 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "logger/registry/payload_register.hpp"
+
+namespace logger::core
+{
+    // Worker-side folding of repeated records (EngineConfig::coalesce).
+    struct CoalesceConfig
+    {
+        // > 0: a schema payload whose fields match one written less than
+        // this long ago, apart from the fields in log_volatile.def, is not
+        // written. When the window of the first one closes, a Repeat record
+        // says how many were dropped and carries the header of the last.
+        // The next match after that is written again and opens a new window.
+        std::chrono::milliseconds window{0};
+
+        // Distinct records a worker tracks at once. A new one beyond this
+        // closes the oldest window early (counted as evicted).
+        std::size_t keys = 256;
+    };
+
+    // Coalescing counters, summed over the workers.
+    struct CoalesceStats
+    {
+        uint64_t suppressed = 0;    // records not written as repeats
+        uint64_t summaries  = 0;    // Repeat records written for them
+        uint64_t evicted    = 0;    // windows closed early to make room
+    };
+} // namespace logger::core
+
+namespace logger::core::detail
+{
+    constexpr bool is_volatile_field(std::string_view name) noexcept
+    {
+        for (const std::string_view f : {
+#define X(F) std::string_view{#F},
+#include "common/messages/payloads/log_volatile.def"
+#undef X
+                 std::string_view{}})
+            if (!f.empty() && f == name)
+                return true;
+        return false;
+    }
+
+    constexpr bool is_schema_field(std::string_view name) noexcept
+    {
+        bool found = false;
+#define X(M) for (const std::string_view f : registry::PayloadRegister<MsgTag::M>::field_names) found = found || f == name;
+#include "common/messages/log_message.def"
+#undef X
+        return found;
+    }
+
+#define X(F) static_assert(is_schema_field(#F), "log_volatile.def: no payload has a field named " #F);
+#include "common/messages/payloads/log_volatile.def"
+#undef X
+
+    // Which fields of Tag's schema go into the coalescing key.
+    template <MsgTag Tag>
+    inline constexpr auto kKeyFields = [] {
+        using Reg = registry::PayloadRegister<Tag>;
+        std::array<bool, std::size(Reg::field_names)> on{};
+        for (std::size_t i = 0; i < on.size(); ++i)
+            on[i] = !is_volatile_field(Reg::field_names[i]);
+        return on;
+    }();
+
+    inline void hash_field(std::uint64_t& h, std::string_view s) noexcept
+    {
+        for (const char c : s)
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        h = (h ^ s.size()) * 0x100000001b3ull;
+    }
+
+    template <typename T>
+    void hash_field(std::uint64_t& h, const T& v) noexcept
+    {
+        if constexpr (std::is_enum_v<T>)
+            h = (h ^ static_cast<std::uint64_t>(v)) * 0x100000001b3ull;
+        else
+        {
+            static_assert(std::is_integral_v<T>, "coalescing key: field type not hashed");
+            h = (h ^ static_cast<std::uint64_t>(v)) * 0x100000001b3ull;
+        }
+    }
+
+    // Key of a schema payload: its tag and every field not listed in
+    // log_volatile.def. `header` gets the payload's header fields and tag,
+    // for the Repeat record if this one turns out to be a repeat. Never 0.
+    template <typename Payload>
+    std::uint64_t coalesce_key(const Payload& p, registry::RepeatPayload& header) noexcept
+    {
+        constexpr MsgTag Tag = Payload::type_id;
+        using Reg = registry::PayloadRegister<Tag>;
+
+#define X(C, F) header.F = p.F;
+#include "common/messages/payloads/log_payloads.def"
+#undef X
+        header.of_tag = static_cast<std::uint8_t>(Tag);
+
+        std::uint64_t h = 0xcbf29ce484222325ull ^ static_cast<std::uint64_t>(Tag);
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((kKeyFields<Tag>[I] ? hash_field(h, p.*std::get<I>(Reg::field_ptrs)) : void()), ...);
+        }(std::make_index_sequence<std::tuple_size_v<decltype(Reg::field_ptrs)>>{});
+
+        // fmix64, so the low bits index the table well.
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h ? h : 1;
+    }
+
+    // Worker-side coalescing windows, keyed by coalesce_key().
+    //
+    // Windows all last window_ns, so they close in the order they opened:
+    // they live in a ring in that order, and an open-addressing table maps
+    // a key to its place in the ring. Two keys that hash alike count as
+    // the same record; with 64-bit keys and a few hundred windows open
+    // that does not happen in practice. Single-threaded apart from
+    // stats(), which may be read from any thread.
+    class Coalescer
+    {
+    public:
+        Coalescer() = default;
+
+        Coalescer(std::uint64_t window_ns, std::size_t keys)
+            : window_ns_(window_ns)
+            , entries_(round_up_pow2(keys ? keys : 1))
+            , mask_(entries_.size() - 1)
+            , slots_(2 * entries_.size())
+            , slot_mask_(slots_.size() - 1)
+        {
+        }
+
+        bool enabled() const noexcept { return window_ns_ != 0; }
+
+        // Windows open, and those of them that have dropped a record.
+        std::size_t open()    const noexcept { return static_cast<std::size_t>(tail_ - head_); }
+        bool        pending() const noexcept { return held_ != 0; }
+
+        // When the oldest window closes; only when open() != 0.
+        std::uint64_t next_due() const noexcept { return at(head_).until; }
+
+        // True: `key` has a window open at `now`, the record is a repeat and
+        // is not to be written. Otherwise a window opens for it. Windows up
+        // by `now` are closed first, their summaries going out through
+        // emit(const RepeatPayload&).
+        template <typename Emit>
+        bool absorb(std::uint64_t key, const registry::RepeatPayload& header, std::uint64_t now, Emit&& emit)
+        {
+            expire(now, emit);
+
+            std::size_t i = key & slot_mask_;
+            for (; slots_[i].key; i = (i + 1) & slot_mask_)
+            {
+                if (slots_[i].key != key)
+                    continue;
+
+                registry::RepeatPayload& s = at(slots_[i].seq).summary;
+                const std::uint64_t repeated = s.repeated + 1;
+                const std::uint64_t first = repeated == 1 ? header.timestamp : s.first_timestamp;
+                s = header;
+                s.repeated = repeated;
+                s.first_timestamp = first;
+                if (repeated == 1)
+                    ++held_;
+                bump(suppressed_);
+                return true;
+            }
+
+            if (open() == entries_.size())
+            {
+                bump(evicted_);
+                close_oldest(emit);
+                i = key & slot_mask_;
+                while (slots_[i].key)
+                    i = (i + 1) & slot_mask_;
+            }
+
+            slots_[i] = Slot{key, tail_};
+            Entry& e = at(tail_++);
+            e.key = key;
+            e.until = now + window_ns_;
+            e.summary.repeated = 0;
+            return false;
+        }
+
+        // Close every window up by `now`.
+        template <typename Emit>
+        void expire(std::uint64_t now, Emit&& emit)
+        {
+            while (head_ != tail_ && at(head_).until <= now)
+                close_oldest(emit);
+        }
+
+        // Shutdown: close every window now.
+        template <typename Emit>
+        void expire_all(Emit&& emit)
+        {
+            while (head_ != tail_)
+                close_oldest(emit);
+        }
+
+        CoalesceStats stats() const noexcept
+        {
+            CoalesceStats s;
+            s.suppressed = suppressed_.load(std::memory_order_relaxed);
+            s.summaries  = summaries_.load(std::memory_order_relaxed);
+            s.evicted    = evicted_.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        Coalescer(Coalescer&& o) noexcept { *this = std::move(o); }
+
+        // Only while nothing is open (set up before the worker starts).
+        Coalescer& operator=(Coalescer&& o) noexcept
+        {
+            window_ns_ = o.window_ns_;
+            entries_   = std::move(o.entries_);
+            mask_      = o.mask_;
+            slots_     = std::move(o.slots_);
+            slot_mask_ = o.slot_mask_;
+            head_ = tail_ = 0;
+            held_ = 0;
+            return *this;
+        }
+
+    private:
+        struct Entry
+        {
+            std::uint64_t key{0};
+            std::uint64_t until{0};
+            registry::RepeatPayload summary{};     // repeated == 0: nothing dropped yet
+        };
+
+        struct Slot
+        {
+            std::uint64_t key{0};      // 0 = empty
+            std::uint64_t seq{0};      // the window's place in the ring
+        };
+
+        static std::size_t round_up_pow2(std::size_t n) noexcept
+        {
+            std::size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        static void bump(std::atomic<uint64_t>& c) noexcept
+        {
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        const Entry& at(std::uint64_t seq) const noexcept { return entries_[seq & mask_]; }
+        Entry&       at(std::uint64_t seq) noexcept       { return entries_[seq & mask_]; }
+
+        template <typename Emit>
+        void close_oldest(Emit& emit)
+        {
+            Entry& e = at(head_++);
+            erase(e.key);
+            if (e.summary.repeated)
+            {
+                --held_;
+                bump(summaries_);
+                emit(static_cast<const registry::RepeatPayload&>(e.summary));
+            }
+        }
+
+        // Linear probing without tombstones: later slots of the run move
+        // back into the gap.
+        void erase(std::uint64_t key) noexcept
+        {
+            std::size_t i = key & slot_mask_;
+            while (slots_[i].key != key)
+                i = (i + 1) & slot_mask_;
+
+            for (std::size_t j = (i + 1) & slot_mask_; slots_[j].key; j = (j + 1) & slot_mask_)
+            {
+                const std::size_t home = slots_[j].key & slot_mask_;
+                if (((j - home) & slot_mask_) >= ((j - i) & slot_mask_))
+                {
+                    slots_[i] = slots_[j];
+                    i = j;
+                }
+            }
+            slots_[i] = Slot{};
+        }
+
+        std::uint64_t window_ns_{0};
+
+        std::vector<Entry> entries_;    // ring, in the order windows opened
+        std::size_t   mask_{0};
+        std::uint64_t head_{0};         // oldest open window
+        std::uint64_t tail_{0};
+        std::size_t   held_{0};         // open windows that have dropped a record
+
+        std::vector<Slot> slots_;       // key -> ring position
+        std::size_t   slot_mask_{0};
+
+        std::atomic<uint64_t> suppressed_{0};
+        std::atomic<uint64_t> summaries_{0};
+        std::atomic<uint64_t> evicted_{0};
+    };
+} // namespace logger::core::detail
@@ -0,0 +1,156 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "coalescer.hpp"
+#include "overflow_policy.hpp"
+#include "publisher/runtime/mmap_ring.hpp"
+#include "reorder_buffer.hpp"
+#include "spill_arena.hpp"
+#include "publisher/runtime/rotating_file.hpp"
+#include "publisher/runtime/socket_sink.hpp"
+#include "publisher/runtime/uring_file.hpp"
+#include "wait_strategy.hpp"
+
+namespace logger::core
+{
+    // How producers hand records to the worker.
+    enum class QueueMode : std::uint8_t
+    {
+        Mpsc,       // shared FreeList + intrusive MpscQueue (default)
+        SpscLanes   // one bounded SPSC ring per producer thread
+    };
+
+    // What the worker writes for each record.
+    enum class SinkFormat : std::uint8_t
+    {
+        Text,       // debug_print() text to the terminal (default)
+        Binary,     // logger::codec frames to binary_file; read with logdecode
+        Socket,     // debug_print() text to the collector socket
+        Json,       // one JSON object per line (codec::encode_json) to the terminal
+        JsonSocket, // the same JSON lines to the collector socket
+        TextFile,   // Text's lines to text_file (buffered, rotating)
+        JsonFile    // Json's lines to text_file (buffered, rotating)
+    };
+
+    // How SinkFormat::Binary output reaches binary_file.
+    enum class FileBackend : std::uint8_t
+    {
+        Buffered,   // RotatingFile: buffered write(2), rotation (default)
+        IoUring     // UringFile: asynchronous, no rotation; Buffered if
+                    // io_uring is unavailable
+    };
+
+    // LogEngine configuration. Applied via LogEngine::configure() before the
+    // first enqueue; ignored once the worker is running.
+    struct EngineConfig
+    {
+        QueueMode queue_mode = QueueMode::Mpsc;
+
+        // SpscLanes: slots per producer ring (rounded up to a power of two)
+        // and the maximum number of producer threads holding a lane at once.
+        // Producers beyond max_lanes fall back to the Mpsc path.
+        std::size_t lane_capacity = 256;
+        std::size_t max_lanes     = 64;
+
+        // Records the worker takes from one lane before moving to the next.
+        std::size_t lane_burst    = 32;
+
+        // Mpsc: records allocated when the worker starts.
+        std::size_t pool_size = 1024;
+
+        // Mpsc: pool growth (max_pool_slabs = 0 keeps the pool fixed). Each
+        // time grow_after_drops enqueues have found the pool empty since the
+        // last slab (dropped, or waiting under a blocking Overflow policy;
+        // BySeverity sheds count too), the worker adds pool_slab_size
+        // records, up to max_pool_slabs times. Slabs stay resident until the
+        // process exits.
+        std::size_t max_pool_slabs   = 0;
+        std::size_t pool_slab_size   = 1024;
+        std::size_t grow_after_drops = 64;
+
+        // Mpsc: per-thread cache of free records in front of the FreeList
+        // (0 = off). Producers refill and the worker recycles in chains of
+        // this size, one CAS per chain. Records parked in a thread's cache
+        // are not available to other threads until it refills or exits.
+        std::size_t magazine_size = 0;
+
+        // Worker threads, 1..TokenRegistry::kMaxChannels (clamped). Worker k
+        // owns publisher channel k with its own queue, staging buffer and
+        // sink objects, so workers format and write in parallel. A producer
+        // thread sticks to the worker it is first given (SpscLanes: each
+        // lane to one worker), which keeps every thread's records in order;
+        // there is no order between threads. File-like sinks get one file
+        // per worker: worker 0 uses the configured path, worker k path.w<k>.
+        std::size_t workers = 1;
+
+        // Records a worker takes from its MPSC queue per pass, and the
+        // most it formats into the staging buffer before handing the sink a
+        // single batched write. staging_bytes is raised to at least one
+        // record's worth (1 KiB).
+        std::size_t batch_records = 64;
+        std::size_t staging_bytes = 64 * 1024;
+
+        // Binary skips text formatting on the worker entirely. Envelopes the
+        // codec has no schema for are formatted as text and written as text
+        // frames, which logdecode prints as they are.
+        // binary_file: path, buffering and rotation (IoUring uses only the
+        // path); the codec header is added to every file.
+        SinkFormat sink_format = SinkFormat::Text;
+        FileBackend binary_backend = FileBackend::Buffered;
+        publisher::runtime::FileSinkConfig binary_file = [] {
+            publisher::runtime::FileSinkConfig f;
+            f.path = "log.bin";
+            return f;
+        }();
+
+        // SinkFormat::TextFile and JsonFile: path, buffering and rotation of
+        // the line file, written like binary_file's Buffered backend
+        // (header is ignored).
+        publisher::runtime::FileSinkConfig text_file = [] {
+            publisher::runtime::FileSinkConfig f;
+            f.path = "log.txt";
+            return f;
+        }();
+
+        // SinkFormat::Socket and JsonSocket: where the collector listens,
+        // plus the send ring and reconnect policy. Records that find the
+        // ring full are dropped and counted in the sink, never waited on.
+        publisher::runtime::SocketSinkConfig collector{};
+
+        // Every batch is also copied into this mmap'ed ring file, whatever
+        // sink_format says, so the newest records survive the process being
+        // killed; read it with ringdump. Empty path = off. content is set
+        // from sink_format.
+        publisher::runtime::MmapRingConfig crash_ring = [] {
+            publisher::runtime::MmapRingConfig r;
+            r.path.clear();
+            return r;
+        }();
+
+        // Per-record stamps and the optional merge into timestamp order.
+        OrderingConfig ordering{};
+
+        // Dropping repeats of the same record, written as one Repeat
+        // record per window.
+        CoalesceConfig coalesce{};
+
+        // Envelopes larger than LogRecord::StorageSize.
+        SpillConfig spill{};
+
+        // string_view fields of schema payloads are copied at enqueue, so
+        // the caller's buffer may go away right after the call. A copy
+        // holds at most this many bytes; a longer string keeps its start
+        // and ends in "...". Copies go after the envelope in the record,
+        // or into the spill arena when they do not fit.
+        std::size_t max_string_bytes = 1024;
+
+        // What the worker does when it finds nothing to drain. Park and
+        // Adaptive add a fence to every enqueue so producers can tell when
+        // the worker needs a wake-up.
+        WaitConfig wait{};
+
+        // Limits for the non-default Overflow policies of enqueue().
+        OverflowConfig overflow{};
+    };
+} // namespace logger::core
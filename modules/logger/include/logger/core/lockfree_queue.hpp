@@ -9,6 +9,15 @@ namespace logger::core::detail
     // (worker must recycle a node before a stale CAS completes).
     // A tagged-pointer fix would require 128-bit CAS (x86-64 only) or
     // bit manipulation — both undesirable for a Raspberry Pi target.
+    // For a contiguous pool, TaggedFreeList (tagged_freelist.hpp) closes the
+    // window with a 64-bit index+generation head; build with
+    // LOGGER_ABA_SAFE_FREELIST to make LogEngine use it.
+    //
+    // The stack holds chains, not just nodes: push_chain() hands over a
+    // whole free_next-linked chain and try_pop_chain() takes one back, each
+    // with a single CAS. push()/try_pop() are the chain-of-one case.
+    // Batching through chains (see record_magazine.hpp) also cuts the number
+    // of CASes — and with it the ABA exposure — by the batch factor.
     class FreeList
     {
         std::atomic<FreeNode*> head_{nullptr};
@@ -16,23 +25,35 @@ namespace logger::core::detail
     public:
         FreeList() = default;
 
+        // Pointer-linked: any node can be pushed, nothing to bind.
+        // Present so FreeList and TaggedFreeList are interchangeable.
+        void attach(LogRecord*, std::size_t) noexcept {}
+
         void push(FreeNode* n) noexcept
+        {
+            n->free_next = nullptr;
+            push_chain(n);
+        }
+
+        // Push a null-terminated free_next chain starting at first.
+        void push_chain(FreeNode* first) noexcept
         {
             FreeNode* h = head_.load(std::memory_order_relaxed);
             do
             {
-                n->free_next = h;
-            } while (!head_.compare_exchange_weak(h, n,
+                first->chain_next = h;
+            } while (!head_.compare_exchange_weak(h, first,
                                                   std::memory_order_release,
                                                   std::memory_order_relaxed));
         }
 
-        FreeNode* try_pop() noexcept
+        // Pop the most recently pushed chain (free_next-linked).
+        FreeNode* try_pop_chain() noexcept
         {
             FreeNode* h = head_.load(std::memory_order_acquire);
             while (h)
             {
-                FreeNode* next = h->free_next;
+                FreeNode* next = h->chain_next;
                 if (head_.compare_exchange_weak(h, next,
                                                 std::memory_order_acq_rel,
                                                 std::memory_order_acquire))
@@ -43,6 +64,17 @@ namespace logger::core::detail
             return nullptr;
         }
 
+        FreeNode* try_pop() noexcept
+        {
+            FreeNode* h = try_pop_chain();
+            if (h && h->free_next)
+            {
+                push_chain(h->free_next);
+                h->free_next = nullptr;
+            }
+            return h;
+        }
+
         bool empty() const noexcept
         {
             return head_.load(std::memory_order_acquire) == nullptr;
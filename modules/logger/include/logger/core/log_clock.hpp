@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace logger::core
+{
+    namespace detail
+    {
+        // (a * b) >> 32, truncated to 64 bits, from 32-bit halves. The
+        // fallback for targets without unsigned __int128 (32-bit ones).
+        constexpr std::uint64_t mul_shr32(std::uint64_t a, std::uint64_t b) noexcept
+        {
+            const std::uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+            const std::uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+            return ((a_hi * b_hi) << 32) + a_hi * b_lo + a_lo * b_hi + ((a_lo * b_lo) >> 32);
+        }
+
+        // (a << 32) / b, truncated to 64 bits, by long division over the
+        // 32 low bits. b must be non-zero.
+        constexpr std::uint64_t shl32_div(std::uint64_t a, std::uint64_t b) noexcept
+        {
+            std::uint64_t q = a / b;
+            std::uint64_t r = a % b;
+            for (int i = 0; i < 32; ++i)
+            {
+                const bool carry = (r >> 63) != 0;
+                r <<= 1;
+                q <<= 1;
+                if (carry || r >= b)
+                {
+                    r -= b;
+                    q |= 1;
+                }
+            }
+            return q;
+        }
+    } // namespace detail
+
+    // Timestamp source for log headers: nanoseconds since the Unix epoch,
+    // cheap enough to read on every enqueue.
+    //
+    // Tsc reads rdtsc and scales it with a factor calibrated against
+    // CLOCK_MONOTONIC (a few ns per read, no syscall, no vDSO). Coarse
+    // reads CLOCK_MONOTONIC_COARSE (tick resolution, typically 1-4 ms).
+    // Both run on CLOCK_MONOTONIC plus an epoch offset taken once at
+    // calibration, so the time never steps backwards when the wall clock
+    // is set; it drifts from CLOCK_REALTIME only as far as NTP slews.
+    class LogClock
+    {
+    public:
+        enum class Source : std::uint8_t
+        {
+            Auto,       // Tsc when the CPU has an invariant TSC, else Coarse
+            Tsc,        // Coarse if there is no invariant TSC
+            Coarse
+        };
+
+        // Calibrates here: about a millisecond of spinning for Tsc.
+        explicit LogClock(Source source = Source::Auto) noexcept;
+
+        // The process-wide clock, calibrated on first use.
+        static LogClock& instance() noexcept;
+
+        [[nodiscard]] std::uint64_t now_ns() const noexcept
+        {
+            if (!tsc_)
+                return coarse_ns();
+
+            // Seqlock against recalibrate(); the writer is rare, so the
+            // retry practically never happens.
+            const std::uint64_t ticks = read_tsc();
+            for (;;)
+            {
+                const std::uint32_t seq = seq_.load(std::memory_order_acquire);
+                const std::uint64_t base_tsc = base_tsc_.load(std::memory_order_relaxed);
+                const std::uint64_t base_ns  = base_ns_.load(std::memory_order_relaxed);
+                const std::uint64_t mult     = mult_.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if ((seq & 1) || seq != seq_.load(std::memory_order_relaxed))
+                    continue;
+                return ticks > base_tsc ? base_ns + scaled(ticks - base_tsc, mult) : base_ns;
+            }
+        }
+
+        [[nodiscard]] std::uint64_t now_us() const noexcept { return now_ns() / 1000; }
+
+        [[nodiscard]] bool uses_tsc() const noexcept { return tsc_; }
+
+        // TSC ticks per second as calibrated; 0 for Coarse.
+        [[nodiscard]] double tsc_hz() const noexcept;
+
+        // Refine the TSC scale over the whole time since construction and
+        // re-anchor to CLOCK_MONOTONIC, never moving the clock backwards.
+        // Single writer; LogEngine worker 0 calls it about once a second.
+        void recalibrate() noexcept;
+
+    private:
+        static std::uint64_t read_tsc() noexcept
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+        static std::uint64_t scaled(std::uint64_t ticks, std::uint64_t mult) noexcept
+        {
+#ifdef __SIZEOF_INT128__
+            __extension__ typedef unsigned __int128 uint128;
+            return static_cast<std::uint64_t>((static_cast<uint128>(ticks) * mult) >> 32);
+#else
+            return detail::mul_shr32(ticks, mult);
+#endif
+        }
+
+        // ns/ticks as a 32.32 fixed-point multiplier.
+        static std::uint64_t mult_of(std::uint64_t ns, std::uint64_t ticks) noexcept;
+
+        std::uint64_t coarse_ns() const noexcept
+        {
+            timespec ts{};
+            ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return epoch_offset_ + static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000ull +
+                   static_cast<std::uint64_t>(ts.tv_nsec);
+        }
+
+        bool tsc_{false};
+        std::uint64_t epoch_offset_{0};     // CLOCK_REALTIME - CLOCK_MONOTONIC at calibration
+        std::uint64_t start_tsc_{0};        // first calibration sample
+        std::uint64_t start_mono_{0};
+
+        // TSC scale, published under seq_.
+        std::atomic<std::uint32_t> seq_{0};
+        std::atomic<std::uint64_t> base_tsc_{0};
+        std::atomic<std::uint64_t> base_ns_{0};
+        std::atomic<std::uint64_t> mult_{0};     // ns per tick, 32.32 fixed point
+    };
+} // namespace logger::core
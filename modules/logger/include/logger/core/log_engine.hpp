@@ -1,19 +1,44 @@
 #pragma once
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <new>
 
+#include "engine_config.hpp"
+#include "logger/codec/binary_codec.hpp"
+#include "logger/codec/json_codec.hpp"
+#include "logger/registry/builder.hpp"
+#include "coalescer.hpp"
 #include "log_record.hpp"
 #include "lockfree_queue.hpp"
+#include "overflow_policy.hpp"
+#include "record_arena.hpp"
+#include "record_magazine.hpp"
+#include "reorder_buffer.hpp"
+#include "spill_arena.hpp"
+#include "spsc_ring.hpp"
+#include "staging_buffer.hpp"
+#include "string_capture.hpp"
+#include "tagged_freelist.hpp"
+#include "wait_strategy.hpp"
 #include "stream_adapter.hpp"
 #include "publisher/core/publisher_types.hpp"
+#include "publisher/sink_publisher.hpp"
 #include "publisher/runtime/publisher_runtime.hpp"
+#include "publisher/runtime/mmap_ring.hpp"
 #include "publisher/runtime/registration_handle.hpp"
 #include "publisher/runtime/resource_store.hpp"
+#include "publisher/runtime/rotating_file.hpp"
+#include "publisher/runtime/socket_sink.hpp"
+#include "publisher/runtime/uring_file.hpp"
 #include "publisher/runtime/token_registry.hpp"
 
 namespace logger::core::detail
@@ -23,69 +48,143 @@ namespace logger::core::detail
     public:
         static LogEngine& instance() noexcept;
 
-        uint64_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
-        uint64_t enqueued() const noexcept { return enqueued_.load(std::memory_order_relaxed); }
+        // Must be called before the first enqueue; returns false (and changes
+        // nothing) once the worker is running.
+        bool configure(const EngineConfig& cfg);
+        const EngineConfig& config() const noexcept { return cfg_; }
+
+        uint64_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed)  + (lanes_ ? lanes_->dropped()  : 0); }
+        uint64_t enqueued() const noexcept { return enqueued_.load(std::memory_order_relaxed) + (lanes_ ? lanes_->enqueued() : 0); }
         uint64_t written()  const noexcept { return written_.load(std::memory_order_relaxed); }
+        uint64_t parks()    const noexcept;
 
-        template <typename Envelope>
-        void enqueue(Envelope &&env)
-        {
-            ensure_running();
+        // Records counted in written() that the io_uring file sink then
+        // discarded because every buffer was still in flight.
+        uint64_t file_dropped() const noexcept;
 
-            LogRecord *rec = acquire_record();
-            if (!rec)
-            {
-                dropped_.fetch_add(1, std::memory_order_relaxed);
-                return;
-            }
+        // One worker per publisher channel at most.
+        static constexpr std::size_t kMaxWorkers = publisher::runtime::TokenRegistry::kMaxChannels;
+        std::size_t workers() const noexcept { return workers_; }
 
-            using E = std::decay_t<Envelope>;
-            using Stored = StoredEnvelope<E>;
+        // Records in the Mpsc pool and the slabs backing them (1 + growth).
+        std::size_t capacity() const noexcept { return arena_.capacity(); }
+        std::size_t slabs()    const noexcept { return arena_.slabs(); }
 
-            static_assert(sizeof(Stored) <= LogRecord::StorageSize,
-                          "Envelope too big for LogRecord::storage");
-            static_assert(alignof(Stored) <= LogRecord::StorageAlign,
-                          "StoredEnvelope alignment too strict");
+        OverflowStats overflow_stats() const noexcept { return backpressure_.stats(); }
+        ReorderStats  reorder_stats()  const noexcept;
+        SpillStats    spill_stats()    const noexcept { return spill_.stats(); }
+        CoalesceStats coalesce_stats() const noexcept;
 
-            void *mem = rec->storage_ptr();
+        // String fields cut to EngineConfig::max_string_bytes, or to what
+        // was left once the spill pool was full.
+        uint64_t truncated_strings() const noexcept { return truncated_.load(std::memory_order_relaxed); }
 
-            new (mem) Stored{std::move(env)};
+        // Policy decides what happens when no record (or lane slot) is free;
+        // see Overflow. The fast path is the same for every policy.
+        template <Overflow Policy = Overflow::DropNewest, typename Envelope>
+        void enqueue(Envelope &&env)
+        {
+            submit<Policy>(env, [this, &env](LogRecord *rec) { return emplace_envelope(rec, std::move(env)); });
+        }
 
-            rec->destroy_fn = &destroy_impl<Stored>;
-            rec->submit_fn  = &submit_impl<Stored>;
+        // enqueue() of what Builder::build<Tag>(fields) would return,
+        // without building it first: the record is taken, then the fields
+        // (PayloadRegister<Tag> order and types) are assigned straight into
+        // the payload in its storage. Handler::log goes through here.
+        template <MsgTag Tag, Overflow Policy = Overflow::DropNewest, typename... Fields>
+        void emplace(Fields &&...fields)
+        {
+            emplace_as<Tag, typename registry::PayloadRegister<Tag>::payload_type, Policy>(
+                [](auto &) {}, std::forward<Fields>(fields)...);
+        }
 
-            push_to_queue(rec);
-            enqueued_.fetch_add(1, std::memory_order_relaxed);
+        // emplace() of an Envelope derived from Tag's payload
+        // (limit::Folded): the fields are assigned the same way, then
+        // init(envelope) sets what Envelope adds, still in the record.
+        // Handler::log_sampled goes through here.
+        template <MsgTag Tag, typename Envelope, Overflow Policy = Overflow::DropNewest,
+                  typename Init, typename... Fields>
+        void emplace_as(Init &&init, Fields &&...fields)
+        {
+            static_assert(std::is_base_of_v<typename registry::PayloadRegister<Tag>::payload_type, Envelope>,
+                          "emplace_as: Envelope must derive from Tag's payload");
+
+            const auto args = std::forward_as_tuple(std::forward<Fields>(fields)...);
+            submit<Policy>(SeverityOf{std::get<0>(args)},
+                           [this, &args, &init](LogRecord *rec) { return build_envelope<Tag, Envelope>(rec, args, init); });
         }
 
         void shutdown() noexcept;
 
+        // Longest rendering of a single record; longer output is truncated.
+        static constexpr std::size_t kMaxRecordBytes = 1024;
+
         template<typename Stored>
-        static void submit_impl(void* storage)
+        static std::size_t format_impl(void* storage, char* dst, std::size_t cap)
         {
             auto* obj = static_cast<Stored*>(storage);
-            auto& env = obj->env;
-
-            using Envelope  = std::decay_t<decltype(env)>;
 
-            auto adapter = [](const Envelope& envelope) -> std::string_view {
-                thread_local FixedStringBuf<1024> buf;
+            // PayloadBase envelopes skip iostreams entirely.
+            if constexpr (requires { obj->env.format_to(dst, cap); })
+            {
+                const std::size_t need = obj->env.format_to(dst, cap);
+                return need < cap ? need : cap;
+            }
+            else
+            {
+                thread_local SpanStringBuf buf;
                 thread_local std::ostream os(&buf);
-                buf.reset();
+                buf.reset(dst, cap);
                 os.clear();
 
-                envelope.debug_print(os);
-                return buf.view();
-            };
+                obj->env.debug_print(os);
+                return buf.written();
+            }
+        }
 
-            const std::string_view view = adapter(env);
+        template<typename Stored>
+        static std::size_t encode_impl(void* storage, char* dst, std::size_t cap)
+        {
+            return codec::encode(static_cast<Stored*>(storage)->env, dst, cap);
+        }
 
-            publisher::runtime::PublisherRuntime<publisher::core::SinkKind::Terminal>::publish_view(
-                registry(),
-                store(),
-                instance().publishHandle_.token(),
-                view
-            );
+        // One JSON line, written straight into the staging buffer. String
+        // fields are shortened to fit, so a line is never cut mid-object.
+        template<typename Stored>
+        static std::size_t json_impl(void* storage, char* dst, std::size_t cap)
+        {
+            const std::size_t n = codec::encode_json_clipped(static_cast<Stored*>(storage)->env, dst, cap - 1);
+            dst[n] = '\n';
+            return n + 1;
+        }
+
+        // Envelopes outside the schema under SinkFormat::Binary: their text
+        // in a text frame, which logdecode prints as it is.
+        template<typename Stored>
+        static std::size_t text_frame_impl(void* storage, char* dst, std::size_t cap)
+        {
+            return codec::encode_text(dst, cap, [storage](char* text, std::size_t room) {
+                return format_impl<Stored>(storage, text, room);
+            });
+        }
+
+        // Envelopes outside the schema: their text through JsonSink. Only
+        // this path can cut a line short, if the JSON outgrows cap.
+        template<typename Stored>
+        static std::size_t json_text_impl(void* storage, char* dst, std::size_t cap)
+        {
+            thread_local char text[kMaxRecordBytes];
+            const std::size_t len = format_impl<Stored>(storage, text, sizeof(text));
+            const std::size_t need = JsonSink::format_to(std::string_view{text, len}, dst, cap - 1);
+            const std::size_t n = need < cap - 1 ? need : cap - 1;
+            dst[n] = '\n';
+            return n + 1;
+        }
+
+        template<typename Stored>
+        static std::uint64_t key_impl(void* storage, registry::RepeatPayload& header) noexcept
+        {
+            return coalesce_key(static_cast<Stored*>(storage)->env, header);
         }
 
     private:
@@ -95,12 +194,82 @@ namespace logger::core::detail
         LogEngine(const LogEngine &) = delete;
         LogEngine &operator=(const LogEngine &) = delete;
 
+        // Everything one worker thread owns. Worker k publishes through its
+        // own channel (handle) into its own sink objects, so workers never
+        // share a queue, a staging buffer or a single-writer sink.
+        struct Shard
+        {
+            std::size_t index{0};
+            publisher::runtime::RegistrationHandle handle{registry()};
+            MpscQueue queue;
+            WorkerWaiter waiter;
+            StagingBuffer staging;                              // worker-only
+            ReorderBuffer reorder;                              // worker-only; ordering.reorder_window
+            Coalescer coalesce;                                 // worker-only; coalesce.window
+            std::uint64_t pass_start{0};                        // worker-only; reorder arrival, coalescing clock
+            RecycleBatch<PoolFreeList> recycle;                 // worker-only
+            publisher::runtime::RotatingFile file;              // worker-only once running
+            publisher::runtime::UringFile async_file;           // worker-only once running
+            publisher::runtime::SocketSink collector;           // worker-only once running
+            publisher::runtime::MmapRing crash_ring;            // worker-only once running
+            std::thread thread;
+        };
+
+        // A producer thread keeps the worker it was first given, so its
+        // records stay in order; threads are spread round-robin.
+        Shard& local_shard() noexcept
+        {
+            if (workers_ == 1)
+                return shards_[0];
+            static thread_local const std::size_t pick =
+                next_shard_.fetch_add(1, std::memory_order_relaxed);
+            return shards_[pick % workers_];
+        }
+
+        // Lanes are split between workers by registration slot.
+        Shard& shard_of(const SpscLane& lane) noexcept
+        {
+            return shards_[lane.slot % workers_];
+        }
+
         template <typename Envelope>
         struct StoredEnvelope
         {
             Envelope env;
+            [[no_unique_address]] CapturedStrings<kStringFields<Envelope>> strings{};
         };
 
+        // What the record holds for an envelope too big for its storage:
+        // the envelope lives in a SpillArena block. The formatters only use
+        // obj->env, so they serve both forms.
+        template <typename Envelope>
+        struct SpilledEnvelope
+        {
+            Envelope&  env;
+            SpillBlock block;
+            [[no_unique_address]] CapturedStrings<kStringFields<Envelope>> strings{};
+
+            ~SpilledEnvelope()
+            {
+                env.~Envelope();
+                block.chunk->release();
+            }
+        };
+
+        template <typename Envelope>
+        static constexpr bool fits_inline = sizeof(StoredEnvelope<Envelope>) <= LogRecord::StorageSize &&
+                                            alignof(StoredEnvelope<Envelope>) <= LogRecord::StorageAlign;
+
+        template <typename Envelope>
+        using StoredFor = std::conditional_t<fits_inline<Envelope>, StoredEnvelope<Envelope>, SpilledEnvelope<Envelope>>;
+
+        // This thread's spill arena (LogEngine is a singleton).
+        SpillArena& local_spill() noexcept
+        {
+            static thread_local SpillArena arena{spill_};
+            return arena;
+        }
+
         template <typename Stored>
         static void destroy_impl(void *storage) noexcept
         {
@@ -108,30 +277,304 @@ namespace logger::core::detail
             obj->~Stored();
         }
 
+        // The enqueue path; put(rec) -> bool builds the envelope in the
+        // record (false: nothing built, the record is not queued). probe
+        // has the severity the overflow policy looks at.
+        template <Overflow Policy, typename Probe, typename Put>
+        void submit(const Probe &probe, Put &&put)
+        {
+            ensure_running();
+
+            // SpscLanes: the record is built in place in this thread's ring;
+            // nothing on this path is shared with other producers. The
+            // overflow policies act on the lane: BySeverity against its fill,
+            // DropOldest on its own records.
+            if (lanes_)
+            {
+                if (SpscLane *lane = lanes_->local())
+                {
+                    if constexpr (Policy == Overflow::BySeverity)
+                    {
+                        const uint64_t from = backpressure_.shed_from(severity_of(probe), lane->capacity());
+                        if (lane->producer_size(from) >= from)
+                        {
+                            backpressure_.count_severity_shed();
+                            lane->count_dropped();
+                            return;
+                        }
+                    }
+
+                    LogRecord *slot = lane->try_reserve();
+                    if (!slot) [[unlikely]]
+                        slot = on_overflow<Policy>(probe, [lane] { return lane->try_reserve(); }, lane->shed);
+                    if (!slot)
+                    {
+                        lane->count_dropped();
+                        return;
+                    }
+
+                    if (!put(slot)) [[unlikely]]
+                    {
+                        lane->count_dropped();      // slot stays reserved for the next record
+                        return;
+                    }
+                    slot->sheddable = Policy == Overflow::DropOldest;
+                    lane->commit();
+                    lane->count_enqueued();
+                    shard_of(*lane).waiter.notify();
+                    return;
+                }
+                // every lane is taken — fall through to the shared path
+            }
+
+            if constexpr (Policy == Overflow::BySeverity)
+            {
+                const uint64_t in_use = enqueued_.load(std::memory_order_relaxed) -
+                                        pool_released_.load(std::memory_order_relaxed);
+                if (backpressure_.sheds(severity_of(probe), in_use, arena_.capacity()))
+                {
+                    backpressure_.count_severity_shed();
+                    note_pool_miss();
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+
+            LogRecord *rec = acquire_record();
+            if (!rec) [[unlikely]]
+            {
+                note_pool_miss();
+                rec = on_overflow<Policy>(probe, [this] { return acquire_record(); }, backpressure_.shed());
+            }
+            if (!rec)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            if (!put(rec)) [[unlikely]]
+            {
+                freelist_.push(rec);
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            rec->sheddable = Policy == Overflow::DropOldest;
+            Shard& shard = local_shard();
+            shard.queue.push(rec);
+            enqueued_.fetch_add(1, std::memory_order_relaxed);
+            shard.waiter.notify();
+        }
+
+        // emplace()'s probe: only the severity is known before the record.
+        struct SeverityOf
+        {
+            Severity severity;
+        };
+
+        // False (and the envelope untouched) only when a spilled envelope
+        // finds the spill pool at max_bytes.
+        template <typename Envelope>
+        bool emplace_envelope(LogRecord *rec, Envelope &&env)
+        {
+            using E = std::decay_t<Envelope>;
+            using Stored = StoredFor<E>;
+
+            static_assert(sizeof(Stored) <= LogRecord::StorageSize && alignof(Stored) <= LogRecord::StorageAlign);
+            static_assert(alignof(E) <= alignof(SpillChunk), "Envelope alignment too strict to spill");
+
+            void *mem = rec->storage_ptr();
+
+            if constexpr (fits_inline<E>)
+                new (mem) Stored{std::forward<Envelope>(env)};
+            else
+            {
+                const SpillBlock block = local_spill().allocate(sizeof(E), alignof(E));
+                if (!block)
+                    return false;
+                new (mem) Stored{*new (block.ptr) E(std::forward<Envelope>(env)), block};
+            }
+
+            finish_envelope<E, Stored>(rec);
+            return true;
+        }
+
+        // emplace(): the envelope is value-initialised where emplace_envelope
+        // would have moved it to, Builder assigns the fields there, then
+        // init(envelope) runs.
+        template <MsgTag Tag, typename E, typename Fields, typename Init>
+        bool build_envelope(LogRecord *rec, const Fields &fields, Init &init)
+        {
+            using Stored = StoredFor<E>;
+
+            static_assert(sizeof(Stored) <= LogRecord::StorageSize && alignof(Stored) <= LogRecord::StorageAlign);
+            static_assert(alignof(E) <= alignof(SpillChunk), "Envelope alignment too strict to spill");
+
+            void *mem = rec->storage_ptr();
+            E *env = nullptr;
+
+            if constexpr (fits_inline<E>)
+                env = &(new (mem) Stored{})->env;
+            else
+            {
+                const SpillBlock block = local_spill().allocate(sizeof(E), alignof(E));
+                if (!block)
+                    return false;
+                env = new (block.ptr) E{};
+                new (mem) Stored{*env, block};
+            }
+
+            registry::Builder::assign<Tag>(*env, fields);
+            init(*env);
+            finish_envelope<E, Stored>(rec);
+            return true;
+        }
+
+        // The rest of a record once its envelope is in place.
+        template <typename E, typename Stored>
+        void finish_envelope(LogRecord *rec)
+        {
+            void *mem = rec->storage_ptr();
+
+            // The caller's strings may be gone before the worker gets here.
+            if constexpr (kStringFields<E> > 0)
+            {
+                auto *obj = static_cast<Stored *>(mem);
+                const CaptureTail tail{reinterpret_cast<char *>(rec->storage) + sizeof(Stored),
+                                       reinterpret_cast<char *>(rec->storage) + LogRecord::StorageSize};
+                if (const std::size_t cut = capture_strings(obj->env, obj->strings, tail, &local_spill(),
+                                                            cfg_.max_string_bytes)) [[unlikely]]
+                    truncated_.fetch_add(cut, std::memory_order_relaxed);
+            }
+
+            if (stamp_)
+                stamp(rec, static_cast<Stored *>(mem)->env);
+
+            rec->destroy_fn = &destroy_impl<Stored>;
+            if constexpr (codec::BinaryEncodable<E>)
+                rec->format_fn = binary_ ? &encode_impl<Stored> : json_ ? &json_impl<Stored> : &format_impl<Stored>;
+            else
+                rec->format_fn = binary_ ? &text_frame_impl<Stored> : json_ ? &json_text_impl<Stored> : &format_impl<Stored>;
+            if constexpr (registry::RegisteredPayload<E>)
+                rec->key_fn = coalesce_ns_ ? &key_impl<Stored> : nullptr;
+            else
+                rec->key_fn = nullptr;
+        }
+
+        // Producer side of EngineConfig::ordering. Header fields the caller
+        // set are left alone.
+        template <typename Envelope>
+        static void stamp(LogRecord *rec, Envelope &env) noexcept
+        {
+            ProducerStamp &p = producer_stamp();
+            rec->stamp    = stamp_now();
+            rec->producer = p.id;
+            rec->seq      = p.next_seq++;
+
+            if constexpr (requires { env.timestamp = rec->stamp; env.thread_id = p.id; })
+            {
+                if (env.timestamp == 0)
+                    env.timestamp = rec->stamp / 1000;
+                if (env.thread_id == 0)
+                    env.thread_id = p.id;
+            }
+        }
+
+        // Slow path once the pool or lane is full: wait, ask the worker to
+        // shed, or give up, depending on Policy. nullptr = drop. A DropOldest
+        // request goes to `shed` — the pool's, or the lane's whose slot is
+        // wanted — and is withdrawn once the wait ends, so it never outlives
+        // the producer's need for a record (see ShedRequests::cancel).
+        template <Overflow Policy, typename Envelope, typename TryAcquire>
+        LogRecord* on_overflow(const Envelope& env, TryAcquire&& try_acquire, ShedRequests& shed)
+        {
+            if constexpr (Policy == Overflow::DropOldest)
+                shed.request();
+
+            LogRecord* rec = nullptr;
+            if (overflow_waits<Policy>(env))
+                rec = backpressure_.wait_for_record(try_acquire);
+            else
+                backpressure_.count_full_drop();
+
+            if constexpr (Policy == Overflow::DropOldest)
+                shed.cancel();
+            return rec;
+        }
+
+        // An Mpsc enqueue found the pool empty (BySeverity: nearly so) and
+        // will be dropped or wait; pool growth counts these. Worker 0 may be
+        // parked with the records sitting in magazines, so it is woken.
+        void note_pool_miss() noexcept
+        {
+            pool_misses_.fetch_add(1, std::memory_order_relaxed);
+            if (cfg_.max_pool_slabs)
+                shards_[0].waiter.notify();
+        }
+
         static publisher::runtime::TokenRegistry& registry() noexcept;
         static publisher::runtime::OutputResourceStore& store() noexcept;
 
-        void ensure_running();
+        void ensure_running()
+        {
+            if (!run_.load(std::memory_order_acquire)) [[unlikely]]
+                start_worker();
+        }
+
+        void start_worker();
         void init_pool_and_queue();
+        bool open_sinks(Shard& shard, const EngineConfig& cfg, std::vector<std::string>& created);
+        void close_sinks(Shard& shard) noexcept;
         LogRecord* acquire_record();
-        void push_to_queue(LogRecord* rec);
-        void worker_loop();
+        void recycle(Shard& shard, LogRecord* rec);
+        void seed_freelist(LogRecord* first, std::size_t count);
+        bool growth_due() const noexcept;
+        void maybe_grow_pool();
+        void worker_loop(Shard& shard);
+        std::size_t drain_once(Shard& shard, LogRecord*& pending_recycle);
+        bool has_work(const Shard& shard) const noexcept;
+        WorkerWaiter::clock::time_point idle_deadline(const Shard& shard) const noexcept;
+        void process(Shard& shard, LogRecord* rec, ShedRequests& shed);
+        template <typename Format>
+        void write(Shard& shard, Format&& format, const StampKey& key);
+        void write_repeat(Shard& shard, const registry::RepeatPayload& summary);
+        void stage(Shard& shard, std::string_view formatted);
+        void release_due(Shard& shard);
+        void flush_staging(Shard& shard);
+        void flush_sinks(Shard& shard) noexcept;
         void stop_worker() noexcept;
 
     private:
-        publisher::runtime::RegistrationHandle publishHandle_{};
+        EngineConfig cfg_{};
 
-        std::unique_ptr<LogRecord[]> pool_storage_;
-        std::size_t pool_size_{0};
+        RecordArena arena_;
+        uint64_t misses_at_last_slab_{0};   // worker 0 only
 
-        FreeList freelist_;
-        MpscQueue queue_;
+        PoolFreeList freelist_;
+        std::unique_ptr<LaneSet> lanes_;
+        PoolBackpressure backpressure_;
+        bool binary_{false};        // SinkFormat::Binary, fixed by configure()
+        bool file_{false};          // writes go to Shard::file: Binary (Buffered), TextFile, JsonFile
+        bool async_{false};         // FileBackend::IoUring
+        bool socket_{false};        // SinkFormat::Socket or JsonSocket
+        bool json_{false};          // SinkFormat::Json, JsonSocket or JsonFile
+        bool ring_{false};          // crash_ring enabled
+        bool stamp_{false};         // ordering.stamp or a reorder window
+        std::uint64_t reorder_ns_{0};   // ordering.reorder_window; 0 = off
+        std::uint64_t coalesce_ns_{0};  // coalesce.window; 0 = off
+        std::size_t workers_{1};    // EngineConfig::workers, fixed by configure()
+        std::array<Shard, kMaxWorkers> shards_;
+        SpillPool spill_;           // EngineConfig::spill
+        std::atomic<std::size_t> next_shard_{0};
         std::atomic<bool> run_{false};
-        std::thread worker_;
+        std::mutex lifecycle_mtx_;
 
         std::atomic<uint64_t> dropped_{0};
         std::atomic<uint64_t> enqueued_{0};
         std::atomic<uint64_t> written_{0};
+        std::atomic<uint64_t> truncated_{0};
+        std::atomic<uint64_t> pool_released_{0};    // Mpsc records done
+        std::atomic<uint64_t> pool_misses_{0};      // see note_pool_miss()
     };
 
 } // namespace logger::core::detail
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include <memory>
 #include <cstddef>
 
+namespace logger::registry
+{
+    struct RepeatPayload;
+}
+
 namespace logger::core::detail
 {
     struct MpscNode
@@ -11,24 +16,49 @@ namespace logger::core::detail
         std::atomic<MpscNode *> next{nullptr};
     };
 
+    // free_next links the records of one chain; chain_next links chains
+    // on the FreeList (a chain of one is an ordinary single node).
     struct FreeNode
     {
         FreeNode *free_next{nullptr};
+        FreeNode *chain_next{nullptr};
     };
 
     struct alignas(64) LogRecord : MpscNode, FreeNode
     {
+        // Producer stamp, set at enqueue when EngineConfig::ordering asks
+        // for it: steady-clock ns, small per-thread id, per-thread sequence.
+        // Lives in the padding before storage, so the record does not grow.
+        std::uint64_t stamp{0};
+        std::uint64_t seq{0};
+        std::uint32_t producer{0};
+
+        // Enqueued under Overflow::DropOldest: the only records a shed
+        // request may discard.
+        bool sheddable{false};
+
+        // Envelopes that do not fit are spilled: storage then holds a
+        // pointer into a SpillArena chunk (spill_arena.hpp).
         static constexpr std::size_t StorageSize = 256;
         static constexpr std::size_t StorageAlign = 64;
 
         alignas(StorageAlign) unsigned char storage[StorageSize];
 
         using DestroyFn = void (*)(void *storage);
-        using SubmitFn  = void (*)(void *storage);
+        // Renders the record into [dst, dst + cap); returns bytes written.
+        using FormatFn  = std::size_t (*)(void *storage, char *dst, std::size_t cap);
+        // Coalescing key of the record; fills in the header a Repeat
+        // record would carry (coalescer.hpp).
+        using KeyFn     = std::uint64_t (*)(void *storage, registry::RepeatPayload &header);
 
         DestroyFn destroy_fn{nullptr};
-        SubmitFn  submit_fn{nullptr};
+        FormatFn  format_fn{nullptr};   // render into a staging buffer
+        KeyFn     key_fn{nullptr};      // EngineConfig::coalesce; nullptr = never coalesced
 
         void *storage_ptr() noexcept { return static_cast<void *>(storage); }
     };
+
+    // The function pointers fill the tail padding after storage: a record
+    // is six cache lines whatever hooks it carries.
+    static_assert(sizeof(LogRecord) == 384);
 }
@@ -0,0 +1,233 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "common/messages/payloads/payloads.hpp"
+#include "log_record.hpp"
+#include "wait_strategy.hpp"
+
+namespace logger::core
+{
+    // What LogEngine::enqueue does when no record is free. Chosen per call
+    // site at compile time: enqueue<Overflow::Block>(env),
+    // Handler::log<Tag, Overflow::Block>(...). Under QueueMode::SpscLanes
+    // "the pool" is the producer's own lane: DropOldest discards from it
+    // and BySeverity measures its fill.
+    enum class Overflow : std::uint8_t
+    {
+        DropNewest, // refuse the new record (default)
+        Block,      // spin, then wait up to OverflowConfig::block_timeout
+        DropOldest, // ask the worker to discard the oldest queued DropOldest record
+        BySeverity  // shed Info/Warn early as the pool fills; Error blocks
+    };
+
+    struct OverflowConfig
+    {
+        // Block / DropOldest / BySeverity(Error): spins before waiting, and
+        // the longest a producer waits before the record is dropped anyway.
+        std::size_t block_spins = 64;
+        std::chrono::microseconds block_timeout{1000};
+
+        // BySeverity: pool occupancy (percent of capacity) at which Info and
+        // Warn records start being refused.
+        unsigned shed_info_percent = 75;
+        unsigned shed_warn_percent = 90;
+    };
+
+    // Per-policy breakdown. dropped() on the engine is the sum of the
+    // refusals; shed_oldest records were enqueued and discarded unwritten.
+    struct OverflowStats
+    {
+        uint64_t dropped_full     = 0;  // DropNewest (and Info/Warn) on an empty pool
+        uint64_t blocked          = 0;  // enqueues that had to wait
+        uint64_t block_timeouts   = 0;  // ... and gave up
+        uint64_t shed_oldest      = 0;  // DropOldest records discarded by the worker
+        uint64_t shed_by_severity = 0;  // refused early by BySeverity
+    };
+
+    [[nodiscard]] constexpr const char* toString(Overflow p) noexcept
+    {
+        switch (p)
+        {
+            case Overflow::DropNewest: return "DropNewest";
+            case Overflow::Block:      return "Block";
+            case Overflow::DropOldest: return "DropOldest";
+            case Overflow::BySeverity: return "BySeverity";
+            default: return "UnknownOverflow";
+        }
+    }
+
+    // Envelopes without a severity field are treated as Error, i.e. never
+    // shed early.
+    template <typename Envelope>
+    [[nodiscard]] constexpr Severity severity_of(const Envelope& env) noexcept
+    {
+        if constexpr (requires { { env.severity } -> std::convertible_to<Severity>; })
+            return env.severity;
+        else
+            return Severity::Error;
+    }
+
+    // Whether `env` waits for a free record under `Policy`.
+    template <Overflow Policy, typename Envelope>
+    [[nodiscard]] constexpr bool overflow_waits(const Envelope& env) noexcept
+    {
+        if constexpr (Policy == Overflow::Block || Policy == Overflow::DropOldest)
+            return true;
+        else if constexpr (Policy == Overflow::BySeverity)
+            return severity_of(env) == Severity::Error;
+        else
+            return false;
+    }
+} // namespace logger::core
+
+namespace logger::core::detail
+{
+    // DropOldest. PRODUCER: ask for one queued DropOldest record to be
+    // discarded; cancel() withdraws the request once the wait is over,
+    // whether the record came from the shed, from normal recycling or not
+    // at all. Requests are not tied to producers: with several waiting, a
+    // withdrawal may take another's pending request, which then waits on
+    // recycling alone. Fewer sheds, never an extra one.
+    //
+    // The shared pool has one set of requests; each SpscLane has its own,
+    // so a lane producer only ever sheds records from its own lane.
+    class ShedRequests
+    {
+    public:
+        void request() noexcept { requests_.fetch_add(1, std::memory_order_relaxed); }
+        void cancel()  noexcept { take(); }
+
+        // WORKER: true if the next sheddable record should be discarded
+        // unwritten.
+        bool take() noexcept
+        {
+            uint64_t r = requests_.load(std::memory_order_relaxed);
+            while (r != 0)
+            {
+                if (requests_.compare_exchange_weak(r, r - 1, std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        }
+        bool pending() const noexcept { return requests_.load(std::memory_order_relaxed) != 0; }
+
+    private:
+        std::atomic<uint64_t> requests_{0};
+    };
+
+    // Slow-path state shared by producers that found the pool empty and the
+    // worker that frees records. Nothing here is touched while records are
+    // available.
+    //
+    // Waiting producers sleep on a condition variable in short slices; the
+    // worker notifies after a productive pass only while waiters() != 0.
+    // A notify racing a producer that is about to wait costs at most one
+    // slice, never a hang.
+    class PoolBackpressure
+    {
+    public:
+        void configure(const OverflowConfig& cfg) noexcept { cfg_ = cfg; }
+        const OverflowConfig& config() const noexcept { return cfg_; }
+
+        // PRODUCER: retry try_acquire() until it yields a record or
+        // block_timeout passes; nullptr on timeout.
+        template <typename TryAcquire>
+        LogRecord* wait_for_record(TryAcquire&& try_acquire)
+        {
+            blocked_.fetch_add(1, std::memory_order_relaxed);
+
+            for (std::size_t i = 0; i < cfg_.block_spins; ++i)
+            {
+                cpu_relax();
+                if (LogRecord* rec = try_acquire())
+                    return rec;
+            }
+
+            using clock = std::chrono::steady_clock;
+            const auto deadline = clock::now() + cfg_.block_timeout;
+
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            LogRecord* rec = nullptr;
+            {
+                std::unique_lock lock(mtx_);
+                while (!(rec = try_acquire()) && clock::now() < deadline)
+                    cv_.wait_for(lock, kSlice);
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+            if (!rec)
+                block_timeouts_.fetch_add(1, std::memory_order_relaxed);
+            return rec;
+        }
+
+        // WORKER: records went back to the pool.
+        void notify_freed()
+        {
+            if (waiters_.load(std::memory_order_relaxed) == 0)
+                return;
+            std::lock_guard lock(mtx_);
+            cv_.notify_all();
+        }
+
+        uint32_t waiters() const noexcept { return waiters_.load(std::memory_order_relaxed); }
+
+        // DropOldest on the shared pool (ShedRequests).
+        ShedRequests& shed() noexcept { return shed_; }
+        void request_shed() noexcept { shed_.request(); }
+        void cancel_shed()  noexcept { shed_.cancel(); }
+        bool take_shed()    noexcept { return shed_.take(); }
+        bool shed_pending() const noexcept { return shed_.pending(); }
+
+        // BySeverity. PRODUCER: refuse `s` given the pool occupancy?
+        bool sheds(Severity s, uint64_t in_use, std::size_t capacity) const noexcept
+        {
+            return in_use >= shed_from(s, capacity);
+        }
+
+        // Occupancy of `capacity` slots from which `s` is refused; never
+        // reached for Error.
+        uint64_t shed_from(Severity s, std::size_t capacity) const noexcept
+        {
+            if (s == Severity::Error)
+                return UINT64_MAX;
+            const unsigned percent = s == Severity::Info ? cfg_.shed_info_percent
+                                                         : cfg_.shed_warn_percent;
+            return (static_cast<uint64_t>(capacity) * percent + 99) / 100;
+        }
+
+        void count_full_drop()     noexcept { dropped_full_.fetch_add(1, std::memory_order_relaxed); }
+        void count_severity_shed() noexcept { shed_by_severity_.fetch_add(1, std::memory_order_relaxed); }
+        void count_shed_oldest()   noexcept { shed_oldest_.fetch_add(1, std::memory_order_relaxed); }
+
+        OverflowStats stats() const noexcept
+        {
+            return {dropped_full_.load(std::memory_order_relaxed),
+                    blocked_.load(std::memory_order_relaxed),
+                    block_timeouts_.load(std::memory_order_relaxed),
+                    shed_oldest_.load(std::memory_order_relaxed),
+                    shed_by_severity_.load(std::memory_order_relaxed)};
+        }
+
+    private:
+        static constexpr std::chrono::microseconds kSlice{50};
+
+        OverflowConfig cfg_{};
+
+        alignas(64) std::atomic<uint32_t> waiters_{0};
+        ShedRequests shed_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+
+        alignas(64) std::atomic<uint64_t> dropped_full_{0};
+        std::atomic<uint64_t> blocked_{0};
+        std::atomic<uint64_t> block_timeouts_{0};
+        std::atomic<uint64_t> shed_oldest_{0};
+        std::atomic<uint64_t> shed_by_severity_{0};
+    };
+} // namespace logger::core::detail
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+#include "log_record.hpp"
+
+namespace logger::core::detail
+{
+    // Backing store for the LogEngine record pool.
+    //
+    // reserve() maps address space for the largest pool the engine may ever
+    // need without committing memory; commit() turns the next slab of it into
+    // constructed LogRecords. Slabs are never released before the arena dies,
+    // so once the pool has grown the steady state allocates nothing.
+    //
+    // All records live in one contiguous range starting at base(), which
+    // keeps TaggedFreeList's offset encoding valid across growth. The range
+    // is 2 MiB aligned and advised MADV_HUGEPAGE where the kernel supports
+    // it; huge_pages() reports whether that advice was accepted.
+    //
+    // reserve()/commit() are single-threaded (LogEngine: init and worker);
+    // capacity() and slabs() may be read from any thread.
+    class RecordArena
+    {
+    public:
+        RecordArena() = default;
+        ~RecordArena();
+
+        RecordArena(const RecordArena&) = delete;
+        RecordArena& operator=(const RecordArena&) = delete;
+
+        // Throws std::bad_alloc if the address space cannot be mapped.
+        void reserve(std::size_t max_records);
+
+        // Construct `count` more records; nullptr when the reservation is
+        // exhausted or the kernel refuses to commit the pages.
+        LogRecord* commit(std::size_t count) noexcept;
+
+        LogRecord*  base()     const noexcept { return base_; }
+        std::size_t reserved() const noexcept { return reserved_; }
+        bool        huge_pages() const noexcept { return huge_pages_; }
+
+        std::size_t capacity() const noexcept { return capacity_.load(std::memory_order_relaxed); }
+        std::size_t slabs()    const noexcept { return slabs_.load(std::memory_order_relaxed); }
+
+    private:
+        void*       mapping_{nullptr};
+        std::size_t mapping_bytes_{0};
+        LogRecord*  base_{nullptr};
+        std::size_t reserved_{0};
+        bool        huge_pages_{false};
+
+        std::atomic<std::size_t> capacity_{0};
+        std::atomic<std::size_t> slabs_{0};
+    };
+}
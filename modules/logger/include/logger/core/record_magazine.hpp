@@ -0,0 +1,125 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "log_record.hpp"
+
+namespace logger::core::detail
+{
+    // Producer-side cache of free records in front of the shared FreeList.
+    //
+    // acquire() serves from a small local stack and refills it with one
+    // try_pop_chain() — one CAS per chain instead of one per record. The
+    // owner must be a single thread (LogEngine keeps one per producer in a
+    // thread_local); flush() / the destructor hand leftovers back so records
+    // are not stranded when the thread exits.
+    template <typename FreeListT>
+    class RecordMagazine
+    {
+    public:
+        static constexpr std::size_t kMaxCapacity = 64;
+
+        explicit RecordMagazine(std::size_t capacity = 16) noexcept
+            : capacity_(capacity < kMaxCapacity ? capacity : kMaxCapacity)
+        {}
+
+        ~RecordMagazine()
+        {
+            if (home_)
+                flush(*home_);
+        }
+
+        RecordMagazine(const RecordMagazine&) = delete;
+        RecordMagazine& operator=(const RecordMagazine&) = delete;
+
+        LogRecord* acquire(FreeListT& global) noexcept
+        {
+            if (count_ == 0 && !refill(global))
+                return nullptr;
+            return items_[--count_];
+        }
+
+        // Return every cached record to `global` as a single chain.
+        void flush(FreeListT& global) noexcept
+        {
+            if (count_ == 0)
+                return;
+
+            for (std::size_t i = 0; i + 1 < count_; ++i)
+                items_[i]->free_next = items_[i + 1];
+            items_[count_ - 1]->free_next = nullptr;
+
+            global.push_chain(items_[0]);
+            count_ = 0;
+        }
+
+        std::size_t size()     const noexcept { return count_; }
+        std::size_t capacity() const noexcept { return capacity_; }
+
+    private:
+        bool refill(FreeListT& global) noexcept
+        {
+            home_ = &global;
+
+            FreeNode* node = global.try_pop_chain();
+            if (!node)
+                return false;
+
+            while (node && count_ < capacity_)
+            {
+                FreeNode* next = node->free_next;
+                node->free_next = nullptr;
+                items_[count_++] = static_cast<LogRecord*>(node);
+                node = next;
+            }
+
+            // Chain longer than the magazine — give the tail back.
+            if (node)
+                global.push_chain(node);
+
+            return true;
+        }
+
+        std::array<LogRecord*, kMaxCapacity> items_{};
+        std::size_t count_{0};
+        std::size_t capacity_;
+        FreeListT*  home_{nullptr};
+    };
+
+    // Worker-side counterpart: recycled records are linked into a chain and
+    // returned with one push_chain() once `batch` of them have accumulated.
+    // The worker must flush() whenever it goes idle, otherwise producers
+    // could starve on records parked here.
+    template <typename FreeListT>
+    class RecycleBatch
+    {
+    public:
+        explicit RecycleBatch(std::size_t batch = 16) noexcept
+            : batch_(batch ? batch : 1)
+        {}
+
+        void add(LogRecord* rec, FreeListT& global) noexcept
+        {
+            rec->free_next = first_;
+            first_ = rec;
+            if (++count_ >= batch_)
+                flush(global);
+        }
+
+        void flush(FreeListT& global) noexcept
+        {
+            if (!first_)
+                return;
+            global.push_chain(first_);
+            first_ = nullptr;
+            count_ = 0;
+        }
+
+        std::size_t size() const noexcept { return count_; }
+
+    private:
+        FreeNode*   first_{nullptr};
+        std::size_t count_{0};
+        std::size_t batch_;
+    };
+}
@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "log_clock.hpp"
+
+namespace logger::core
+{
+    // Producer stamps and the worker-side merge (EngineConfig::ordering).
+    struct OrderingConfig
+    {
+        // Stamp every record at enqueue with a LogClock time, a small
+        // per-thread id and a per-thread sequence number. PayloadBase
+        // envelopes also get the time (microseconds since the epoch, what
+        // TextSink renders) and the id in their timestamp/thread_id header
+        // fields, where the caller left those 0.
+        bool stamp = false;
+
+        // > 0: each worker holds formatted records this long and writes
+        // them in (timestamp, thread, sequence) order — a k-way merge of its
+        // producers' streams within a bounded window. Implies stamp. A
+        // record that reaches the worker more than the window late is
+        // written out of order and counted as late. Order holds per worker;
+        // with several workers each one's output is ordered on its own.
+        std::chrono::microseconds reorder_window{0};
+
+        // Most a worker holds at once. When either is reached the oldest
+        // record is written before its window is up (counted as forced).
+        // reorder_bytes is raised to at least four records' worth.
+        std::size_t reorder_records = 4096;
+        std::size_t reorder_bytes   = 512 * 1024;
+    };
+
+    // Merge counters, summed over the workers.
+    struct ReorderStats
+    {
+        uint64_t released = 0;
+        uint64_t late     = 0;      // written after a record with a later stamp
+        uint64_t forced   = 0;      // written early because the buffer was full
+
+        // Time records spent held: the latency the merge adds.
+        uint64_t hold_ns_total = 0;
+        uint64_t hold_ns_max   = 0;
+    };
+} // namespace logger::core
+
+namespace logger::core::detail
+{
+    // The clock every producer stamps with, so stamps from different
+    // threads compare: LogClock nanoseconds since the epoch.
+    inline std::uint64_t stamp_now() noexcept
+    {
+        return LogClock::instance().now_ns();
+    }
+
+    // This thread's id (1, 2, ... in order of first use) and the sequence
+    // number its next record gets.
+    struct ProducerStamp
+    {
+        std::uint32_t id{0};
+        std::uint64_t next_seq{0};
+    };
+
+    inline ProducerStamp& producer_stamp() noexcept
+    {
+        static std::atomic<std::uint32_t> ids{0};
+        static thread_local ProducerStamp stamp{ids.fetch_add(1, std::memory_order_relaxed) + 1};
+        return stamp;
+    }
+
+    // Merge order: stamp first; the thread id and sequence break ties and
+    // keep one thread's records in the order it logged them.
+    struct StampKey
+    {
+        std::uint64_t stamp{0};
+        std::uint32_t producer{0};
+        std::uint64_t seq{0};
+
+        friend auto operator<=>(const StampKey&, const StampKey&) = default;
+    };
+
+    // Worker-side reorder window over formatted records.
+    //
+    // Records are formatted into a byte ring in arrival order and indexed
+    // by a min-heap on StampKey; release() pops every record stamped at or
+    // before a cut-off, so the output is in stamp order as long as nothing
+    // arrives later than the window. Ring space is reclaimed from the
+    // oldest arrival once it has been written, so a record far behind the
+    // rest holds its bytes until it goes. Single-threaded apart from
+    // stats(), which may be read from any thread.
+    class ReorderBuffer
+    {
+    public:
+        ReorderBuffer() = default;
+
+        ReorderBuffer(std::size_t bytes, std::size_t records)
+            : buf_(std::make_unique<char[]>(bytes))
+            , cap_(bytes)
+            , entries_(round_up_pow2(records ? records : 1))
+            , mask_(entries_.size() - 1)
+        {
+            heap_.reserve(entries_.size());
+        }
+
+        bool        enabled() const noexcept { return cap_ != 0; }
+        bool        empty()   const noexcept { return heap_.empty(); }
+        std::size_t size()    const noexcept { return heap_.size(); }
+
+        // Room for another record of up to `bytes` (at most the capacity)?
+        bool has_room(std::size_t bytes) const noexcept
+        {
+            return next_ - first_ < entries_.size() && place(bytes) + bytes - head_ <= cap_;
+        }
+
+        // Format one record through fmt(char* dst, size_t cap) -> size_t,
+        // giving it at most `limit` bytes. The caller checks has_room() first.
+        template <typename Format>
+        void append(const StampKey& key, std::uint64_t now, Format&& fmt, std::size_t limit)
+        {
+            const std::uint64_t pos = place(limit);
+            const std::size_t n = fmt(buf_.get() + pos % cap_, limit);
+            tail_ = pos + n;
+
+            entries_[next_ & mask_] = Entry{key, now, pos, n, false};
+            heap_.push_back(next_++);
+            std::push_heap(heap_.begin(), heap_.end(), later());
+        }
+
+        // Stamp of the oldest record held; only when !empty().
+        std::uint64_t oldest_stamp() const noexcept { return at(heap_.front()).key.stamp; }
+
+        // Write every record stamped at or before `cutoff` through
+        // emit(std::string_view), oldest first. The view is valid only
+        // during the call.
+        template <typename Emit>
+        std::size_t release(std::uint64_t cutoff, std::uint64_t now, Emit&& emit)
+        {
+            std::size_t n = 0;
+            while (!heap_.empty() && oldest_stamp() <= cutoff)
+            {
+                pop(now, emit);
+                ++n;
+            }
+            return n;
+        }
+
+        // Buffer full: write the oldest record before its window is up.
+        template <typename Emit>
+        void release_oldest(std::uint64_t now, Emit&& emit)
+        {
+            bump(forced_);
+            pop(now, emit);
+        }
+
+        template <typename Emit>
+        void release_all(std::uint64_t now, Emit&& emit)
+        {
+            while (!heap_.empty())
+                pop(now, emit);
+        }
+
+        ReorderStats stats() const noexcept
+        {
+            ReorderStats s;
+            s.released      = released_.load(std::memory_order_relaxed);
+            s.late          = late_.load(std::memory_order_relaxed);
+            s.forced        = forced_.load(std::memory_order_relaxed);
+            s.hold_ns_total = hold_total_.load(std::memory_order_relaxed);
+            s.hold_ns_max   = hold_max_.load(std::memory_order_relaxed);
+            return s;
+        }
+
+        ReorderBuffer(ReorderBuffer&& o) noexcept { *this = std::move(o); }
+
+        // Only while empty (set up before the worker starts).
+        ReorderBuffer& operator=(ReorderBuffer&& o) noexcept
+        {
+            buf_     = std::move(o.buf_);
+            cap_     = o.cap_;
+            entries_ = std::move(o.entries_);
+            mask_    = o.mask_;
+            heap_    = std::move(o.heap_);
+            head_ = tail_ = first_ = next_ = 0;
+            last_ = StampKey{};
+            return *this;
+        }
+
+    private:
+        struct Entry
+        {
+            StampKey      key{};
+            std::uint64_t arrived{0};
+            std::uint64_t pos{0};       // absolute byte position in the ring
+            std::size_t   len{0};
+            bool          done{false};
+        };
+
+        static std::size_t round_up_pow2(std::size_t n) noexcept
+        {
+            std::size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        static void bump(std::atomic<uint64_t>& c, uint64_t by = 1) noexcept
+        {
+            c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        const Entry& at(std::uint64_t i) const noexcept { return entries_[i & mask_]; }
+        Entry&       at(std::uint64_t i) noexcept       { return entries_[i & mask_]; }
+
+        // Min-heap on the key.
+        auto later() const noexcept
+        {
+            return [this](std::uint64_t a, std::uint64_t b) { return at(b).key < at(a).key; };
+        }
+
+        // Where a record of up to `bytes` goes: records never wrap, so skip
+        // to the start if the end of the ring is too short.
+        std::uint64_t place(std::size_t bytes) const noexcept
+        {
+            const std::uint64_t off = tail_ % cap_;
+            return cap_ - off < bytes ? tail_ + (cap_ - off) : tail_;
+        }
+
+        template <typename Emit>
+        void pop(std::uint64_t now, Emit& emit)
+        {
+            std::pop_heap(heap_.begin(), heap_.end(), later());
+            Entry& e = at(heap_.back());
+            heap_.pop_back();
+
+            if (e.key < last_)
+                bump(late_);
+            else
+                last_ = e.key;
+
+            emit(std::string_view(buf_.get() + e.pos % cap_, e.len));
+            e.done = true;
+
+            const std::uint64_t held = now > e.arrived ? now - e.arrived : 0;
+            bump(released_);
+            bump(hold_total_, held);
+            if (held > hold_max_.load(std::memory_order_relaxed))
+                hold_max_.store(held, std::memory_order_relaxed);
+
+            while (first_ < next_ && at(first_).done)
+                ++first_;
+            head_ = first_ < next_ ? at(first_).pos : tail_;
+        }
+
+        std::unique_ptr<char[]> buf_;
+        std::size_t   cap_{0};
+        std::uint64_t head_{0};         // start of the oldest arrival not yet written
+        std::uint64_t tail_{0};
+
+        std::vector<Entry> entries_;    // ring, arrival order
+        std::size_t   mask_{0};
+        std::uint64_t first_{0};        // oldest arrival not yet written
+        std::uint64_t next_{0};
+        std::vector<std::uint64_t> heap_;
+        StampKey      last_{};          // newest key written so far
+
+        std::atomic<uint64_t> released_{0};
+        std::atomic<uint64_t> late_{0};
+        std::atomic<uint64_t> forced_{0};
+        std::atomic<uint64_t> hold_total_{0};
+        std::atomic<uint64_t> hold_max_{0};
+    };
+} // namespace logger::core::detail
@@ -0,0 +1,263 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace logger::core
+{
+    // Second tier for envelopes that do not fit LogRecord::storage
+    // (EngineConfig::spill). The envelope is built in a per-thread bump
+    // arena and the record keeps a pointer and length; everything that
+    // fits stays inline as before.
+    struct SpillConfig
+    {
+        // Producer threads bump-allocate out of chunks of this size. A
+        // chunk goes back to the pool once its thread has moved on and
+        // every envelope in it has been written. An envelope larger than a
+        // chunk gets a chunk of its own, freed after it is written.
+        std::size_t chunk_bytes = 64 * 1024;
+
+        // Most memory held in chunks, in use or pooled. An envelope that
+        // would need more is dropped and counted in dropped().
+        std::size_t max_bytes = 16 * 1024 * 1024;
+    };
+
+    struct SpillStats
+    {
+        uint64_t spilled       = 0;     // envelopes stored out of line
+        uint64_t spilled_bytes = 0;
+        uint64_t failed        = 0;     // dropped: max_bytes reached
+        uint64_t chunks        = 0;     // chunks allocated so far
+        uint64_t held_bytes    = 0;     // in chunks now, in use or pooled
+        uint64_t peak_bytes    = 0;
+    };
+} // namespace logger::core
+
+namespace logger::core::detail
+{
+    class SpillPool;
+    class SpillArena;
+
+    // The SpillArenas of one pool, for stats(): the live ones, whose
+    // counters are summed on demand, and the totals of those gone. Shared
+    // by the pool and its arenas, so either may go first.
+    struct SpillTally
+    {
+        std::mutex  mtx;
+        SpillArena* live{nullptr};          // list through SpillArena::next_
+        uint64_t    spilled{0};             // of arenas destroyed
+        uint64_t    spilled_bytes{0};
+
+        inline void attach(SpillArena& a) noexcept;
+        inline void detach(SpillArena& a) noexcept;
+    };
+
+    // Header in front of a chunk's data. refs counts the blocks not yet
+    // released, plus kOpen while a producer may still bump in the chunk;
+    // the producer only counts its blocks locally and settles the bias
+    // once, in close(), so allocating within a chunk touches nothing
+    // another thread writes (SpillArena's own counters included).
+    struct alignas(64) SpillChunk
+    {
+        static constexpr std::int64_t kOpen = std::int64_t{1} << 40;
+
+        std::atomic<std::int64_t> refs{kOpen};
+        SpillPool*  pool{nullptr};
+        SpillChunk* next{nullptr};      // SpillPool free list
+        std::size_t bytes{0};           // data bytes after the header
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+
+        // One block done (any thread).
+        inline void release() noexcept;
+
+        // Producer: no more blocks from this chunk; `handed` were given out.
+        inline void close(std::int64_t handed) noexcept;
+    };
+    static_assert(sizeof(SpillChunk) == 64);
+
+    // Where an envelope lives out of line.
+    struct SpillBlock
+    {
+        SpillChunk* chunk{nullptr};
+        void*       ptr{nullptr};
+        std::size_t bytes{0};
+
+        explicit operator bool() const noexcept { return chunk != nullptr; }
+    };
+
+    // Chunks shared out to the SpillArenas of the producer threads. take()
+    // and recycle() lock a mutex; that happens once per chunk, not per
+    // envelope.
+    class SpillPool
+    {
+    public:
+        SpillPool() = default;
+        ~SpillPool();
+
+        SpillPool(const SpillPool&) = delete;
+        SpillPool& operator=(const SpillPool&) = delete;
+
+        // Before the first take().
+        void configure(const SpillConfig& cfg) noexcept;
+        std::size_t chunk_bytes() const noexcept { return chunk_bytes_; }
+
+        // A shared chunk (open, kOpen refs), or nullptr at max_bytes.
+        SpillChunk* take() noexcept;
+
+        // A chunk of exactly `bytes` for one block (one ref), or nullptr.
+        SpillChunk* take_dedicated(std::size_t bytes) noexcept;
+
+        // The last ref is gone: pool a shared chunk, free a dedicated one.
+        void recycle(SpillChunk* c) noexcept;
+
+        void count_failed() noexcept { failed_.fetch_add(1, std::memory_order_relaxed); }
+
+        // Sums the arenas' counters under the tally's mutex.
+        SpillStats stats() const noexcept;
+
+        const std::shared_ptr<SpillTally>& tally() const noexcept { return tally_; }
+
+    private:
+        SpillChunk* allocate(std::size_t bytes) noexcept;   // nullptr at max_bytes
+
+        std::size_t chunk_bytes_{SpillConfig{}.chunk_bytes};
+        std::size_t max_bytes_{SpillConfig{}.max_bytes};
+
+        std::mutex  mtx_;
+        SpillChunk* free_{nullptr};     // shared chunks, all refs gone
+
+        std::atomic<uint64_t> held_{0};
+        std::atomic<uint64_t> peak_{0};
+        std::atomic<uint64_t> chunks_{0};
+        std::atomic<uint64_t> failed_{0};
+
+        std::shared_ptr<SpillTally> tally_ = std::make_shared<SpillTally>();
+    };
+
+    inline void SpillChunk::release() noexcept
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            pool->recycle(this);
+    }
+
+    inline void SpillChunk::close(std::int64_t handed) noexcept
+    {
+        const std::int64_t bias = kOpen - handed;
+        if (refs.fetch_sub(bias, std::memory_order_acq_rel) == bias)
+            pool->recycle(this);
+    }
+
+    // One producer thread's bump allocator over SpillPool chunks.
+    // Allocation is a pointer bump; blocks may be released in any order
+    // and from any thread. Not thread-safe itself: one per thread. Its
+    // counters are written by that thread alone (plain load+store, no RMW)
+    // and summed by SpillPool::stats().
+    class SpillArena
+    {
+    public:
+        explicit SpillArena(SpillPool& pool) noexcept : pool_(&pool), tally_(pool.tally()) { tally_->attach(*this); }
+        ~SpillArena()
+        {
+            retire();
+            tally_->detach(*this);
+        }
+
+        SpillArena(const SpillArena&) = delete;
+        SpillArena& operator=(const SpillArena&) = delete;
+
+        // `bytes` aligned to `align` (a power of two, at most 64); an empty
+        // block when the pool is at max_bytes.
+        SpillBlock allocate(std::size_t bytes, std::size_t align) noexcept
+        {
+            if (bytes > pool_->chunk_bytes()) [[unlikely]]
+                return dedicated(bytes);
+
+            std::size_t off = (used_ + align - 1) & ~(align - 1);
+            if (!cur_ || off + bytes > cur_->bytes) [[unlikely]]
+            {
+                retire();
+                cur_ = pool_->take();
+                if (!cur_)
+                {
+                    pool_->count_failed();
+                    return {};
+                }
+                off = 0;
+            }
+
+            used_ = off + bytes;
+            ++handed_;
+            count_spill(bytes);
+            return {cur_, cur_->data() + off, bytes};
+        }
+
+        // Give the current chunk back early (thread exit does this too).
+        void retire() noexcept
+        {
+            if (cur_)
+                cur_->close(handed_);
+            cur_    = nullptr;
+            used_   = 0;
+            handed_ = 0;
+        }
+
+    private:
+        SpillBlock dedicated(std::size_t bytes) noexcept
+        {
+            SpillChunk* c = pool_->take_dedicated(bytes);
+            if (!c)
+            {
+                pool_->count_failed();
+                return {};
+            }
+            count_spill(bytes);
+            return {c, c->data(), bytes};
+        }
+
+        void count_spill(std::size_t bytes) noexcept
+        {
+            spilled_.store(spilled_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            spilled_bytes_.store(spilled_bytes_.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+        }
+
+        friend struct SpillTally;
+        friend class SpillPool;
+
+        SpillPool*    pool_;
+        SpillChunk*   cur_{nullptr};
+        std::size_t   used_{0};
+        std::int64_t  handed_{0};
+
+        std::shared_ptr<SpillTally> tally_;
+        SpillArena*   prev_{nullptr};   // tally_->live list, under its mutex
+        SpillArena*   next_{nullptr};
+        std::atomic<uint64_t> spilled_{0};
+        std::atomic<uint64_t> spilled_bytes_{0};
+    };
+
+    inline void SpillTally::attach(SpillArena& a) noexcept
+    {
+        std::lock_guard lock(mtx);
+        a.next_ = live;
+        if (live)
+            live->prev_ = &a;
+        live = &a;
+    }
+
+    // The arena's counts move into the totals.
+    inline void SpillTally::detach(SpillArena& a) noexcept
+    {
+        std::lock_guard lock(mtx);
+        spilled       += a.spilled_.load(std::memory_order_relaxed);
+        spilled_bytes += a.spilled_bytes_.load(std::memory_order_relaxed);
+        if (a.prev_)
+            a.prev_->next_ = a.next_;
+        else
+            live = a.next_;
+        if (a.next_)
+            a.next_->prev_ = a.prev_;
+    }
+} // namespace logger::core::detail
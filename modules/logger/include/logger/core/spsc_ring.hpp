@@ -0,0 +1,299 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include "log_record.hpp"
+#include "overflow_policy.hpp"
+
+namespace logger::core::detail
+{
+    // Bounded single-producer / single-consumer ring of LogRecord slots.
+    // Records live inline in the ring — no freelist, no MPSC link — so the
+    // producer writes straight into the slot it reserved and publishes it
+    // with a single release store of tail_.
+    //
+    // head_ and tail_ sit on separate cache lines; each side keeps a cached
+    // copy of the other index and only re-reads it when the ring looks
+    // full/empty, so in steady state neither side touches the other's line.
+    class SpscRing
+    {
+    public:
+        explicit SpscRing(std::size_t capacity)
+            : capacity_(round_up_pow2(capacity))
+            , mask_(capacity_ - 1)
+            , slots_(std::make_unique<LogRecord[]>(capacity_))
+        {}
+
+        SpscRing(const SpscRing&) = delete;
+        SpscRing& operator=(const SpscRing&) = delete;
+
+        // PRODUCER: slot at tail, or nullptr when the ring is full.
+        LogRecord* try_reserve() noexcept
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ == capacity_)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ == capacity_)
+                    return nullptr;
+            }
+            return &slots_[tail & mask_];
+        }
+
+        // PRODUCER: published slots the consumer has not handed back. Reads
+        // the consumer's index only when the cached one says `over` or more,
+        // so a check against a threshold stays off the shared line while
+        // the ring is below it.
+        std::size_t producer_size(std::size_t over) noexcept
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ >= over)
+                head_cache_ = head_.load(std::memory_order_acquire);
+            return tail - head_cache_;
+        }
+
+        // PRODUCER: publish the slot returned by try_reserve().
+        void commit() noexcept
+        {
+            tail_.store(tail_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+        }
+
+        // CONSUMER: oldest published slot, or nullptr when empty.
+        LogRecord* front() noexcept
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_cache_)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head == tail_cache_)
+                    return nullptr;
+            }
+            return &slots_[head & mask_];
+        }
+
+        // CONSUMER: hand the slot returned by front() back to the producer.
+        void pop() noexcept
+        {
+            head_.store(head_.load(std::memory_order_relaxed) + 1,
+                        std::memory_order_release);
+        }
+
+        bool empty() const noexcept
+        {
+            return head_.load(std::memory_order_acquire) ==
+                   tail_.load(std::memory_order_acquire);
+        }
+
+        std::size_t capacity() const noexcept { return capacity_; }
+
+    private:
+        static std::size_t round_up_pow2(std::size_t n) noexcept
+        {
+            std::size_t p = 1;
+            while (p < n)
+                p <<= 1;
+            return p;
+        }
+
+        const std::size_t capacity_;
+        const std::size_t mask_;
+        std::unique_ptr<LogRecord[]> slots_;
+
+        alignas(64) std::atomic<std::size_t> head_{0};
+        std::size_t tail_cache_{0};     // consumer-owned
+
+        alignas(64) std::atomic<std::size_t> tail_{0};
+        std::size_t head_cache_{0};     // producer-owned
+    };
+
+    // One producer's lane: the ring plus counters written only by the owning
+    // producer (plain load+store, no RMW), summed by readers on demand.
+    struct alignas(64) SpscLane : SpscRing
+    {
+        explicit SpscLane(std::size_t capacity) : SpscRing(capacity) {}
+
+        void count_enqueued() noexcept
+        {
+            enqueued.store(enqueued.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+        }
+
+        void count_dropped() noexcept
+        {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+        }
+
+        std::atomic<bool>     claimed{false};
+        std::atomic<uint64_t> enqueued{0};
+        std::atomic<uint64_t> dropped{0};
+        std::size_t           slot{0};      // registration index in the LaneSet
+
+        // DropOldest from this lane's producer; read by the consumer only
+        // for sheddable records, so kept off the counters' line.
+        alignas(64) ShedRequests shed;
+    };
+
+    // Fixed-capacity set of producer lanes.
+    //
+    // A producer thread claims a lane lazily on its first local() call and
+    // keeps it in a thread_local lease; the lease releases the lane when the
+    // thread exits so a later thread can reuse it (and whatever is still
+    // queued in it is drained normally). Registration takes a mutex — it is
+    // a once-per-thread cold path. The hot path is one thread_local read.
+    class LaneSet
+    {
+    public:
+        LaneSet(std::size_t max_lanes, std::size_t lane_capacity)
+            : max_lanes_(max_lanes)
+            , lane_capacity_(lane_capacity)
+            , id_(next_id())
+            , lanes_(std::make_unique<std::shared_ptr<SpscLane>[]>(max_lanes))
+            , published_(std::make_unique<std::atomic<SpscLane*>[]>(max_lanes))
+        {
+            for (std::size_t i = 0; i < max_lanes_; ++i)
+                published_[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        LaneSet(const LaneSet&) = delete;
+        LaneSet& operator=(const LaneSet&) = delete;
+
+        // PRODUCER: this thread's lane, or nullptr if every lane is taken.
+        SpscLane* local()
+        {
+            LaneLease& lease = lease_();
+            if (lease.owner == id_) [[likely]]
+                return lease.lane.get();
+
+            lease.reset();
+            lease.lane  = claim();
+            lease.owner = lease.lane ? id_ : 0;
+            return lease.lane.get();
+        }
+
+        // CONSUMER: visit up to `burst` records per lane, round-robin over
+        // the registered lanes first, first + stride, ... (all of them by
+        // default; several consumers split the set by stride). fn(LogRecord*)
+        // or fn(LogRecord*, SpscLane&) must finish with the record before
+        // returning — the slot is handed back right after.
+        template <typename Fn>
+        std::size_t drain(Fn&& fn, std::size_t burst,
+                          std::size_t first = 0, std::size_t stride = 1)
+        {
+            const std::size_t n = count_.load(std::memory_order_acquire);
+            std::size_t processed = 0;
+
+            for (std::size_t i = first; i < n; i += stride)
+            {
+                SpscLane* lane = published_[i].load(std::memory_order_acquire);
+                for (std::size_t k = 0; k < burst; ++k)
+                {
+                    LogRecord* rec = lane->front();
+                    if (!rec)
+                        break;
+                    if constexpr (std::is_invocable_v<Fn&, LogRecord*, SpscLane&>)
+                        fn(rec, *lane);
+                    else
+                        fn(rec);
+                    lane->pop();
+                    ++processed;
+                }
+            }
+            return processed;
+        }
+
+        bool empty(std::size_t first = 0, std::size_t stride = 1) const noexcept
+        {
+            const std::size_t n = count_.load(std::memory_order_acquire);
+            for (std::size_t i = first; i < n; i += stride)
+            {
+                if (!published_[i].load(std::memory_order_acquire)->empty())
+                    return false;
+            }
+            return true;
+        }
+
+        uint64_t enqueued() const noexcept { return sum(&SpscLane::enqueued); }
+        uint64_t dropped()  const noexcept { return sum(&SpscLane::dropped); }
+
+        std::size_t lane_count() const noexcept { return count_.load(std::memory_order_acquire); }
+        std::size_t max_lanes()  const noexcept { return max_lanes_; }
+
+    private:
+        struct LaneLease
+        {
+            std::uint64_t owner{0};
+            std::shared_ptr<SpscLane> lane;
+
+            void reset() noexcept
+            {
+                if (lane)
+                    lane->claimed.store(false, std::memory_order_release);
+                lane.reset();
+                owner = 0;
+            }
+
+            ~LaneLease() { reset(); }
+        };
+
+        static LaneLease& lease_() noexcept
+        {
+            static thread_local LaneLease lease;
+            return lease;
+        }
+
+        static std::uint64_t next_id() noexcept
+        {
+            static std::atomic<std::uint64_t> ids{0};
+            return ids.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        std::shared_ptr<SpscLane> claim()
+        {
+            std::lock_guard lock(register_mtx_);
+
+            const std::size_t n = count_.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                bool expected = false;
+                if (lanes_[i]->claimed.compare_exchange_strong(
+                        expected, true, std::memory_order_acquire))
+                    return lanes_[i];
+            }
+
+            if (n == max_lanes_)
+                return nullptr;
+
+            lanes_[n] = std::make_shared<SpscLane>(lane_capacity_);
+            lanes_[n]->slot = n;
+            lanes_[n]->claimed.store(true, std::memory_order_relaxed);
+            published_[n].store(lanes_[n].get(), std::memory_order_release);
+            count_.store(n + 1, std::memory_order_release);
+            return lanes_[n];
+        }
+
+        uint64_t sum(std::atomic<uint64_t> SpscLane::*counter) const noexcept
+        {
+            uint64_t total = 0;
+            const std::size_t n = count_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < n; ++i)
+                total += (published_[i].load(std::memory_order_acquire)->*counter)
+                             .load(std::memory_order_relaxed);
+            return total;
+        }
+
+        const std::size_t   max_lanes_;
+        const std::size_t   lane_capacity_;
+        const std::uint64_t id_;
+
+        std::mutex register_mtx_;
+        std::unique_ptr<std::shared_ptr<SpscLane>[]> lanes_;
+        std::unique_ptr<std::atomic<SpscLane*>[]>    published_;
+        std::atomic<std::size_t> count_{0};
+    };
+}
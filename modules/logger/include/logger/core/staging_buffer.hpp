@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace logger::core::detail
+{
+    // Worker-side batch of formatted records: the bytes of every record in
+    // one contiguous buffer plus one view per record, handed to the sink as
+    // a single publish_batch() call. Views stay valid until clear().
+    class StagingBuffer
+    {
+    public:
+        StagingBuffer() = default;
+
+        StagingBuffer(std::size_t bytes, std::size_t max_views)
+            : buf_(std::make_unique<char[]>(bytes))
+            , capacity_(bytes)
+            , max_views_(max_views ? max_views : 1)
+        {
+            views_.reserve(max_views_);
+        }
+
+        // Format one record through fmt(char* dst, size_t cap) -> size_t,
+        // giving it at most `limit` bytes. The caller checks has_room() first.
+        template <typename Format>
+        void append(Format&& fmt, std::size_t limit)
+        {
+            const std::size_t cap = limit < remaining() ? limit : remaining();
+            char* dst = buf_.get() + used_;
+            const std::size_t n = fmt(dst, cap);
+            views_.emplace_back(dst, n);
+            used_ += n;
+        }
+
+        // Room for another record of up to `bytes`?
+        bool has_room(std::size_t bytes) const noexcept
+        {
+            return views_.size() < max_views_ && remaining() >= bytes;
+        }
+
+        std::span<const std::string_view> views() const noexcept { return views_; }
+
+        bool        empty()     const noexcept { return views_.empty(); }
+        std::size_t bytes()     const noexcept { return used_; }
+        std::size_t remaining() const noexcept { return capacity_ - used_; }
+        std::size_t capacity()  const noexcept { return capacity_; }
+
+        void clear() noexcept
+        {
+            views_.clear();
+            used_ = 0;
+        }
+
+    private:
+        std::unique_ptr<char[]>       buf_;
+        std::size_t                   capacity_{0};
+        std::size_t                   used_{0};
+        std::size_t                   max_views_{1};
+        std::vector<std::string_view> views_;
+    };
+}
@@ -63,6 +63,24 @@ private:
     std::array<char, N> buf_{};
 };
 
+// streambuf over caller-owned memory, re-pointed per record. Like
+// FixedStringBuf, bytes past the end are dropped.
+struct SpanStringBuf : std::streambuf
+{
+    void reset(char* dst, std::size_t cap) { setp(dst, dst + cap); }
+
+    std::size_t written() const noexcept
+    {
+        return static_cast<std::size_t>(pptr() - pbase());
+    }
+
+private:
+    int_type overflow(int_type ch) override
+    {
+        return ch; // consume but discard
+    }
+};
+
 // ------------------------------------------------------------------
 // StreamAdapter
 //
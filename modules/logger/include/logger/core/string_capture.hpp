@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "logger/registry/payload_register.hpp"
+#include "spill_arena.hpp"
+
+// string_view fields of a registered payload point into the caller's
+// memory, which may be gone by the time the worker formats the record.
+// At enqueue every such field is copied next to the envelope, into the
+// unused tail of LogRecord::storage, or into a SpillArena block when the
+// tail is full, and the view is pointed at the copy. Envelopes outside
+// the schema are stored as they are and must own what they print.
+namespace logger::core::detail
+{
+    // Appended to a copy that was cut short.
+    inline constexpr std::string_view kTruncatedMark = "...";
+
+    namespace capture_detail
+    {
+        template <typename E, typename Ptr>
+        constexpr bool is_string_field =
+            std::is_same_v<std::remove_cvref_t<decltype(std::declval<E&>().*std::declval<Ptr>())>, std::string_view>;
+
+        template <typename E, typename Ptrs>
+        struct StringFieldCount;
+
+        template <typename E, typename... Ptrs>
+        struct StringFieldCount<E, std::tuple<Ptrs...>>
+        {
+            static constexpr std::size_t value = (std::size_t{0} + ... + (is_string_field<E, Ptrs> ? 1 : 0));
+        };
+    }
+
+    // Number of string_view fields in E's schema (0 outside the schema).
+    // Types derived from a payload (limit::Folded) count its fields.
+    template <typename E>
+    inline constexpr std::size_t kStringFields = 0;
+
+    template <registry::SchemaPayload E>
+    inline constexpr std::size_t kStringFields<E> = capture_detail::StringFieldCount<
+        E, std::remove_cvref_t<decltype(registry::PayloadRegister<E::type_id>::field_ptrs)>>::value;
+
+    // fn(std::string_view&) for each string_view field, in schema order.
+    template <registry::SchemaPayload E, typename Fn>
+    void for_each_string_field(E& obj, Fn&& fn)
+    {
+        std::apply([&](auto... ptr) {
+            ([&] {
+                if constexpr (capture_detail::is_string_field<E, decltype(ptr)>)
+                    fn(obj.*ptr);
+            }(), ...);
+        }, registry::PayloadRegister<E::type_id>::field_ptrs);
+    }
+
+    // Spill chunks holding an envelope's string copies; released with the
+    // record. Empty for envelopes without string fields.
+    template <std::size_t N>
+    struct CapturedStrings
+    {
+        SpillChunk* chunks[N]{};
+
+        ~CapturedStrings()
+        {
+            for (SpillChunk* c : chunks)
+                if (c)
+                    c->release();
+        }
+    };
+
+    template <>
+    struct CapturedStrings<0>
+    {
+    };
+
+    // Free bytes after the envelope in LogRecord::storage.
+    struct CaptureTail
+    {
+        char* next;
+        char* end;
+
+        std::size_t room() const noexcept { return static_cast<std::size_t>(end - next); }
+    };
+
+    struct CapturedString
+    {
+        std::string_view view;
+        SpillChunk*      chunk{nullptr};    // set when the copy was spilled
+        bool             truncated{false};
+    };
+
+    // Copies at most max_bytes of s, kTruncatedMark included when s is
+    // longer (only its first max_bytes when max_bytes < 3), into tail or else into a block from arena (may be null).
+    // With neither available it keeps what the tail still holds, marked
+    // as truncated. Never allocates outside the arena.
+    CapturedString capture_string(std::string_view s, std::size_t max_bytes,
+                                  CaptureTail& tail, SpillArena* arena) noexcept;
+
+    // Points every string_view field of env at its own copy. Returns the
+    // number of copies that were truncated.
+    template <registry::SchemaPayload E>
+    std::size_t capture_strings(E& env, CapturedStrings<kStringFields<E>>& held, CaptureTail tail,
+                                SpillArena* arena, std::size_t max_bytes) noexcept
+    {
+        std::size_t i = 0, truncated = 0;
+        for_each_string_field(env, [&](std::string_view& field) {
+            const CapturedString c = capture_string(field, max_bytes, tail, arena);
+            field = c.view;
+            held.chunks[i++] = c.chunk;
+            truncated += c.truncated;
+        });
+        return truncated;
+    }
+} // namespace logger::core::detail
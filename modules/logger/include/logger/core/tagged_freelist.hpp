@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "log_record.hpp"
+#include "lockfree_queue.hpp"
+
+namespace logger::core::detail
+{
+    // ABA-safe variant of FreeList for records living in one contiguous
+    // LogRecord[] pool.
+    //
+    // The head is a single 64-bit word: low 32 bits locate the top chain as
+    // (byte offset from the pool's first node + 1), 0 = empty; high 32 bits
+    // hold a generation bumped on every successful CAS. A byte offset rather
+    // than an element index keeps encode/decode to one add/sub — no scaling
+    // by sizeof(LogRecord) — which limits the pool to 4 GiB.
+    //
+    // A stale head that was popped and pushed back in the meantime carries a
+    // different generation, so the CAS fails instead of installing a dead
+    // `chain_next`. Only a plain 64-bit CAS is needed, which is lock-free on
+    // x86-64, AArch64 and ARMv7 alike.
+    //
+    // Remaining (theoretical) window: a thread stalled across exactly 2^32
+    // head updates. Links between nodes stay plain pointers; only the head
+    // is encoded.
+    class TaggedFreeList
+    {
+        static constexpr std::uint64_t kOffsetMask = 0xFFFF'FFFFull;
+
+        std::atomic<std::uint64_t> head_{0};
+        std::uintptr_t base_{0};     // address of the first pool FreeNode
+        std::uintptr_t limit_{0};    // one past the last
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "TaggedFreeList needs a lock-free 64-bit CAS");
+
+    public:
+        TaggedFreeList() = default;
+
+        TaggedFreeList(LogRecord* base, std::size_t count) noexcept
+        {
+            attach(base, count);
+        }
+
+        // Bind to the pool before the first push. Every node pushed later
+        // must come from [base, base + count).
+        void attach(LogRecord* base, std::size_t count) noexcept
+        {
+            assert(count * sizeof(LogRecord) < kOffsetMask && "pool too large for 32-bit offset");
+            base_  = reinterpret_cast<std::uintptr_t>(static_cast<FreeNode*>(base));
+            limit_ = base_ + count * sizeof(LogRecord);
+        }
+
+        void push(FreeNode* n) noexcept
+        {
+            n->free_next = nullptr;
+            push_chain(n);
+        }
+
+        void push_chain(FreeNode* first) noexcept
+        {
+            const std::uint64_t off = encode(first);
+            std::uint64_t h = head_.load(std::memory_order_relaxed);
+            do
+            {
+                first->chain_next = decode(h);
+            } while (!head_.compare_exchange_weak(h, bump(h, off),
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+        }
+
+        FreeNode* try_pop_chain() noexcept
+        {
+            std::uint64_t h = head_.load(std::memory_order_acquire);
+            while (FreeNode* top = decode(h))
+            {
+                FreeNode* next = top->chain_next;
+                if (head_.compare_exchange_weak(h, bump(h, encode(next)),
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire))
+                {
+                    return top;
+                }
+            }
+            return nullptr;
+        }
+
+        FreeNode* try_pop() noexcept
+        {
+            FreeNode* h = try_pop_chain();
+            if (h && h->free_next)
+            {
+                push_chain(h->free_next);
+                h->free_next = nullptr;
+            }
+            return h;
+        }
+
+        bool empty() const noexcept
+        {
+            return (head_.load(std::memory_order_acquire) & kOffsetMask) == 0;
+        }
+
+    private:
+        std::uint64_t encode(FreeNode* n) const noexcept
+        {
+            if (!n)
+                return 0;
+            const auto addr = reinterpret_cast<std::uintptr_t>(n);
+            assert(addr >= base_ && addr < limit_ && "node does not belong to the attached pool");
+            return static_cast<std::uint64_t>(addr - base_) + 1;
+        }
+
+        FreeNode* decode(std::uint64_t h) const noexcept
+        {
+            const std::uint64_t off = h & kOffsetMask;
+            return off ? reinterpret_cast<FreeNode*>(base_ + off - 1) : nullptr;
+        }
+
+        static std::uint64_t bump(std::uint64_t h, std::uint64_t off) noexcept
+        {
+            return ((h >> 32) + 1) << 32 | off;
+        }
+    };
+
+#if LOGGER_ABA_SAFE_FREELIST
+    using PoolFreeList = TaggedFreeList;
+#else
+    using PoolFreeList = FreeList;
+#endif
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace logger::core
+{
+    // What the LogEngine worker does when a drain pass finds nothing.
+    enum class WaitStrategy : std::uint8_t
+    {
+        Sleep,      // fixed sleep_for(WaitConfig::sleep) — the original behaviour
+        Spin,       // busy-wait with a pause hint; lowest latency, burns a core
+        Yield,      // std::this_thread::yield() between passes
+        Park,       // block on an atomic wait until a producer notifies
+        Adaptive    // spin, then yield, then park
+    };
+
+    struct WaitConfig
+    {
+        WaitStrategy strategy = WaitStrategy::Adaptive;
+
+        // Adaptive: empty passes spent in each phase before moving on.
+        std::size_t spin_rounds  = 256;
+        std::size_t yield_rounds = 32;
+
+        // Sleep: interval between polls.
+        std::chrono::microseconds sleep{50};
+    };
+
+    [[nodiscard]] constexpr const char* toString(WaitStrategy s) noexcept
+    {
+        switch (s)
+        {
+            case WaitStrategy::Sleep:    return "Sleep";
+            case WaitStrategy::Spin:     return "Spin";
+            case WaitStrategy::Yield:    return "Yield";
+            case WaitStrategy::Park:     return "Park";
+            case WaitStrategy::Adaptive: return "Adaptive";
+            default: return "UnknownWaitStrategy";
+        }
+    }
+} // namespace logger::core
+
+namespace logger::core::detail
+{
+    inline void cpu_relax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield" ::: "memory");
+#endif
+    }
+
+    // Worker-side idling plus the producer-side wake-up for Park/Adaptive.
+    //
+    // Lost-wakeup protocol (Dekker style, both sides fenced):
+    //   worker:   parked_ = 1; fence; if (has_work()) cancel; else wait(1)
+    //   producer: publish record; fence; if (parked_) wake
+    // The seq_cst fences guarantee at least one side sees the other's
+    // write, so a record published while the worker parks is never missed.
+    // Producers pay the fence only for strategies that can park, and the
+    // notify syscall only when the worker is actually parked.
+    //
+    // A park with a deadline (idle_until) waits on a condition variable
+    // instead, since atomic wait has no timeout; parked_ then holds kTimed
+    // and notify() wakes it through the mutex.
+    class WorkerWaiter
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        WorkerWaiter() = default;
+        explicit WorkerWaiter(const WaitConfig& cfg) noexcept { configure(cfg); }
+
+        void configure(const WaitConfig& cfg) noexcept
+        {
+            cfg_ = cfg;
+            can_park_ = cfg.strategy == WaitStrategy::Park ||
+                        cfg.strategy == WaitStrategy::Adaptive;
+        }
+
+        // WORKER: one idle step after an empty drain pass. has_work() must
+        // re-check every source the producers publish to.
+        template <typename HasWork>
+        void idle(HasWork&& has_work)
+        {
+            idle_until(clock::time_point::max(), has_work);
+        }
+
+        // WORKER: as idle(), but return by `deadline` even if no producer
+        // notifies — for work that comes due on its own (a flush interval,
+        // a held record). Sleep polls no longer than cfg.sleep either way.
+        template <typename HasWork>
+        void idle_until(clock::time_point deadline, HasWork&& has_work)
+        {
+            const bool timed = deadline != clock::time_point::max();
+            const std::size_t round = rounds_++;
+
+            switch (cfg_.strategy)
+            {
+                case WaitStrategy::Sleep:
+                    if (timed)
+                    {
+                        const auto now = clock::now();
+                        if (deadline > now)
+                            std::this_thread::sleep_for(std::min<clock::duration>(deadline - now, cfg_.sleep));
+                    }
+                    else
+                        std::this_thread::sleep_for(cfg_.sleep);
+                    return;
+                case WaitStrategy::Spin:
+                    cpu_relax();
+                    return;
+                case WaitStrategy::Yield:
+                    std::this_thread::yield();
+                    return;
+                case WaitStrategy::Park:
+                    timed ? park_until(has_work, deadline) : park(has_work);
+                    return;
+                case WaitStrategy::Adaptive:
+                    if (round < cfg_.spin_rounds)
+                        cpu_relax();
+                    else if (round < cfg_.spin_rounds + cfg_.yield_rounds)
+                        std::this_thread::yield();
+                    else
+                        timed ? park_until(has_work, deadline) : park(has_work);
+                    return;
+            }
+        }
+
+        // WORKER: a drain pass made progress — restart the backoff.
+        void reset() noexcept { rounds_ = 0; }
+
+        // PRODUCER: call after publishing a record.
+        void notify() noexcept
+        {
+            if (!can_park_)
+                return;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!parked_.load(std::memory_order_relaxed))
+                return;
+            const std::uint32_t was = parked_.exchange(0, std::memory_order_relaxed);
+            if (!was)
+                return;
+            if (was == kTimed)
+            {
+                { std::lock_guard lock(mtx_); }
+                cv_.notify_one();
+            }
+            else
+                parked_.notify_one();
+            wakeups_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Shutdown: unconditionally release a parked worker.
+        void wake_all() noexcept
+        {
+            parked_.store(0, std::memory_order_seq_cst);
+            parked_.notify_all();
+            { std::lock_guard lock(mtx_); }
+            cv_.notify_all();
+        }
+
+        uint64_t parks()   const noexcept { return parks_.load(std::memory_order_relaxed); }
+        uint64_t wakeups() const noexcept { return wakeups_.load(std::memory_order_relaxed); }
+        const WaitConfig& config() const noexcept { return cfg_; }
+
+    private:
+        template <typename HasWork>
+        void park(HasWork& has_work)
+        {
+            parked_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (has_work())
+            {
+                parked_.store(0, std::memory_order_relaxed);
+                return;
+            }
+
+            parks_.fetch_add(1, std::memory_order_relaxed);
+            parked_.wait(1, std::memory_order_acquire);
+            parked_.store(0, std::memory_order_relaxed);
+        }
+
+        // The same handshake under mtx_: a producer that clears parked_
+        // takes the mutex before notifying, so it cannot slip in between
+        // the predicate check and the wait.
+        template <typename HasWork>
+        void park_until(HasWork& has_work, clock::time_point deadline)
+        {
+            std::unique_lock lock(mtx_);
+            parked_.store(kTimed, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (has_work())
+            {
+                parked_.store(0, std::memory_order_relaxed);
+                return;
+            }
+
+            parks_.fetch_add(1, std::memory_order_relaxed);
+            cv_.wait_until(lock, deadline, [this] { return parked_.load(std::memory_order_acquire) == 0; });
+            parked_.store(0, std::memory_order_relaxed);
+        }
+
+        static constexpr std::uint32_t kTimed = 2;
+
+        WaitConfig  cfg_{};
+        bool        can_park_{true};
+        std::size_t rounds_{0};     // worker-only
+
+        alignas(64) std::atomic<std::uint32_t> parked_{0};   // 1 atomic wait, kTimed cv_
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::atomic<uint64_t> parks_{0};
+        std::atomic<uint64_t> wakeups_{0};
+    };
+} // namespace logger::core::detail
@@ -0,0 +1,75 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/log_ids.hpp"
+#include "common/messages/payloads/payloads.hpp"
+
+// Which Handler::log calls exist at all. Set from CMake (LOGGER_MIN_SEVERITY,
+// LOGGER_DISABLED_CLASSES, LOGGER_DISABLED_METHODS on the logger target),
+// so every includer sees the same values:
+//   LOGGER_MIN_SEVERITY       a Severity name; anything below compiles out
+//   LOGGER_DISABLED_CLASSES   LogClassId names from log_classes.def
+//   LOGGER_DISABLED_METHODS   MethodId names (Class_Method) from log_ids.def
+#ifndef LOGGER_MIN_SEVERITY
+#define LOGGER_MIN_SEVERITY Info
+#endif
+#ifndef LOGGER_DISABLED_CLASSES
+#define LOGGER_DISABLED_CLASSES
+#endif
+#ifndef LOGGER_DISABLED_METHODS
+#define LOGGER_DISABLED_METHODS
+#endif
+
+namespace logger::filter
+{
+    inline constexpr Severity kMinSeverity = Severity::LOGGER_MIN_SEVERITY;
+
+    inline constexpr auto kClassCompiled = [] {
+        std::array<bool, static_cast<std::size_t>(LogClassId::Count)> on{};
+        on.fill(true);
+        using enum LogClassId;
+        for (const LogClassId c : {Count, LOGGER_DISABLED_CLASSES})
+            if (c != Count)
+                on[static_cast<std::size_t>(c)] = false;
+        return on;
+    }();
+
+    inline constexpr auto kMethodCompiled = [] {
+        std::array<bool, static_cast<std::size_t>(MethodId::Count)> on{};
+        on.fill(true);
+        using enum MethodId;
+        for (const MethodId m : {Count, LOGGER_DISABLED_METHODS})
+            if (m != Count)
+                on[static_cast<std::size_t>(m)] = false;
+        return on;
+    }();
+
+    // False: the call site compiles to nothing.
+    template <Severity S, LogClassId C, MethodId M>
+    inline constexpr bool compiled_in = S >= kMinSeverity &&
+                                        kClassCompiled[static_cast<std::size_t>(C)] &&
+                                        kMethodCompiled[static_cast<std::size_t>(M)];
+
+    // Runtime switch per class on top of the build settings; every class
+    // starts enabled. One relaxed load per call site that is compiled in.
+    static_assert(static_cast<std::size_t>(LogClassId::Count) <= 64, "class mask is 64 bits");
+
+    inline std::atomic<std::uint64_t> g_class_mask{~std::uint64_t{0}};
+
+    inline bool class_enabled(LogClassId c) noexcept
+    {
+        return (g_class_mask.load(std::memory_order_relaxed) >> static_cast<unsigned>(c)) & 1u;
+    }
+
+    inline void set_class_enabled(LogClassId c, bool on) noexcept
+    {
+        const std::uint64_t bit = std::uint64_t{1} << static_cast<unsigned>(c);
+        if (on)
+            g_class_mask.fetch_or(bit, std::memory_order_relaxed);
+        else
+            g_class_mask.fetch_and(~bit, std::memory_order_relaxed);
+    }
+} // namespace logger::filter
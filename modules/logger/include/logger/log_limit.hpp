@@ -0,0 +1,107 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "common/messages/payloads/field_writer.hpp"
+
+// Per-call-site sampling and rate limiting for LOGGER_LOG_EVERY_N and
+// LOGGER_LOG_RATE (logger.hpp). Each macro expansion owns its state as
+// static locals, so a call site is keyed by where it is in the source. A
+// suppressed call never builds a payload or touches the LogEngine; the
+// number of calls it skipped rides along with the next record the site
+// emits, as suppressed=N (Folded).
+namespace logger::limit
+{
+    // 1 in N calls, counted per thread: the suppressed path is a
+    // decrement of a thread_local, nothing shared.
+    template <std::uint64_t N>
+    struct EveryN
+    {
+        static_assert(N > 0, "EveryN<0>");
+
+        std::uint64_t countdown{0};
+        std::uint64_t skipped{0};
+
+        // True for the first call and every Nth after it; `folded` is set
+        // to the calls skipped on this thread since the last one.
+        bool admit(std::uint64_t& folded) noexcept
+        {
+            if (countdown) [[likely]]
+            {
+                --countdown;
+                ++skipped;
+                return false;
+            }
+            countdown = N - 1;
+            folded    = skipped;
+            skipped   = 0;
+            return true;
+        }
+    };
+
+    // Token bucket of Burst records refilled at PerSecond, shared by every
+    // thread through one atomic (GCRA: the time the bucket would be full
+    // again). The suppressed path is a load and a compare; only admitted
+    // calls write.
+    template <std::uint64_t PerSecond, std::uint64_t Burst = 1>
+    class RateLimit
+    {
+        static_assert(PerSecond > 0 && PerSecond <= 1'000'000'000, "RateLimit: 1..1e9 per second");
+        static_assert(Burst > 0, "RateLimit: Burst > 0");
+
+    public:
+        static constexpr std::uint64_t kIntervalNs = 1'000'000'000ull / PerSecond;
+        static constexpr std::uint64_t kWindowNs   = kIntervalNs * Burst;
+
+        // now_ns: any monotonic nanosecond clock (LogClock in the macro).
+        bool admit(std::uint64_t now_ns) noexcept
+        {
+            std::uint64_t tat = tat_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const std::uint64_t next = std::max(tat, now_ns) + kIntervalNs;
+                if (next - now_ns > kWindowNs)
+                    return false;
+                if (tat_.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+                    return true;
+            }
+        }
+
+    private:
+        std::atomic<std::uint64_t> tat_{0};
+    };
+
+    // A payload with the calls its site skipped before it. Text prints the
+    // payload's own fields, then suppressed=N; the codecs write the
+    // payload's frame or object with suppressed added (FoldedPayload).
+    // Only records that follow skipped calls take this form.
+    template <typename Payload>
+    struct Folded : Payload
+    {
+        using folded_payload = Payload;
+
+        std::uint64_t suppressed{0};
+
+        std::size_t format_to(char* dst, std::size_t cap) const
+        {
+            FieldWriter w{dst, cap};
+            if constexpr (requires(const Payload& p) { p.format_impl(w); })
+                Payload::format_impl(w);
+            else
+                Payload::format_header(w);
+            w.put("suppressed=");
+            w.put(suppressed);
+            w.put(' ');
+            return w.size();
+        }
+
+        void debug_print(std::ostream& os) const
+        {
+            Payload::debug_print(os);
+            os << "suppressed=" << suppressed << ' ';
+        }
+    };
+} // namespace logger::limit
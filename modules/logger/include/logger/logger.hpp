@@ -1,8 +1,14 @@
 #pragma once
+#include <cstdint>
+
+#include "common/log_ids.hpp"
 #include "common/messages/log_message.hpp"
+#include "logger/log_filter.hpp"
+#include "logger/log_limit.hpp"
 #include "logger/registry/builder.hpp"
 #include "logger/registry/header_args.hpp"
 #include "publisher/publisher.hpp"
+#include "logger/core/log_clock.hpp"
 #include "logger/core/log_engine.hpp"
 
 namespace logger
@@ -14,23 +20,124 @@ namespace logger
         typename Engine = core::detail::LogEngine,
         typename... Args>
         static void log(Args &&...args)
+        {
+            log<Tag, core::Overflow::DropNewest, Engine>(std::forward<Args>(args)...);
+        }
+
+        // Same, with an explicit overflow policy for this call site:
+        // Handler::log<MsgTag::Generic, core::Overflow::Block>(...)
+        template <MsgTag Tag,
+        core::Overflow Policy,
+        typename Engine = core::detail::LogEngine,
+        typename... Args>
+        static void log(Args &&...args)
         {
 
-            // 1) Args -> tuple with header fields
-            auto header_tuple =
-                registry::pack_header_args(std::forward<Args>(args)...);
+            auto& engine = Engine::instance();
 
-            // 2) tuple -> payload (constructed by the registry::Builder)
-            auto payload = registry::Builder::build<Tag>(header_tuple);
+            // LogEngine: the fields go straight into the record's payload.
+            if constexpr (requires { engine.template emplace<Tag, Policy>(std::forward<Args>(args)...); })
+            {
+                engine.template emplace<Tag, Policy>(std::forward<Args>(args)...);
+            }
+            else
+            {
+                // 1) Args -> tuple with header fields
+                auto header_tuple =
+                    registry::pack_header_args(std::forward<Args>(args)...);
+
+                // 2) tuple -> payload (constructed by the registry::Builder)
+                auto payload = registry::Builder::build<Tag>(header_tuple);
+
+                // 3) payload -> MPSC queue
+                engine.template enqueue<Policy>(std::move(payload));
+            }
+        }
+
+        // Severity, class and method fixed at the call site; the rest of
+        // the header (timestamp, thread_id, request_id, schema_version)
+        // and the body follow as usual. Calls filtered out at build time
+        // (log_filter.hpp) compile to nothing; a class switched off at
+        // runtime returns before the payload is built. LOGGER_LOG also
+        // skips evaluating the arguments.
+        template <MsgTag Tag, Severity Sev, LogClassId Class, MethodId Method,
+        core::Overflow Policy = core::Overflow::DropNewest,
+        typename Engine = core::detail::LogEngine,
+        typename Timestamp, typename ThreadId, typename RequestId, typename Schema,
+        typename... Body>
+        static void log(Timestamp &&timestamp, ThreadId &&thread_id, RequestId &&request_id,
+                        Schema &&schema_version, Body &&...body)
+        {
+            if constexpr (filter::compiled_in<Sev, Class, Method>)
+            {
+                if (!filter::class_enabled(Class))
+                    return;
+                log<Tag, Policy, Engine>(Sev,
+                                         std::forward<Timestamp>(timestamp),
+                                         std::forward<ThreadId>(thread_id),
+                                         std::forward<RequestId>(request_id),
+                                         static_cast<std::uint16_t>(Class),
+                                         static_cast<std::uint16_t>(Method),
+                                         std::forward<Schema>(schema_version),
+                                         std::forward<Body>(body)...);
+            }
+        }
 
-            // 3) payload -> packet -> MPSC queue
-            // auto packet = make_log_packet(std::move(payload));
-            // core().enqueue(std::move(packet));
-             auto& engine = Engine::instance();
-            engine.enqueue(std::move(payload));
+        // The record a LOGGER_LOG_EVERY_N / LOGGER_LOG_RATE site lets
+        // through, after `suppressed` skipped calls; a nonzero count goes
+        // with it as limit::Folded. The macro has already applied the
+        // filters.
+        template <MsgTag Tag, Severity Sev, LogClassId Class, MethodId Method,
+        core::Overflow Policy = core::Overflow::DropNewest,
+        typename Engine = core::detail::LogEngine,
+        typename Timestamp, typename ThreadId, typename RequestId, typename Schema,
+        typename... Body>
+        static void log_sampled(std::uint64_t suppressed,
+                                Timestamp &&timestamp, ThreadId &&thread_id, RequestId &&request_id,
+                                Schema &&schema_version, Body &&...body)
+        {
+            log_folded<Tag, Policy, Engine>(suppressed,
+                                            Sev,
+                                            std::forward<Timestamp>(timestamp),
+                                            std::forward<ThreadId>(thread_id),
+                                            std::forward<RequestId>(request_id),
+                                            static_cast<std::uint16_t>(Class),
+                                            static_cast<std::uint16_t>(Method),
+                                            std::forward<Schema>(schema_version),
+                                            std::forward<Body>(body)...);
         }
 
     private:
+        template <MsgTag Tag, core::Overflow Policy, typename Engine, typename... Args>
+        static void log_folded(std::uint64_t suppressed, Args &&...args)
+        {
+            using Envelope = limit::Folded<typename registry::PayloadRegister<Tag>::payload_type>;
+
+            auto& engine = Engine::instance();
+
+            // LogEngine: built in the record like log(); suppressed is set
+            // there too.
+            if constexpr (requires { engine.template emplace<Tag, Policy>(std::forward<Args>(args)...); })
+            {
+                if (suppressed == 0)
+                    engine.template emplace<Tag, Policy>(std::forward<Args>(args)...);
+                else
+                    engine.template emplace_as<Tag, Envelope, Policy>(
+                        [suppressed](Envelope &env) { env.suppressed = suppressed; },
+                        std::forward<Args>(args)...);
+            }
+            else
+            {
+                auto header_tuple = registry::pack_header_args(std::forward<Args>(args)...);
+                auto payload = registry::Builder::build<Tag>(header_tuple);
+
+                if (suppressed == 0)
+                    engine.template enqueue<Policy>(std::move(payload));
+                else
+                    engine.template enqueue<Policy>(Envelope{std::move(payload), suppressed});
+            }
+        }
+
         // static LogCore& core(); // access to the shared logging core and its queue
     };
 
@@ -52,3 +159,77 @@ namespace logger
     };
 
 } // namespace logger
+
+// Handler::log<Tag, Severity::SEV, LogClassId::CLASS, MethodId::CLASS_METHOD>
+// with the filters checked before any argument is evaluated:
+//   LOGGER_LOG(Generic, Warn, Handler, Run, now_us(), tid, rid, std::uint16_t{1});
+#define LOGGER_LOG_TO(ENGINE, TAG, SEV, CLASS, METHOD, ...)                                     \
+    do                                                                                          \
+    {                                                                                           \
+        if constexpr (::logger::filter::compiled_in<::Severity::SEV, ::LogClassId::CLASS,       \
+                                                    ::MethodId::CLASS##_##METHOD>)              \
+        {                                                                                       \
+            if (::logger::filter::class_enabled(::LogClassId::CLASS))                           \
+                ::logger::Handler::log<::MsgTag::TAG, ::Severity::SEV, ::LogClassId::CLASS,     \
+                                       ::MethodId::CLASS##_##METHOD,                            \
+                                       ::logger::core::Overflow::DropNewest, ENGINE>(__VA_ARGS__); \
+        }                                                                                       \
+    } while (0)
+
+#define LOGGER_LOG(TAG, SEV, CLASS, METHOD, ...) \
+    LOGGER_LOG_TO(::logger::core::detail::LogEngine, TAG, SEV, CLASS, METHOD, __VA_ARGS__)
+
+// LOGGER_LOG for the first call and every Nth after it, counted per
+// thread; the next record carries suppressed=<calls skipped>.
+//   LOGGER_LOG_EVERY_N(1000, Generic, Info, Handler, handlingEvent, ts, tid, rid, schema);
+#define LOGGER_LOG_EVERY_N_TO(ENGINE, N, TAG, SEV, CLASS, METHOD, ...)                          \
+    do                                                                                          \
+    {                                                                                           \
+        if constexpr (::logger::filter::compiled_in<::Severity::SEV, ::LogClassId::CLASS,       \
+                                                    ::MethodId::CLASS##_##METHOD>)              \
+        {                                                                                       \
+            static thread_local constinit ::logger::limit::EveryN<(N)> logger_site_;            \
+            std::uint64_t logger_skipped_ = 0;                                                  \
+            if (::logger::filter::class_enabled(::LogClassId::CLASS) &&                         \
+                logger_site_.admit(logger_skipped_))                                            \
+                ::logger::Handler::log_sampled<::MsgTag::TAG, ::Severity::SEV,                  \
+                                               ::LogClassId::CLASS, ::MethodId::CLASS##_##METHOD, \
+                                               ::logger::core::Overflow::DropNewest, ENGINE>(   \
+                    logger_skipped_, __VA_ARGS__);                                              \
+        }                                                                                       \
+    } while (0)
+
+#define LOGGER_LOG_EVERY_N(N, TAG, SEV, CLASS, METHOD, ...) \
+    LOGGER_LOG_EVERY_N_TO(::logger::core::detail::LogEngine, N, TAG, SEV, CLASS, METHOD, __VA_ARGS__)
+
+// LOGGER_LOG at most BURST records at once and PER_SEC per second from
+// this call site, across all threads; the calls a thread had suppressed
+// ride along with its next record as suppressed=<count>.
+//   LOGGER_LOG_RATE(100, 10, Generic, Warn, Handler, handlingEvent, ts, tid, rid, schema);
+#define LOGGER_LOG_RATE_TO(ENGINE, PER_SEC, BURST, TAG, SEV, CLASS, METHOD, ...)                \
+    do                                                                                          \
+    {                                                                                           \
+        if constexpr (::logger::filter::compiled_in<::Severity::SEV, ::LogClassId::CLASS,       \
+                                                    ::MethodId::CLASS##_##METHOD>)              \
+        {                                                                                       \
+            static constinit ::logger::limit::RateLimit<(PER_SEC), (BURST)> logger_site_;       \
+            static thread_local constinit std::uint64_t logger_suppressed_ = 0;                 \
+            if (::logger::filter::class_enabled(::LogClassId::CLASS))                           \
+            {                                                                                   \
+                if (logger_site_.admit(::logger::core::LogClock::instance().now_ns()))          \
+                {                                                                               \
+                    const std::uint64_t logger_skipped_ = logger_suppressed_;                   \
+                    logger_suppressed_ = 0;                                                     \
+                    ::logger::Handler::log_sampled<::MsgTag::TAG, ::Severity::SEV,              \
+                                                   ::LogClassId::CLASS, ::MethodId::CLASS##_##METHOD, \
+                                                   ::logger::core::Overflow::DropNewest, ENGINE>( \
+                        logger_skipped_, __VA_ARGS__);                                          \
+                }                                                                               \
+                else                                                                            \
+                    ++logger_suppressed_;                                                       \
+            }                                                                                   \
+        }                                                                                       \
+    } while (0)
+
+#define LOGGER_LOG_RATE(PER_SEC, BURST, TAG, SEV, CLASS, METHOD, ...) \
+    LOGGER_LOG_RATE_TO(::logger::core::detail::LogEngine, PER_SEC, BURST, TAG, SEV, CLASS, METHOD, __VA_ARGS__)
@@ -27,10 +27,17 @@ struct Builder {
         );
 
         P payload{};
-        assign_fields(payload, Reg::field_ptrs, std::forward<Tuple>(args_tuple));
+        assign<Tag>(payload, std::forward<Tuple>(args_tuple));
         return payload;
     }
 
+    // Same fields, same checks, assigned to a payload that already exists
+    // (LogEngine::emplace builds it in the record it is written from).
+    template<MsgTag Tag, typename Tuple>
+    static void assign(typename PayloadRegister<Tag>::payload_type& payload, Tuple&& args_tuple) {
+        assign_fields(payload, PayloadRegister<Tag>::field_ptrs, std::forward<Tuple>(args_tuple));
+    }
+
 private:
     template<typename P, typename TuplePtrs, typename TupleArgs,
              std::size_t... Is>
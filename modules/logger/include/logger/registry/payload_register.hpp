@@ -1,6 +1,9 @@
 #pragma once
 
+#include <concepts>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <iostream>
 #include <string_view>
@@ -23,6 +26,11 @@ namespace logger::registry
         {
             print_header(os);
         }
+
+        void format_impl(FieldWriter &w) const
+        {
+            format_header(w);
+        }
     };
 
     template <>
@@ -42,6 +50,13 @@ namespace logger::registry
         static constexpr auto field_ptrs = std::tuple{
 #define X(C, F) &base_type::F,
 #include "common/messages/payloads/log_payloads.def"
+#undef X
+        };
+
+        // Field names, same order as field_ptrs.
+        static constexpr std::string_view field_names[] = {
+#define X(C, F) #F,
+#include "common/messages/payloads/log_payloads.def"
 #undef X
         };
     };
@@ -59,6 +74,11 @@ namespace logger::registry
         {
             print_header(os);
         }
+
+        void format_impl(FieldWriter &w) const
+        {
+            format_header(w);
+        }
     };
 
     template <>
@@ -89,8 +109,106 @@ namespace logger::registry
 // request-specific fields
 #define X(C, F) &payload_type::F,
 #include "common/messages/payloads/log_requestpayload.def"
+#undef X
+        };
+
+        // Field names, same order as field_ptrs.
+        static constexpr std::string_view field_names[] = {
+#define X(C, F) #F,
+#include "common/messages/payloads/log_payloads.def"
+#undef X
+#define X(C, F) #F,
+#include "common/messages/payloads/log_requestpayload.def"
+#undef X
+        };
+    };
+
+    // ---------- Repeat ----------
+
+    // Written by the logger's coalescing stage in place of records it
+    // dropped as repeats: the header of the last one dropped, how many,
+    // and when the first was.
+    struct alignas(64) RepeatPayload
+        : PayloadBase<MsgTag::Repeat, RepeatPayload>
+    {
+#define X(C, F) C F;
+#include "common/messages/payloads/log_repeatpayload.def"
+#undef X
+
+        void debug_impl(std::ostream &os) const
+        {
+            print_header(os);
+#define X(C, F) os << #F << '=' << +F << ' ';
+#include "common/messages/payloads/log_repeatpayload.def"
+#undef X
+        }
+
+        void format_impl(FieldWriter &w) const
+        {
+            format_header(w);
+#define X(C, F) w.put(#F "="); w.put(F); w.put(' ');
+#include "common/messages/payloads/log_repeatpayload.def"
+#undef X
+        }
+    };
+
+    template <>
+    struct PayloadRegister<MsgTag::Repeat>
+    {
+        using payload_type = RepeatPayload;
+        using base_type = PayloadBase<MsgTag::Repeat, RepeatPayload>;
+
+        using args_tuple_type = decltype(std::tuple{
+#define X(C, F) std::declval<C>(),
+#include "common/messages/payloads/log_payloads.def"
+#undef X
+#define X(C, F) std::declval<C>(),
+#include "common/messages/payloads/log_repeatpayload.def"
+#undef X
+        });
+
+        static constexpr auto field_ptrs = std::tuple{
+#define X(C, F) &base_type::F,
+#include "common/messages/payloads/log_payloads.def"
+#undef X
+#define X(C, F) &payload_type::F,
+#include "common/messages/payloads/log_repeatpayload.def"
+#undef X
+        };
+
+        static constexpr std::string_view field_names[] = {
+#define X(C, F) #F,
+#include "common/messages/payloads/log_payloads.def"
+#undef X
+#define X(C, F) #F,
+#include "common/messages/payloads/log_repeatpayload.def"
 #undef X
         };
     };
 
+    // Payload types with a PayloadRegister entry: their fields are known at
+    // compile time (binary and JSON codecs).
+    template <typename E>
+    concept RegisteredPayload = requires {
+        { E::type_id } -> std::convertible_to<MsgTag>;
+        typename PayloadRegister<E::type_id>::payload_type;
+    } && std::is_same_v<E, typename PayloadRegister<E::type_id>::payload_type>;
+
+    // A registered payload or a type built on one (limit::Folded): the
+    // schema's fields are there.
+    template <typename E>
+    concept SchemaPayload = requires {
+        { E::type_id } -> std::convertible_to<MsgTag>;
+        typename PayloadRegister<E::type_id>::payload_type;
+    } && std::is_base_of_v<typename PayloadRegister<E::type_id>::payload_type, E>;
+
+    // A registered payload followed by the calls its site skipped
+    // (limit::Folded). The codecs write the payload's fields, then
+    // suppressed.
+    template <typename E>
+    concept FoldedPayload = requires(const E &e) {
+        typename E::folded_payload;
+        { e.suppressed } -> std::convertible_to<std::uint64_t>;
+    } && RegisteredPayload<typename E::folded_payload> && std::is_base_of_v<typename E::folded_payload, E>;
+
 } // namespace logger::registry
@@ -0,0 +1,151 @@
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include "logger/core/log_clock.hpp"
+
+namespace logger::core
+{
+
+namespace
+{
+    std::uint64_t clock_ns(clockid_t id) noexcept
+    {
+        timespec ts{};
+        ::clock_gettime(id, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+
+    // CPUID 0x80000007 EDX bit 8: the TSC ticks at a constant rate in every
+    // P- and C-state and is synchronised across cores.
+    bool invariant_tsc() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+            return false;
+        if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+            return false;
+        return (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    std::uint64_t ticks() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct Sample
+    {
+        std::uint64_t tsc;
+        std::uint64_t mono;
+    };
+
+    // A (TSC, CLOCK_MONOTONIC) pair: the tightest of a few brackets, so a
+    // preemption between the reads does not skew the scale.
+    Sample sample() noexcept
+    {
+        Sample best{};
+        std::uint64_t best_gap = ~std::uint64_t{0};
+        for (int i = 0; i < 8; ++i)
+        {
+            const std::uint64_t t0 = ticks();
+            const std::uint64_t mono = clock_ns(CLOCK_MONOTONIC);
+            const std::uint64_t t1 = ticks();
+            if (t1 - t0 < best_gap)
+            {
+                best_gap = t1 - t0;
+                best = {t0 + (t1 - t0) / 2, mono};
+            }
+        }
+        return best;
+    }
+
+}
+
+std::uint64_t LogClock::mult_of(std::uint64_t ns, std::uint64_t ticks) noexcept
+{
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 uint128;
+    return static_cast<std::uint64_t>((static_cast<uint128>(ns) << 32) / ticks);
+#else
+    return detail::shl32_div(ns, ticks);
+#endif
+}
+
+LogClock::LogClock(Source source) noexcept
+{
+    const std::uint64_t mono = clock_ns(CLOCK_MONOTONIC);
+    const std::uint64_t real = clock_ns(CLOCK_REALTIME);
+    epoch_offset_ = real > mono ? real - mono : 0;
+
+    tsc_ = source != Source::Coarse && invariant_tsc();
+    if (!tsc_)
+        return;
+
+    const Sample a = sample();
+    Sample b = a;
+    while (b.mono - a.mono < 1'000'000)
+        b = sample();
+    if (b.tsc <= a.tsc)
+    {
+        tsc_ = false;
+        return;
+    }
+
+    start_tsc_  = a.tsc;
+    start_mono_ = a.mono;
+    base_tsc_.store(b.tsc, std::memory_order_relaxed);
+    base_ns_.store(epoch_offset_ + b.mono, std::memory_order_relaxed);
+    mult_.store(mult_of(b.mono - a.mono, b.tsc - a.tsc), std::memory_order_relaxed);
+}
+
+LogClock& LogClock::instance() noexcept
+{
+    static LogClock clock;
+    return clock;
+}
+
+double LogClock::tsc_hz() const noexcept
+{
+    const std::uint64_t mult = mult_.load(std::memory_order_relaxed);
+    return tsc_ && mult ? 1e9 * 4294967296.0 / static_cast<double>(mult) : 0.0;
+}
+
+void LogClock::recalibrate() noexcept
+{
+    if (!tsc_)
+        return;
+
+    const Sample now = sample();
+    if (now.tsc <= start_tsc_)
+        return;
+
+    const std::uint64_t base_tsc = base_tsc_.load(std::memory_order_relaxed);
+    const std::uint64_t current  = now.tsc > base_tsc
+        ? base_ns_.load(std::memory_order_relaxed) + scaled(now.tsc - base_tsc, mult_.load(std::memory_order_relaxed))
+        : base_ns_.load(std::memory_order_relaxed);
+
+    // Converge on CLOCK_MONOTONIC, except that a clock running ahead is
+    // held where it is rather than stepped back.
+    const std::uint64_t base_ns = std::max(epoch_offset_ + now.mono, current);
+    const std::uint64_t mult    = mult_of(now.mono - start_mono_, now.tsc - start_tsc_);
+
+    const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+    seq_.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    base_tsc_.store(now.tsc, std::memory_order_relaxed);
+    base_ns_.store(base_ns, std::memory_order_relaxed);
+    mult_.store(mult, std::memory_order_relaxed);
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+} // namespace logger::core
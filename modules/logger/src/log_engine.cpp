@@ -1,5 +1,9 @@
-#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "logger/core/log_engine.hpp"
 
@@ -29,8 +33,9 @@ publisher::runtime::OutputResourceStore& LogEngine::store() noexcept
 }
 
 LogEngine::LogEngine()
-    : publishHandle_(registry())
 {
+    for (std::size_t k = 0; k < kMaxWorkers; ++k)
+        shards_[k].index = k;
 }
 
 LogEngine& LogEngine::instance() noexcept
@@ -44,89 +49,592 @@ void LogEngine::shutdown() noexcept
     stop_worker();
 }
 
-void LogEngine::ensure_running()
+uint64_t LogEngine::parks() const noexcept
 {
-    bool expected = false;
-    if (run_.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+    uint64_t total = 0;
+    for (const Shard& s : shards_)
+        total += s.waiter.parks();
+    return total;
+}
+
+uint64_t LogEngine::file_dropped() const noexcept
+{
+    uint64_t total = 0;
+    for (const Shard& s : shards_)
+        total += s.async_file.dropped();
+    return total;
+}
+
+ReorderStats LogEngine::reorder_stats() const noexcept
+{
+    ReorderStats total;
+    for (const Shard& s : shards_)
+    {
+        const ReorderStats r = s.reorder.stats();
+        total.released      += r.released;
+        total.late          += r.late;
+        total.forced        += r.forced;
+        total.hold_ns_total += r.hold_ns_total;
+        total.hold_ns_max    = std::max(total.hold_ns_max, r.hold_ns_max);
+    }
+    return total;
+}
+
+CoalesceStats LogEngine::coalesce_stats() const noexcept
+{
+    CoalesceStats total;
+    for (const Shard& s : shards_)
+    {
+        const CoalesceStats c = s.coalesce.stats();
+        total.suppressed += c.suppressed;
+        total.summaries  += c.summaries;
+        total.evicted    += c.evicted;
+    }
+    return total;
+}
+
+namespace
+{
+    // Worker 0 writes to the configured path, worker k to path.w<k>.
+    std::string shard_path(const std::string& path, std::size_t k)
+    {
+        return k == 0 ? path : path + ".w" + std::to_string(k);
+    }
+}
+
+bool LogEngine::configure(const EngineConfig& cfg)
+{
+    std::lock_guard lock(lifecycle_mtx_);
+    if (run_.load(std::memory_order_acquire) || arena_.capacity())
+        return false;
+
+    // Whatever an earlier configure() opened goes first, so a change of
+    // format does not leave its file or socket behind. On failure nothing
+    // stays open, and the files this call created are removed.
+    for (Shard& s : shards_)
+        close_sinks(s);
+
+    const std::size_t workers = std::clamp<std::size_t>(cfg.workers, 1, kMaxWorkers);
+    std::vector<std::string> created;
+    for (std::size_t k = 0; k < workers; ++k)
+    {
+        if (!open_sinks(shards_[k], cfg, created))
+        {
+            for (std::size_t j = 0; j <= k; ++j)
+                close_sinks(shards_[j]);
+            std::error_code ec;
+            for (const std::string& path : created)
+                std::filesystem::remove(path, ec);
+            return false;
+        }
+    }
+
+    cfg_ = cfg;
+    workers_ = workers;
+    binary_ = cfg.sink_format == SinkFormat::Binary;
+    async_  = binary_ && cfg.binary_backend == FileBackend::IoUring;
+    socket_ = cfg.sink_format == SinkFormat::Socket || cfg.sink_format == SinkFormat::JsonSocket;
+    json_   = cfg.sink_format == SinkFormat::Json || cfg.sink_format == SinkFormat::JsonSocket ||
+              cfg.sink_format == SinkFormat::JsonFile;
+    file_   = (binary_ && !async_) || cfg.sink_format == SinkFormat::TextFile ||
+              cfg.sink_format == SinkFormat::JsonFile;
+    ring_   = !cfg.crash_ring.path.empty();
+    reorder_ns_ = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(cfg.ordering.reorder_window).count());
+    stamp_  = cfg.ordering.stamp || reorder_ns_ != 0;
+    coalesce_ns_ = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(cfg.coalesce.window).count());
+    spill_.configure(cfg.spill);
+    return true;
+}
+
+// Binary output goes to its own file; fail here rather than on the first
+// enqueue if it cannot be opened. Each worker gets its own sink objects.
+// Paths that did not exist before are added to `created`.
+bool LogEngine::open_sinks(Shard& shard, const EngineConfig& cfg, std::vector<std::string>& created)
+{
+    const auto idx = registry().resolve(shard.handle.token());
+    const auto note_new = [&created](const std::string& path) {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec))
+            created.push_back(path);
+    };
+
+    if (cfg.sink_format == SinkFormat::Binary)
+    {
+        const codec::FileHeader header{};
+        const std::string header_bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (cfg.binary_backend == FileBackend::IoUring)
+        {
+            publisher::runtime::AsyncFileConfig file;
+            file.path   = shard_path(cfg.binary_file.path, shard.index);
+            file.header = header_bytes;
+            note_new(file.path);
+            if (!shard.async_file.open(std::move(file)))
+                return false;
+            store().async_files[idx].writer = &shard.async_file;
+        }
+        else
+        {
+            publisher::runtime::FileSinkConfig file = cfg.binary_file;
+            file.path   = shard_path(cfg.binary_file.path, shard.index);
+            file.header = header_bytes;
+            note_new(file.path);
+            if (!shard.file.open(std::move(file)))
+                return false;
+            store().files[idx].writer = &shard.file;
+        }
+    }
+    else if (cfg.sink_format == SinkFormat::TextFile || cfg.sink_format == SinkFormat::JsonFile)
+    {
+        publisher::runtime::FileSinkConfig file = cfg.text_file;
+        file.path = shard_path(cfg.text_file.path, shard.index);
+        file.header.clear();
+        note_new(file.path);
+        if (!shard.file.open(std::move(file)))
+            return false;
+        store().files[idx].writer = &shard.file;
+    }
+    else if (cfg.sink_format == SinkFormat::Socket || cfg.sink_format == SinkFormat::JsonSocket)
+    {
+        // The collector need not be up yet; only a bad address fails.
+        if (!shard.collector.open(cfg.collector))
+            return false;
+        store().sockets[idx].sink = &shard.collector;
+    }
+
+    if (!cfg.crash_ring.path.empty())
     {
-        init_pool_and_queue();
-        worker_ = std::thread(&LogEngine::worker_loop, this);
+        publisher::runtime::MmapRingConfig ring = cfg.crash_ring;
+        ring.path    = shard_path(cfg.crash_ring.path, shard.index);
+        ring.content = cfg.sink_format == SinkFormat::Binary ? publisher::runtime::RingContent::Binary
+                                                             : publisher::runtime::RingContent::Text;
+        note_new(ring.path);
+        if (!shard.crash_ring.open(std::move(ring)))
+            return false;
+        store().mmap_rings[idx].ring = &shard.crash_ring;
     }
+    return true;
+}
+
+// Undo open_sinks(): close every sink object of the shard and unhook it
+// from the store. Only while no worker runs.
+void LogEngine::close_sinks(Shard& shard) noexcept
+{
+    const auto idx = registry().resolve(shard.handle.token());
+    store().files[idx].writer       = nullptr;
+    store().async_files[idx].writer = nullptr;
+    store().sockets[idx].sink       = nullptr;
+    store().mmap_rings[idx].ring    = nullptr;
+    shard.file.close();
+    shard.async_file.close();
+    shard.collector.close();
+    shard.crash_ring.close();
+}
+
+void LogEngine::start_worker()
+{
+    std::lock_guard lock(lifecycle_mtx_);
+    if (run_.load(std::memory_order_relaxed))
+        return;
+
+    init_pool_and_queue();
+    LogClock::instance();       // calibrate here, not on the first stamp
+    run_.store(true, std::memory_order_release);
+    for (std::size_t k = 0; k < workers_; ++k)
+        shards_[k].thread = std::thread(&LogEngine::worker_loop, this, std::ref(shards_[k]));
 }
 
 void LogEngine::init_pool_and_queue()
 {
-    pool_size_    = 1024;
-    pool_storage_ = std::make_unique<LogRecord[]>(pool_size_);
+    // The pool survives shutdown(): on restart every record is already back
+    // on the freelist, so there is nothing to rebuild.
+    if (arena_.capacity())
+        return;
+
+    // Address space for every slab the pool may grow to is reserved up
+    // front, so all records share one range and the freelist never moves.
+    const std::size_t pool_size = cfg_.pool_size ? cfg_.pool_size : 1;
+    arena_.reserve(pool_size + cfg_.max_pool_slabs * cfg_.pool_slab_size);
+    freelist_.attach(arena_.base(), arena_.reserved());
+
+    // With magazines on, seed the freelist in magazine-sized chains so the
+    // first refills are single CASes too.
+    const std::size_t chain = cfg_.magazine_size ? cfg_.magazine_size : 1;
+    for (Shard& s : shards_)
+        s.recycle = RecycleBatch<PoolFreeList>{chain};
+
+    LogRecord* first = arena_.commit(pool_size);
+    if (!first)
+        throw std::bad_alloc{};
+    seed_freelist(first, pool_size);
+
+    if (cfg_.queue_mode == QueueMode::SpscLanes)
+        lanes_ = std::make_unique<LaneSet>(cfg_.max_lanes, cfg_.lane_capacity);
+
+    if (cfg_.batch_records == 0)
+        cfg_.batch_records = 1;
+    for (std::size_t k = 0; k < workers_; ++k)
+    {
+        shards_[k].staging = StagingBuffer{std::max(cfg_.staging_bytes, kMaxRecordBytes), cfg_.batch_records};
+        shards_[k].waiter.configure(cfg_.wait);
+        if (reorder_ns_)
+            shards_[k].reorder = ReorderBuffer{std::max(cfg_.ordering.reorder_bytes, 4 * kMaxRecordBytes),
+                                               cfg_.ordering.reorder_records};
+        if (coalesce_ns_)
+            shards_[k].coalesce = Coalescer{coalesce_ns_, cfg_.coalesce.keys};
+    }
+    backpressure_.configure(cfg_.overflow);
+}
+
+// Goes through worker 0's recycle batch: called before the workers start
+// and, for growth, only by worker 0.
+void LogEngine::seed_freelist(LogRecord* first, std::size_t count)
+{
+    RecycleBatch<PoolFreeList>& batch = shards_[0].recycle;
+    for (std::size_t i = 0; i < count; ++i)
+        batch.add(first + i, freelist_);
+    batch.flush(freelist_);
+}
 
-    for (std::size_t i = 0; i < pool_size_; ++i)
-        freelist_.push(&pool_storage_[i]);
+// Worker 0: enough enqueues have found the pool empty since the last slab,
+// whether they were dropped or are waiting (Block, DropOldest, Error under
+// BySeverity), and there is a slab left to add.
+bool LogEngine::growth_due() const noexcept
+{
+    return cfg_.max_pool_slabs && arena_.slabs() <= cfg_.max_pool_slabs &&
+           pool_misses_.load(std::memory_order_relaxed) - misses_at_last_slab_ >= cfg_.grow_after_drops;
+}
+
+// Worker 0: add a slab once growth_due(); producers waiting for a record
+// get one from it straight away.
+void LogEngine::maybe_grow_pool()
+{
+    if (!growth_due())
+        return;
+
+    misses_at_last_slab_ = pool_misses_.load(std::memory_order_relaxed);
+    if (LogRecord* first = arena_.commit(cfg_.pool_slab_size))
+    {
+        seed_freelist(first, cfg_.pool_slab_size);
+        backpressure_.notify_freed();
+    }
 }
 
 LogRecord* LogEngine::acquire_record()
 {
+    if (cfg_.magazine_size)
+    {
+        // LogEngine is a singleton, so one magazine per thread is enough.
+        static thread_local RecordMagazine<PoolFreeList> magazine{cfg_.magazine_size};
+        return magazine.acquire(freelist_);
+    }
+
     FreeNode* node = freelist_.try_pop();
     return node ? static_cast<LogRecord*>(node) : nullptr;
 }
 
-void LogEngine::push_to_queue(LogRecord* rec)
+void LogEngine::recycle(Shard& shard, LogRecord* rec)
 {
-    queue_.push(rec);
+    shard.recycle.add(rec, freelist_);
 }
 
-void LogEngine::worker_loop()
+// A pending DropOldest request discards the record instead of writing it,
+// if it was itself enqueued under DropOldest: the worker always holds the
+// oldest such record it has not yet written, and records from other
+// policies are never shed. `shed` holds the requests for where the record
+// came from: its lane's, or the pool's for the MPSC queue. So does a
+// coalescing window the record repeats.
+void LogEngine::process(Shard& shard, LogRecord* rec, ShedRequests& shed)
 {
-    using namespace std::chrono_literals;
-
-    LogRecord* pending_recycle = nullptr;
+    if (rec->sheddable && shed.pending() && shed.take()) [[unlikely]]
+    {
+        rec->destroy_fn(rec->storage_ptr());
+        backpressure_.count_shed_oldest();
+        return;
+    }
 
-    while (run_.load(std::memory_order_acquire) || !queue_.empty())
+    if (coalesce_ns_ && rec->key_fn)
     {
-        MpscNode* node = queue_.pop();
-        if (!node)
+        registry::RepeatPayload header{};
+        const std::uint64_t key = rec->key_fn(rec->storage_ptr(), header);
+        if (shard.coalesce.absorb(key, header, shard.pass_start,
+                                  [this, &shard](const registry::RepeatPayload& r) { write_repeat(shard, r); }))
         {
-            std::this_thread::sleep_for(50us);
-            continue;
+            rec->destroy_fn(rec->storage_ptr());
+            return;
         }
-        LogRecord* rec = static_cast<LogRecord*>(node);
+    }
 
-        if (pending_recycle)
-            freelist_.push(pending_recycle);
+    write(shard, [rec](char* dst, std::size_t cap) {
+        return rec->format_fn(rec->storage_ptr(), dst, cap);
+    }, StampKey{rec->stamp, rec->producer, rec->seq});
 
-        rec->submit_fn(rec->storage_ptr());
-        rec->destroy_fn(rec->storage_ptr());
-        written_.fetch_add(1, std::memory_order_relaxed);
+    rec->destroy_fn(rec->storage_ptr());
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
 
-        pending_recycle = rec;
+// Format one record through the reorder window, or straight into the
+// staging buffer.
+template <typename Format>
+void LogEngine::write(Shard& shard, Format&& format, const StampKey& key)
+{
+    if (reorder_ns_)
+    {
+        auto emit = [this, &shard](std::string_view v) { stage(shard, v); };
+        while (!shard.reorder.has_room(kMaxRecordBytes))
+            shard.reorder.release_oldest(shard.pass_start, emit);
+        shard.reorder.append(key, shard.pass_start, format, kMaxRecordBytes);
+    }
+    else
+    {
+        if (!shard.staging.has_room(kMaxRecordBytes))
+            flush_staging(shard);
+        shard.staging.append(format, kMaxRecordBytes);
     }
+}
+
+// A closed coalescing window that dropped records, in the sink's format.
+// Not counted in written(); see coalesce_stats().
+void LogEngine::write_repeat(Shard& shard, const registry::RepeatPayload& summary)
+{
+    using Stored = StoredEnvelope<registry::RepeatPayload>;
+    Stored obj{summary};
+    const LogRecord::FormatFn fn = binary_ ? &encode_impl<Stored> : json_ ? &json_impl<Stored> : &format_impl<Stored>;
+    write(shard, [&obj, fn](char* dst, std::size_t cap) { return fn(&obj, dst, cap); },
+          StampKey{shard.pass_start, 0, 0});
+}
+
+// A record the reorder window let go, copied into the staging buffer.
+void LogEngine::stage(Shard& shard, std::string_view formatted)
+{
+    if (!shard.staging.has_room(formatted.size()))
+        flush_staging(shard);
 
-    MpscNode* node = nullptr;
-    while ((node = queue_.pop()) != nullptr)
+    shard.staging.append([formatted](char* dst, std::size_t cap) {
+        const std::size_t n = std::min(formatted.size(), cap);
+        std::memcpy(dst, formatted.data(), n);
+        return n;
+    }, formatted.size());
+}
+
+// Stage every held record whose window is up, in stamp order.
+void LogEngine::release_due(Shard& shard)
+{
+    const std::uint64_t now = stamp_now();
+    const std::uint64_t cutoff = now > reorder_ns_ ? now - reorder_ns_ : 0;
+    shard.reorder.release(cutoff, now, [this, &shard](std::string_view v) { stage(shard, v); });
+}
+
+// Everything formatted since the last flush goes to the sink in one call,
+// through this worker's channel.
+void LogEngine::flush_staging(Shard& shard)
+{
+    if (shard.staging.empty())
+        return;
+
+    using publisher::core::SinkKind;
+    using publisher::runtime::PublisherRuntime;
+
+    const auto token = shard.handle.token();
+    const auto views = shard.staging.views();
+
+    if (async_)
+        PublisherRuntime<SinkKind::AsyncFile>::publish_batch(registry(), store(), token, views);
+    else if (file_)
+        PublisherRuntime<SinkKind::File>::publish_batch(registry(), store(), token, views);
+    else if (socket_)
+        PublisherRuntime<SinkKind::Socket>::publish_batch(registry(), store(), token, views);
+    else
+        PublisherRuntime<SinkKind::Terminal>::publish_batch(registry(), store(), token, views);
+
+    if (ring_)
+        PublisherRuntime<SinkKind::MmapRing>::publish_batch(registry(), store(), token, views);
+    shard.staging.clear();
+}
+
+// Idle-time upkeep of the sinks. The buffered file flushes once its
+// flush_interval is up (and rotates by age), not on every quiet pass;
+// stop_worker() flushes the rest. For io_uring this reaps finished writes.
+// The collector gets another try at whatever its socket did not take, or,
+// with nothing queued, a check for a closed peer.
+void LogEngine::flush_sinks(Shard& shard) noexcept
+{
+    if (async_)
+        shard.async_file.flush();
+    else if (file_)
+        shard.file.tick(publisher::runtime::RotatingFile::clock::now());
+    else if (socket_)
+        shard.collector.pump();
+}
+
+// One pass over every source of this worker: up to lane_burst records from
+// each of its producer lanes (round-robin), then up to batch_records from
+// its MPSC queue. Whatever the pass formatted is written as one batch.
+std::size_t LogEngine::drain_once(Shard& shard, LogRecord*& pending_recycle)
+{
+    std::size_t processed = 0;
+    if (reorder_ns_ || coalesce_ns_)
+        shard.pass_start = stamp_now();
+
+    if (lanes_)
+        processed += lanes_->drain([this, &shard](LogRecord* rec, SpscLane& lane) { process(shard, rec, lane.shed); },
+                                   cfg_.lane_burst, shard.index, workers_);
+
+    std::size_t from_pool = 0;
+    for (; from_pool < cfg_.batch_records; ++from_pool)
     {
+        MpscNode* node = shard.queue.pop();
+        if (!node)
+            break;
         LogRecord* rec = static_cast<LogRecord*>(node);
-        if (pending_recycle)
-            freelist_.push(pending_recycle);
 
-        rec->submit_fn(rec->storage_ptr());
-        rec->destroy_fn(rec->storage_ptr());
-        written_.fetch_add(1, std::memory_order_relaxed);
+        // The last popped node stays in the queue as its dummy head, so it
+        // is recycled one step late.
+        if (pending_recycle)
+            recycle(shard, pending_recycle);
 
+        process(shard, rec, backpressure_.shed());
         pending_recycle = rec;
     }
 
-    queue_.reset();
+    if (from_pool)
+    {
+        if (workers_ == 1)
+            pool_released_.store(pool_released_.load(std::memory_order_relaxed) + from_pool,
+                                 std::memory_order_relaxed);
+        else
+            pool_released_.fetch_add(from_pool, std::memory_order_relaxed);
+    }
+
+    if (coalesce_ns_)
+        shard.coalesce.expire(shard.pass_start,
+                              [this, &shard](const registry::RepeatPayload& r) { write_repeat(shard, r); });
+    if (reorder_ns_)
+        release_due(shard);
+    flush_staging(shard);
+    return processed + from_pool;
+}
+
+// Re-checked by the waiter after announcing a park; a stop request counts
+// as work so shutdown never sleeps through, and so does a slab worker 0
+// owes the pool.
+bool LogEngine::has_work(const Shard& shard) const noexcept
+{
+    return !run_.load(std::memory_order_acquire) || !shard.queue.empty() ||
+           (lanes_ && !lanes_->empty(shard.index, workers_)) ||
+           (shard.index == 0 && growth_due());
+}
+
+// When an idle worker has to run again with no producer to wake it; max()
+// if nothing is due. Bytes the file sink holds come due at its
+// flush_interval, repeats to report when their coalescing window closes,
+// held records when the oldest one's reorder window does.
+WorkerWaiter::clock::time_point LogEngine::idle_deadline(const Shard& shard) const noexcept
+{
+    using clock = WorkerWaiter::clock;
+    auto deadline = clock::time_point::max();
+    if (file_ && shard.file.buffered())
+        deadline = std::min(deadline, shard.file.flush_due());
+
+    // Stamp-clock deadlines, moved onto the waiter's clock.
+    const auto at_stamp = [now = clock::now(), stamp = stamp_now()](std::uint64_t due) {
+        return now + std::chrono::nanoseconds(due > stamp ? due - stamp : 0);
+    };
+    if (shard.coalesce.pending())
+        deadline = std::min(deadline, at_stamp(shard.coalesce.next_due()));
+    if (!shard.reorder.empty())
+        deadline = std::min(deadline, at_stamp(shard.reorder.oldest_stamp() + reorder_ns_));
+    return deadline;
+}
+
+void LogEngine::worker_loop(Shard& shard)
+{
+    LogRecord* pending_recycle = nullptr;
+    const bool grows = cfg_.max_pool_slabs && shard.index == 0;
+    std::uint64_t recalibrate_at = 0;
+
+    while (run_.load(std::memory_order_acquire) || !shard.queue.empty() ||
+           (lanes_ && !lanes_->empty(shard.index, workers_)))
+    {
+        if (grows)
+            maybe_grow_pool();
+
+        // Worker 0 refines the TSC scale about once a second.
+        if (shard.index == 0 && LogClock::instance().uses_tsc())
+        {
+            LogClock& clock = LogClock::instance();
+            const std::uint64_t now = clock.now_ns();
+            if (now >= recalibrate_at)
+            {
+                if (recalibrate_at)
+                    clock.recalibrate();
+                recalibrate_at = now + 1'000'000'000ull;
+            }
+        }
+
+        if (drain_once(shard, pending_recycle) != 0)
+        {
+            shard.waiter.reset();
+
+            // Producers blocked on an empty pool: hand records back now
+            // rather than when the recycle batch fills.
+            if (backpressure_.waiters())
+            {
+                shard.recycle.flush(freelist_);
+                backpressure_.notify_freed();
+            }
+            continue;
+        }
+
+        shard.recycle.flush(freelist_);
+        flush_sinks(shard);
+
+        shard.waiter.idle_until(idle_deadline(shard), [this, &shard] { return has_work(shard); });
+    }
+
+    while (drain_once(shard, pending_recycle) != 0)
+    {
+    }
+
+    shard.pass_start = stamp_now();
+    shard.coalesce.expire_all([this, &shard](const registry::RepeatPayload& r) { write_repeat(shard, r); });
+    if (!shard.reorder.empty())
+        shard.reorder.release_all(shard.pass_start, [this, &shard](std::string_view v) { stage(shard, v); });
+    flush_staging(shard);
+
+    shard.queue.reset();
     if (pending_recycle)
-        freelist_.push(pending_recycle);
+        recycle(shard, pending_recycle);
+    shard.recycle.flush(freelist_);
 }
 
 void LogEngine::stop_worker() noexcept
 {
+    std::lock_guard lock(lifecycle_mtx_);
     bool expected = true;
-    if (run_.compare_exchange_strong(expected, false, std::memory_order_acq_rel))
+    if (run_.compare_exchange_strong(expected, false, std::memory_order_seq_cst))
     {
-        if (worker_.joinable())
-            worker_.join();
+        for (std::size_t k = 0; k < workers_; ++k)
+            shards_[k].waiter.wake_all();
+
+        for (std::size_t k = 0; k < workers_; ++k)
+        {
+            Shard& s = shards_[k];
+            if (s.thread.joinable())
+                s.thread.join();
+            if (async_)
+            {
+                s.async_file.flush();   // the partly filled buffer kick() held back
+                s.async_file.drain();
+            }
+            else if (file_)
+                s.file.flush();
+            else if (socket_)
+                s.collector.drain(cfg_.collector.linger);
+        }
     }
 }
 
-} // namespace logger::core::detail
\ No newline at end of file
+} // namespace logger::core::detail
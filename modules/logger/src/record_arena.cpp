@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "logger/core/record_arena.hpp"
+
+namespace logger::core::detail
+{
+
+namespace
+{
+    constexpr std::size_t kHugePage = std::size_t{2} << 20;
+
+    std::uintptr_t round_down(std::uintptr_t v, std::size_t a) noexcept { return v & ~(a - 1); }
+    std::uintptr_t round_up(std::uintptr_t v, std::size_t a) noexcept   { return (v + a - 1) & ~(a - 1); }
+}
+
+RecordArena::~RecordArena()
+{
+    // LogRecord is trivially destructible; unmapping is enough.
+    if (mapping_)
+        ::munmap(mapping_, mapping_bytes_);
+}
+
+void RecordArena::reserve(std::size_t max_records)
+{
+    if (mapping_)
+        return;
+
+    // Over-map by one huge page so the usable range can start 2 MiB aligned.
+    const std::size_t bytes = round_up(max_records * sizeof(LogRecord), kHugePage);
+    mapping_bytes_ = bytes + kHugePage;
+
+    void* p = ::mmap(nullptr, mapping_bytes_, PROT_NONE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        mapping_bytes_ = 0;
+        throw std::bad_alloc{};
+    }
+
+    mapping_  = p;
+    base_     = reinterpret_cast<LogRecord*>(round_up(reinterpret_cast<std::uintptr_t>(p), kHugePage));
+    reserved_ = max_records;
+}
+
+LogRecord* RecordArena::commit(std::size_t count) noexcept
+{
+    const std::size_t used = capacity_.load(std::memory_order_relaxed);
+    if (count == 0 || used + count > reserved_)
+        return nullptr;
+
+    LogRecord* first = base_ + used;
+
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = round_down(reinterpret_cast<std::uintptr_t>(first), page);
+    const auto end   = round_up(reinterpret_cast<std::uintptr_t>(first + count), page);
+    void* const range = reinterpret_cast<void*>(begin);
+
+    if (::mprotect(range, end - begin, PROT_READ | PROT_WRITE) != 0)
+        return nullptr;
+
+#ifdef MADV_HUGEPAGE
+    const bool huge = ::madvise(range, end - begin, MADV_HUGEPAGE) == 0;
+    huge_pages_ = slabs_.load(std::memory_order_relaxed) == 0 ? huge : (huge_pages_ && huge);
+#endif
+
+    // Constructing every record also faults the pages in, so the cost of
+    // growth is paid here on the worker and not on a producer's first use.
+    for (std::size_t i = 0; i < count; ++i)
+        new (first + i) LogRecord{};
+
+    capacity_.store(used + count, std::memory_order_relaxed);
+    slabs_.fetch_add(1, std::memory_order_relaxed);
+    return first;
+}
+
+} // namespace logger::core::detail
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <new>
+
+#include "logger/core/spill_arena.hpp"
+
+namespace logger::core::detail
+{
+
+namespace
+{
+    constexpr std::align_val_t kChunkAlign{alignof(SpillChunk)};
+
+    void free_chunk(SpillChunk* c) noexcept
+    {
+        c->~SpillChunk();
+        ::operator delete(static_cast<void*>(c), kChunkAlign);
+    }
+}
+
+// Chunks still out at this point belong to threads that outlive the pool;
+// those are left alone.
+SpillPool::~SpillPool()
+{
+    while (free_)
+    {
+        SpillChunk* next = free_->next;
+        free_chunk(free_);
+        free_ = next;
+    }
+}
+
+void SpillPool::configure(const SpillConfig& cfg) noexcept
+{
+    chunk_bytes_ = std::max<std::size_t>(cfg.chunk_bytes, 4096);
+    max_bytes_   = cfg.max_bytes;
+}
+
+SpillChunk* SpillPool::allocate(std::size_t bytes) noexcept
+{
+    const std::size_t total = sizeof(SpillChunk) + bytes;
+    uint64_t held = held_.load(std::memory_order_relaxed);
+    do
+    {
+        if (held + total > max_bytes_)
+            return nullptr;
+    } while (!held_.compare_exchange_weak(held, held + total, std::memory_order_relaxed));
+
+    void* mem = ::operator new(total, kChunkAlign, std::nothrow);
+    if (!mem)
+    {
+        held_.fetch_sub(total, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint64_t peak = peak_.load(std::memory_order_relaxed);
+    while (held + total > peak &&
+           !peak_.compare_exchange_weak(peak, held + total, std::memory_order_relaxed))
+    {
+    }
+    chunks_.fetch_add(1, std::memory_order_relaxed);
+
+    auto* c  = new (mem) SpillChunk{};
+    c->pool  = this;
+    c->bytes = bytes;
+    return c;
+}
+
+SpillChunk* SpillPool::take() noexcept
+{
+    SpillChunk* c = nullptr;
+    {
+        std::lock_guard lock(mtx_);
+        if (free_)
+        {
+            c = free_;
+            free_ = c->next;
+        }
+    }
+
+    if (!c)
+        c = allocate(chunk_bytes_);
+    if (c)
+    {
+        c->next = nullptr;
+        c->refs.store(SpillChunk::kOpen, std::memory_order_relaxed);
+    }
+    return c;
+}
+
+SpillChunk* SpillPool::take_dedicated(std::size_t bytes) noexcept
+{
+    SpillChunk* c = allocate(bytes);
+    if (c)
+        c->refs.store(1, std::memory_order_relaxed);
+    return c;
+}
+
+void SpillPool::recycle(SpillChunk* c) noexcept
+{
+    if (c->bytes != chunk_bytes_)
+    {
+        held_.fetch_sub(sizeof(SpillChunk) + c->bytes, std::memory_order_relaxed);
+        free_chunk(c);
+        return;
+    }
+
+    std::lock_guard lock(mtx_);
+    c->next = free_;
+    free_ = c;
+}
+
+SpillStats SpillPool::stats() const noexcept
+{
+    SpillStats s;
+    {
+        std::lock_guard lock(tally_->mtx);
+        s.spilled       = tally_->spilled;
+        s.spilled_bytes = tally_->spilled_bytes;
+        for (const SpillArena* a = tally_->live; a; a = a->next_)
+        {
+            s.spilled       += a->spilled_.load(std::memory_order_relaxed);
+            s.spilled_bytes += a->spilled_bytes_.load(std::memory_order_relaxed);
+        }
+    }
+    s.failed        = failed_.load(std::memory_order_relaxed);
+    s.chunks        = chunks_.load(std::memory_order_relaxed);
+    s.held_bytes    = held_.load(std::memory_order_relaxed);
+    s.peak_bytes    = peak_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace logger::core::detail
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstring>
+
+#include "logger/codec/json_codec.hpp"
+#include "logger/core/string_capture.hpp"
+
+namespace logger::core::detail
+{
+
+namespace
+{
+    // kTruncatedMark, cut to `room` bytes when it does not fit whole.
+    std::string_view mark_within(std::size_t room) noexcept
+    {
+        return kTruncatedMark.substr(0, std::min(room, kTruncatedMark.size()));
+    }
+
+    // Longest prefix of s that leaves room for the mark in `room` bytes.
+    std::size_t kept_before_mark(std::string_view s, std::size_t room) noexcept
+    {
+        if (room <= kTruncatedMark.size())
+            return 0;
+        return codec::detail::clip_utf8(s, room - kTruncatedMark.size()).size();
+    }
+}
+
+CapturedString capture_string(std::string_view s, std::size_t max_bytes,
+                              CaptureTail& tail, SpillArena* arena) noexcept
+{
+    if (s.empty())
+        return {};
+
+    bool cut = s.size() > max_bytes;
+    std::string_view mark = cut ? mark_within(max_bytes) : std::string_view{};
+    std::size_t keep = cut ? kept_before_mark(s, max_bytes) : s.size();
+    std::size_t need = keep + mark.size();
+
+    char* dst = nullptr;
+    SpillChunk* chunk = nullptr;
+    if (need <= tail.room())
+    {
+        dst = tail.next;
+        tail.next += need;
+    }
+    else if (const SpillBlock block = arena ? arena->allocate(need, 1) : SpillBlock{})
+    {
+        dst   = static_cast<char*>(block.ptr);
+        chunk = block.chunk;
+    }
+    else
+    {
+        // Spill pool at max_bytes (or no arena): what fits inline.
+        if (tail.room() < kTruncatedMark.size())
+            return {mark_within(max_bytes), nullptr, true};
+        cut  = true;
+        mark = kTruncatedMark;
+        keep = kept_before_mark(s, tail.room());
+        need = keep + mark.size();
+        dst  = tail.next;
+        tail.next += need;
+    }
+
+    std::memcpy(dst, s.data(), keep);
+    std::memcpy(dst + keep, mark.data(), mark.size());
+    return {std::string_view{dst, need}, chunk, cut};
+}
+
+} // namespace logger::core::detail
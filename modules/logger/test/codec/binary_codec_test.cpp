@@ -0,0 +1,313 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "logger/codec/binary_codec.hpp"
+
+namespace codec = logger::codec;
+using logger::registry::GenericPayload;
+using logger::registry::RequestPayload;
+
+namespace {
+    GenericPayload make_generic() {
+        GenericPayload p{};
+        p.severity       = Severity::Warn;
+        p.timestamp      = 123456789;
+        p.thread_id      = 7;
+        p.request_id     = 42;
+        p.class_id       = 3;
+        p.method_id      = 4;
+        p.schema_version = 1;
+        return p;
+    }
+
+    RequestPayload make_request(std::string_view path) {
+        RequestPayload p{};
+        p.severity       = Severity::Error;
+        p.timestamp      = 99;
+        p.thread_id      = 1;
+        p.request_id     = 2;
+        p.class_id       = 5;
+        p.method_id      = 6;
+        p.schema_version = 2;
+        p.req_unique_id  = 0xDEADBEEF;
+        p.path           = path;
+        return p;
+    }
+
+    std::string make_file(std::initializer_list<std::string_view> frames) {
+        const codec::FileHeader h{};
+        std::string out(reinterpret_cast<const char*>(&h), sizeof(h));
+        for (auto f : frames)
+            out.append(f);
+        return out;
+    }
+}
+
+TEST(BinaryCodec, GenericRoundTrip) {
+    const auto in = make_generic();
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    ASSERT_GT(n, codec::kFramePrefix);
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Ok);
+    EXPECT_TRUE(view.empty());
+    EXPECT_EQ(frame.tag, MsgTag::Generic);
+    EXPECT_EQ(frame.schema_version, 1u);
+
+    bool seen = false;
+    auto st = codec::visit_frame(frame, [&](const auto& out) {
+        using T = std::decay_t<decltype(out)>;
+        ASSERT_TRUE((std::is_same_v<T, GenericPayload>));
+        if constexpr (std::is_same_v<T, GenericPayload>) {
+            EXPECT_EQ(out.severity, in.severity);
+            EXPECT_EQ(out.timestamp, in.timestamp);
+            EXPECT_EQ(out.thread_id, in.thread_id);
+            EXPECT_EQ(out.request_id, in.request_id);
+            EXPECT_EQ(out.class_id, in.class_id);
+            EXPECT_EQ(out.method_id, in.method_id);
+        }
+        seen = true;
+    });
+    EXPECT_EQ(st, codec::DecodeStatus::Ok);
+    EXPECT_TRUE(seen);
+}
+
+TEST(BinaryCodec, RequestRoundTripKeepsString) {
+    const auto in = make_request("/api/v1/items");
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Ok);
+
+    std::string path;
+    uint64_t uid = 0;
+    codec::visit_frame(frame, [&](const auto& out) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(out)>, RequestPayload>) {
+            path = std::string(out.path);
+            uid  = out.req_unique_id;
+        }
+    });
+    EXPECT_EQ(path, "/api/v1/items");
+    EXPECT_EQ(uid, 0xDEADBEEFu);
+}
+
+TEST(BinaryCodec, FrameIsSmallerThanText) {
+    const auto in = make_request("/x");
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+
+    std::ostringstream os;
+    os << in;
+    EXPECT_LT(n, os.str().size());
+}
+
+TEST(BinaryCodec, LongStringIsTruncatedToCapacity) {
+    const std::string longpath(500, 'p');
+    const auto in = make_request(longpath);
+
+    std::array<char, 128> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    ASSERT_EQ(n, buf.size());
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Ok);
+
+    std::size_t len = 0;
+    EXPECT_EQ(codec::visit_frame(frame, [&](const auto& out) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(out)>, RequestPayload>)
+            len = out.path.size();
+    }), codec::DecodeStatus::Ok);
+    EXPECT_GT(len, 0u);
+    EXPECT_LT(len, longpath.size());
+}
+
+TEST(BinaryCodec, EncodeFailsWhenFixedFieldsDoNotFit) {
+    const auto in = make_generic();
+    std::array<char, 8> buf{};
+    EXPECT_EQ(codec::encode(in, buf.data(), buf.size()), 0u);
+}
+
+TEST(BinaryCodec, PartialFrameNeedsMore) {
+    const auto in = make_generic();
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+
+    std::string_view view{buf.data(), n - 1};
+    codec::Frame frame{};
+    EXPECT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::NeedMore);
+    EXPECT_EQ(view.size(), n - 1);
+}
+
+TEST(BinaryCodec, UnknownTagIsSkipped) {
+    const auto in = make_generic();
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    buf[2] = static_cast<char>(MsgTag::Count);
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    EXPECT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::UnknownTag);
+    EXPECT_TRUE(view.empty());
+}
+
+TEST(BinaryCodec, SchemaMismatchIsBadFrame) {
+    const auto in = make_generic();
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    buf[3] = 9;     // schema_version in the prefix no longer matches the body
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Ok);
+    EXPECT_EQ(codec::visit_frame(frame, [](const auto&) {}), codec::DecodeStatus::BadFrame);
+}
+
+TEST(BinaryCodec, DecodeToText) {
+    std::array<char, 256> a{}, b{};
+    const std::size_t na = codec::encode(make_generic(), a.data(), a.size());
+    const std::size_t nb = codec::encode(make_request("/p"), b.data(), b.size());
+    const auto file = make_file({{a.data(), na}, {b.data(), nb}});
+
+    std::ostringstream os;
+    const auto sum = codec::decode_to(file, os, codec::OutputFormat::Text);
+    EXPECT_TRUE(sum.header_ok);
+    EXPECT_FALSE(sum.truncated);
+    EXPECT_EQ(sum.records, 2u);
+    EXPECT_EQ(sum.skipped, 0u);
+
+    const std::string out = os.str();
+    EXPECT_NE(out.find("severity=Warn"), std::string::npos);
+    EXPECT_NE(out.find("request_id=42"), std::string::npos);
+    EXPECT_NE(out.find("path=/p"), std::string::npos);
+}
+
+TEST(BinaryCodec, DecodeToJsonEscapesStrings) {
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(make_request("a\"b\n"), buf.data(), buf.size());
+    const auto file = make_file({{buf.data(), n}});
+
+    std::ostringstream os;
+    const auto sum = codec::decode_to(file, os, codec::OutputFormat::Json);
+    EXPECT_EQ(sum.records, 1u);
+
+    const std::string out = os.str();
+    EXPECT_NE(out.find("\"tag\":\"Request\""), std::string::npos);
+    EXPECT_NE(out.find("\"severity\":\"Error\""), std::string::npos);
+    EXPECT_NE(out.find("\"path\":\"a\\\"b\\n\""), std::string::npos);
+}
+
+// limit::Folded: the payload's frame, flagged, with the count after the
+// fields; decode_to prints it last, as the engine's text does.
+TEST(BinaryCodec, FoldedRoundTripKeepsSuppressed) {
+    logger::limit::Folded<RequestPayload> in{make_request("/p"), 5};
+    std::array<char, 256> buf{}, plain{};
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    ASSERT_EQ(n, codec::encode(make_request("/p"), plain.data(), plain.size()) + sizeof(std::uint64_t));
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Ok);
+    EXPECT_EQ(frame.tag, MsgTag::Request);
+    EXPECT_TRUE(frame.folded);
+    EXPECT_EQ(frame.suppressed, 5u);
+    EXPECT_EQ(codec::visit_frame(frame, [](const auto&) {}), codec::DecodeStatus::Ok);
+
+    const auto file = make_file({{buf.data(), n}});
+    std::ostringstream text, json;
+    EXPECT_EQ(codec::decode_to(file, text, codec::OutputFormat::Text).records, 1u);
+    EXPECT_EQ(codec::decode_to(file, json, codec::OutputFormat::Json).records, 1u);
+
+    std::ostringstream plain_text;
+    codec::write_text(plain_text, make_request("/p"));
+    std::string expect = plain_text.str();
+    expect.insert(expect.size() - 1, "suppressed=5 ");
+    EXPECT_EQ(text.str(), expect);
+    EXPECT_TRUE(json.str().ends_with(",\"path\":\"/p\",\"suppressed\":5}\n")) << json.str();
+}
+
+// The flag does not make an unknown tag readable; the frame is skipped
+// whole, trailer included.
+TEST(BinaryCodec, FoldedUnknownTagIsSkipped) {
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(logger::limit::Folded<GenericPayload>{make_generic(), 1},
+                                        buf.data(), buf.size());
+    EXPECT_GE(static_cast<std::uint8_t>(buf[2]), codec::kFoldedFlag);
+    buf[2] = static_cast<char>(static_cast<std::uint8_t>(MsgTag::Count) | codec::kFoldedFlag);
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    EXPECT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::UnknownTag);
+    EXPECT_TRUE(view.empty());
+}
+
+// Text frames carry envelopes outside the schema; the frames around them
+// still decode.
+TEST(BinaryCodec, TextFrameBetweenRecords) {
+    std::array<char, 256> a{}, t{}, b{};
+    const std::size_t na = codec::encode(make_generic(), a.data(), a.size());
+    const std::size_t nt = codec::encode_text(t.data(), t.size(), [](char* dst, std::size_t room) {
+        const std::string_view line = "custom \"text\"\n";
+        std::memcpy(dst, line.data(), std::min(line.size(), room));
+        return line.size();
+    });
+    const std::size_t nb = codec::encode(make_request("/p"), b.data(), b.size());
+    const auto file = make_file({{a.data(), na}, {t.data(), nt}, {b.data(), nb}});
+
+    std::string_view view{t.data(), nt};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Text);
+    EXPECT_EQ(frame.body, "custom \"text\"\n");
+    EXPECT_TRUE(view.empty());
+
+    std::ostringstream text, json;
+    const auto sum = codec::decode_to(file, text, codec::OutputFormat::Text);
+    codec::decode_to(file, json, codec::OutputFormat::Json);
+    EXPECT_EQ(sum.records, 2u);
+    EXPECT_EQ(sum.text, 1u);
+    EXPECT_EQ(sum.skipped, 0u);
+    EXPECT_FALSE(sum.truncated);
+    EXPECT_NE(text.str().find("\ncustom \"text\"\n[tag=1]"), std::string::npos);
+    EXPECT_NE(json.str().find("\n{\"text\":\"custom \\\"text\\\"\"}\n{\"tag\":\"Request\""), std::string::npos);
+}
+
+TEST(BinaryCodec, TextFrameIsCutToCapacity) {
+    std::array<char, 16> buf{};
+    const std::size_t n = codec::encode_text(buf.data(), buf.size(), [](char* dst, std::size_t room) {
+        std::memset(dst, 'x', room);
+        return std::size_t{100};
+    });
+    EXPECT_EQ(n, buf.size());
+
+    std::string_view view{buf.data(), n};
+    codec::Frame frame{};
+    ASSERT_EQ(codec::next_frame(view, frame), codec::DecodeStatus::Text);
+    EXPECT_EQ(frame.body, std::string(buf.size() - codec::kFramePrefix, 'x'));
+}
+
+TEST(BinaryCodec, DecodeToReportsTruncatedTail) {
+    std::array<char, 256> buf{};
+    const std::size_t n = codec::encode(make_generic(), buf.data(), buf.size());
+    const auto file = make_file({{buf.data(), n}, {buf.data(), n / 2}});
+
+    std::ostringstream os;
+    const auto sum = codec::decode_to(file, os, codec::OutputFormat::Text);
+    EXPECT_EQ(sum.records, 1u);
+    EXPECT_TRUE(sum.truncated);
+}
+
+TEST(BinaryCodec, DecodeToRejectsBadHeader) {
+    std::ostringstream os;
+    const auto sum = codec::decode_to("not a binary log file", os, codec::OutputFormat::Text);
+    EXPECT_FALSE(sum.header_ok);
+    EXPECT_TRUE(os.str().empty());
+}
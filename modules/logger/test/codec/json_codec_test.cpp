@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <charconv>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "common/messages/payloads/json_escape.hpp"
+#include "logger/codec/binary_codec.hpp"
+#include "logger/codec/json_codec.hpp"
+#include "publisher/sink_publisher.hpp"
+
+namespace codec = logger::codec;
+using logger::registry::GenericPayload;
+using logger::registry::RequestPayload;
+
+namespace {
+    GenericPayload make_generic() {
+        GenericPayload p{};
+        p.severity       = Severity::Warn;
+        p.timestamp      = 123456789;
+        p.thread_id      = 7;
+        p.request_id     = 42;
+        p.class_id       = 3;
+        p.method_id      = 4;
+        p.schema_version = 1;
+        return p;
+    }
+
+    RequestPayload make_request(std::string_view path) {
+        RequestPayload p{};
+        p.severity       = Severity::Error;
+        p.timestamp      = 18446744073709551615ull;
+        p.thread_id      = 1;
+        p.request_id     = 2;
+        p.class_id       = 5;
+        p.method_id      = 6;
+        p.schema_version = 2;
+        p.req_unique_id  = 0xDEADBEEF;
+        p.path           = path;
+        return p;
+    }
+
+    template <typename Payload>
+    std::string to_json(const Payload& p) {
+        char probe = 0;
+        std::string out(codec::encode_json(p, &probe, 0), '\0');
+        codec::encode_json(p, out.data(), out.size());
+        return out;
+    }
+
+    // Just enough JSON for flat objects of strings and numbers: strings
+    // come back unescaped, numbers as their text. Empty map on bad input.
+    struct Parser {
+        std::string_view in;
+        std::size_t i = 0;
+        bool ok = true;
+
+        bool eat(char c) {
+            if (i < in.size() && in[i] == c) { ++i; return true; }
+            return ok = false;
+        }
+
+        std::string string() {
+            std::string out;
+            if (!eat('"')) return out;
+            while (ok && i < in.size() && in[i] != '"') {
+                const auto c = static_cast<unsigned char>(in[i++]);
+                if (c < 0x20) { ok = false; break; }
+                if (c != '\\') { out.push_back(static_cast<char>(c)); continue; }
+                if (i >= in.size()) { ok = false; break; }
+                switch (in[i++]) {
+                    case '"':  out.push_back('"');  break;
+                    case '\\': out.push_back('\\'); break;
+                    case '/':  out.push_back('/');  break;
+                    case 'n':  out.push_back('\n'); break;
+                    case 'r':  out.push_back('\r'); break;
+                    case 't':  out.push_back('\t'); break;
+                    case 'b':  out.push_back('\b'); break;
+                    case 'f':  out.push_back('\f'); break;
+                    case 'u': {
+                        unsigned v = 0;
+                        if (i + 4 > in.size() || std::from_chars(in.data() + i, in.data() + i + 4, v, 16).ptr != in.data() + i + 4 || v > 0xFF)
+                            ok = false;
+                        out.push_back(static_cast<char>(v));
+                        i += 4;
+                        break;
+                    }
+                    default: ok = false;
+                }
+            }
+            eat('"');
+            return out;
+        }
+
+        std::string number() {
+            const std::size_t from = i;
+            while (i < in.size() && std::string_view("-+.eE0123456789").find(in[i]) != std::string_view::npos)
+                ++i;
+            if (i == from) ok = false;
+            return std::string(in.substr(from, i - from));
+        }
+
+        std::map<std::string, std::string> object() {
+            std::map<std::string, std::string> out;
+            if (!eat('{')) return {};
+            while (ok && i < in.size() && in[i] != '}') {
+                if (!out.empty() && !eat(',')) break;
+                std::string key = string();
+                if (!eat(':')) break;
+                out[key] = (i < in.size() && in[i] == '"') ? string() : number();
+            }
+            eat('}');
+            return ok && i == in.size() ? out : std::map<std::string, std::string>{};
+        }
+    };
+
+    std::map<std::string, std::string> parse(std::string_view json) {
+        return Parser{json}.object();
+    }
+
+    template <typename T>
+    T number(const std::string& s) {
+        T v{};
+        const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), v);
+        EXPECT_TRUE(ec == std::errc{} && ptr == s.data() + s.size()) << s;
+        return v;
+    }
+
+    Severity severity(const std::string& s) {
+        for (auto v : {Severity::Info, Severity::Warn, Severity::Error})
+            if (toString(v) == s) return v;
+        ADD_FAILURE() << "severity " << s;
+        return Severity::Info;
+    }
+
+    std::string json_escaped(std::string_view s, bool simd) {
+        std::string out(s.size() * 6 + 2, '\0');
+        FieldWriter w{out.data(), out.size()};
+        if (simd) put_json_chars(w, s);
+        else      put_json_chars_scalar(w, s);
+        out.resize(w.size());
+        return out;
+    }
+}
+
+// ─── Schema-generated keys ───────────────────────────────────────
+
+TEST(JsonCodec, KeysAreCompileTimeLiterals) {
+    static_assert(codec::detail::JsonOpen<MsgTag::Request>::value == "{\"tag\":\"Request\"");
+    static_assert(codec::detail::JsonKey<MsgTag::Request, 0>::value == ",\"severity\":");
+    static_assert(codec::detail::JsonKey<MsgTag::Request, 7>::value == ",\"req_unique_id\":");
+    static_assert(codec::detail::JsonKey<MsgTag::Request, 8>::value == ",\"path\":");
+    SUCCEED();
+}
+
+TEST(JsonCodec, GenericShape) {
+    EXPECT_EQ(to_json(make_generic()),
+              R"({"tag":"Generic","severity":"Warn","timestamp":123456789,"thread_id":7,"request_id":42,)"
+              R"("class_id":3,"method_id":4,"schema_version":1})");
+}
+
+// ─── Round trip ──────────────────────────────────────────────────
+
+TEST(JsonCodec, RequestRoundTrip) {
+    const std::string path = "/api/v1/\"quoted\"\\back\nline\ttab\x01\x1f end \xc3\xa9";
+    const auto in = make_request(path);
+    const auto fields = parse(to_json(in));
+    ASSERT_EQ(fields.size(), 10u);
+
+    EXPECT_EQ(fields.at("tag"), "Request");
+    RequestPayload out{};
+    out.severity       = severity(fields.at("severity"));
+    out.timestamp      = number<std::uint64_t>(fields.at("timestamp"));
+    out.thread_id      = number<std::uint32_t>(fields.at("thread_id"));
+    out.request_id     = number<std::uint32_t>(fields.at("request_id"));
+    out.class_id       = number<std::uint16_t>(fields.at("class_id"));
+    out.method_id      = number<std::uint16_t>(fields.at("method_id"));
+    out.schema_version = number<std::uint16_t>(fields.at("schema_version"));
+    out.req_unique_id  = number<std::uint64_t>(fields.at("req_unique_id"));
+
+    EXPECT_EQ(out.severity, in.severity);
+    EXPECT_EQ(out.timestamp, in.timestamp);
+    EXPECT_EQ(out.thread_id, in.thread_id);
+    EXPECT_EQ(out.request_id, in.request_id);
+    EXPECT_EQ(out.class_id, in.class_id);
+    EXPECT_EQ(out.method_id, in.method_id);
+    EXPECT_EQ(out.schema_version, in.schema_version);
+    EXPECT_EQ(out.req_unique_id, in.req_unique_id);
+    EXPECT_EQ(fields.at("path"), path);
+}
+
+TEST(JsonCodec, RoundTripEveryByte) {
+    std::string path;
+    for (int c = 1; c < 256; ++c)
+        path.push_back(static_cast<char>(c));
+    const auto fields = parse(to_json(make_request(path)));
+    ASSERT_FALSE(fields.empty());
+    EXPECT_EQ(fields.at("path"), path);
+}
+
+TEST(JsonCodec, MatchesDecodeToJson) {
+    std::array<char, 256> buf{};
+    const auto in = make_request("a\"b\n");
+    const std::size_t n = codec::encode(in, buf.data(), buf.size());
+    const codec::FileHeader h{};
+    std::string file(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.append(buf.data(), n);
+
+    std::ostringstream os;
+    codec::decode_to(file, os, codec::OutputFormat::Json);
+    EXPECT_EQ(os.str(), to_json(in) + "\n");
+}
+
+TEST(JsonCodec, MatchesJsonSinkOnTextLine) {
+    const auto p = make_generic();
+    std::array<char, 512> text{};
+    const std::size_t n = p.format_to(text.data(), text.size());
+    EXPECT_EQ(JsonSink::format({text.data(), n}), to_json(p));
+}
+
+// ─── Truncation ──────────────────────────────────────────────────
+
+TEST(JsonCodec, EncodeReportsFullLength) {
+    const auto in = make_request("/some/path");
+    const std::string full = to_json(in);
+    std::array<char, 16> buf{};
+    EXPECT_EQ(codec::encode_json(in, buf.data(), buf.size()), full.size());
+    EXPECT_EQ(std::string_view(buf.data(), buf.size()), std::string_view(full).substr(0, buf.size()));
+}
+
+TEST(JsonCodec, ClippedShortensStringsToFit) {
+    std::string path;
+    for (int i = 0; i < 300; ++i)
+        path += (i % 7 == 0) ? "\xc3\xa9" : (i % 5 == 0 ? "\"" : "x");
+    const auto in = make_request(path);
+
+    for (std::size_t cap : {1024u, 400u, 260u, 200u}) {
+        std::array<char, 1024> buf{};
+        const std::size_t n = codec::encode_json_clipped(in, buf.data(), cap);
+        ASSERT_GT(n, 0u) << cap;
+        ASSERT_LE(n, cap);
+
+        const auto fields = parse({buf.data(), n});
+        ASSERT_EQ(fields.size(), 10u) << cap;
+        const std::string& got = fields.at("path");
+        EXPECT_EQ(path.compare(0, got.size(), got), 0);
+        EXPECT_NE((static_cast<unsigned char>(path[got.size()]) & 0xC0), 0x80u) << "cut inside UTF-8";
+    }
+}
+
+TEST(JsonCodec, ClippedGivesUpWhenHeaderDoesNotFit) {
+    std::array<char, 32> buf{};
+    EXPECT_EQ(codec::encode_json_clipped(make_request("/p"), buf.data(), buf.size()), 0u);
+}
+
+// ─── Escaping ────────────────────────────────────────────────────
+
+TEST(JsonEscape, SimdMatchesScalar) {
+    std::mt19937 rng(7);
+    const char alphabet[] = "abc/\"\\\n\t\x01\x1f\x7f\x80\xff ";
+    for (std::size_t len = 0; len < 100; ++len) {
+        for (int round = 0; round < 20; ++round) {
+            std::string s(len, 'x');
+            for (auto& c : s)
+                if (rng() % 4 == 0)
+                    c = alphabet[rng() % (sizeof(alphabet) - 1)];
+            ASSERT_EQ(json_escaped(s, true), json_escaped(s, false)) << len;
+        }
+    }
+}
+
+TEST(JsonEscape, EscapeForms) {
+    EXPECT_EQ(json_escaped("plain text, nothing to do", true), "plain text, nothing to do");
+    EXPECT_EQ(json_escaped("q\"b\\n\nr\rt\t", true), "q\\\"b\\\\n\\nr\\rt\\t");
+    EXPECT_EQ(json_escaped(std::string_view("\x00\x1f\x7f", 3), true), "\\u0000\\u001f\x7f");
+}
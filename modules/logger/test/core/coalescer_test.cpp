@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "logger/core/coalescer.hpp"
+
+using logger::core::detail::Coalescer;
+using logger::core::detail::coalesce_key;
+using logger::core::detail::is_volatile_field;
+using logger::registry::GenericPayload;
+using logger::registry::RepeatPayload;
+
+static_assert(is_volatile_field("timestamp"));
+static_assert(!is_volatile_field("request_id"));
+
+namespace {
+    logger::registry::RequestPayload request(std::uint64_t timestamp, std::string_view path) {
+        logger::registry::RequestPayload p{};
+        p.severity      = Severity::Error;
+        p.timestamp     = timestamp;
+        p.thread_id     = 3;
+        p.request_id    = 77;
+        p.req_unique_id = 9;
+        p.path          = path;
+        return p;
+    }
+
+    struct Sink {
+        std::vector<RepeatPayload> out;
+        void operator()(const RepeatPayload& r) { out.push_back(r); }
+    };
+
+    // Key and header of p, as the engine's key_fn gives them.
+    template <typename Payload>
+    bool absorb(Coalescer& c, const Payload& p, std::uint64_t now, Sink& sink) {
+        RepeatPayload header{};
+        const std::uint64_t key = coalesce_key(p, header);
+        return c.absorb(key, header, now, sink);
+    }
+}
+
+TEST(Coalescer, DefaultIsDisabled) {
+    Coalescer c;
+    EXPECT_FALSE(c.enabled());
+    EXPECT_FALSE(c.pending());
+}
+
+TEST(Coalescer, KeyIgnoresVolatileFieldsOnly) {
+    RepeatPayload h1{}, h2{};
+    const std::string path = "/a";
+    const std::string same = "/a";
+
+    EXPECT_EQ(coalesce_key(request(1, path), h1), coalesce_key(request(2, same), h2));
+    EXPECT_EQ(h1.timestamp, 1u);
+    EXPECT_EQ(h2.timestamp, 2u);
+    EXPECT_EQ(h1.of_tag, static_cast<std::uint8_t>(MsgTag::Request));
+    EXPECT_EQ(h1.request_id, 77u);
+
+    EXPECT_NE(coalesce_key(request(1, "/a"), h1), coalesce_key(request(1, "/b"), h2));
+
+    auto other = request(1, "/a");
+    other.request_id = 78;
+    EXPECT_NE(coalesce_key(request(1, "/a"), h1), coalesce_key(other, h2));
+
+    // Same header, different tag.
+    GenericPayload g{};
+    EXPECT_NE(coalesce_key(g, h1), coalesce_key(logger::registry::RequestPayload{}, h2));
+}
+
+TEST(Coalescer, RepeatsInWindowFoldIntoOneSummary) {
+    Coalescer c{100, 16};
+    Sink sink;
+
+    EXPECT_FALSE(absorb(c, request(1000, "/a"), 0, sink));
+    EXPECT_FALSE(c.pending());
+    EXPECT_TRUE(absorb(c, request(1001, "/a"), 10, sink));
+    EXPECT_TRUE(absorb(c, request(1002, "/a"), 20, sink));
+    EXPECT_TRUE(absorb(c, request(1003, "/a"), 99, sink));
+    EXPECT_FALSE(absorb(c, request(1004, "/b"), 99, sink));
+    EXPECT_TRUE(c.pending());
+    EXPECT_EQ(c.next_due(), 100u);
+    EXPECT_TRUE(sink.out.empty());
+
+    c.expire(100, sink);
+    ASSERT_EQ(sink.out.size(), 1u);
+    EXPECT_EQ(sink.out[0].repeated, 3u);
+    EXPECT_EQ(sink.out[0].first_timestamp, 1001u);
+    EXPECT_EQ(sink.out[0].timestamp, 1003u);
+    EXPECT_EQ(sink.out[0].of_tag, static_cast<std::uint8_t>(MsgTag::Request));
+    EXPECT_EQ(sink.out[0].severity, Severity::Error);
+    EXPECT_FALSE(c.pending());
+
+    // The window is over: the next one is written and opens another.
+    EXPECT_FALSE(absorb(c, request(1005, "/a"), 100, sink));
+    EXPECT_TRUE(absorb(c, request(1006, "/a"), 150, sink));
+
+    // "/b" dropped nothing, so its window closes without a summary.
+    c.expire_all(sink);
+    ASSERT_EQ(sink.out.size(), 2u);
+    EXPECT_EQ(sink.out[1].repeated, 1u);
+    EXPECT_EQ(c.open(), 0u);
+
+    const auto s = c.stats();
+    EXPECT_EQ(s.suppressed, 4u);
+    EXPECT_EQ(s.summaries, 2u);
+    EXPECT_EQ(s.evicted, 0u);
+}
+
+TEST(Coalescer, FullTableClosesOldestWindow) {
+    Coalescer c{1000, 4};
+    Sink sink;
+    const std::string paths[] = {"/0", "/1", "/2", "/3", "/4"};
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_FALSE(absorb(c, request(1, paths[i]), 0, sink));
+    EXPECT_TRUE(absorb(c, request(2, paths[0]), 1, sink));
+
+    EXPECT_FALSE(absorb(c, request(3, paths[4]), 2, sink));
+    ASSERT_EQ(sink.out.size(), 1u);
+    EXPECT_EQ(sink.out[0].repeated, 1u);
+    EXPECT_EQ(c.stats().evicted, 1u);
+
+    // "/0" left the table; the others are still matched.
+    EXPECT_FALSE(absorb(c, request(4, paths[0]), 3, sink));
+    EXPECT_EQ(c.stats().evicted, 2u);
+    EXPECT_TRUE(absorb(c, request(4, paths[4]), 3, sink));
+    EXPECT_TRUE(absorb(c, request(4, paths[3]), 3, sink));
+}
+
+// Windows opened, closed and evicted far more times than the table has
+// slots: the probe runs must stay intact across removals.
+TEST(Coalescer, TableSurvivesChurn) {
+    Coalescer c{50, 8};
+    Sink sink;
+    std::uint64_t dropped = 0;
+
+    for (std::uint64_t now = 0; now < 20000; ++now) {
+        const std::string path = "/" + std::to_string(now / 3 % 11);
+        dropped += absorb(c, request(now, path), now, sink);
+    }
+    c.expire_all(sink);
+
+    std::uint64_t summed = 0;
+    for (const auto& r : sink.out)
+        summed += r.repeated;
+    EXPECT_EQ(summed, dropped);
+    EXPECT_EQ(c.stats().suppressed, dropped);
+    EXPECT_GT(dropped, 0u);
+    EXPECT_GT(c.stats().evicted, 0u);
+}
@@ -4,6 +4,7 @@
 #include "logger/core/lockfree_queue.hpp"
 
 using logger::core::detail::FreeList;
+using logger::core::detail::FreeNode;
 using logger::core::detail::LogRecord;
 
 TEST(FreeList, StartsEmpty) {
@@ -64,3 +65,54 @@ TEST(FreeList, PushNPopNAllReturned) {
     EXPECT_TRUE(fl.empty());
     EXPECT_EQ(fl.try_pop(), nullptr);
 }
+
+static FreeNode* make_chain(std::vector<LogRecord>& nodes) {
+    for (std::size_t i = 0; i + 1 < nodes.size(); ++i) {
+        nodes[i].free_next = &nodes[i + 1];
+    }
+    nodes.back().free_next = nullptr;
+    return &nodes.front();
+}
+
+TEST(FreeList, PushChainPopChainSingleUnit) {
+    FreeList fl;
+    std::vector<LogRecord> nodes(8);
+    fl.push_chain(make_chain(nodes));
+
+    FreeNode* chain = fl.try_pop_chain();
+    ASSERT_EQ(chain, &nodes.front());
+    EXPECT_TRUE(fl.empty());
+
+    std::size_t len = 0;
+    for (FreeNode* n = chain; n; n = n->free_next) ++len;
+    EXPECT_EQ(len, nodes.size());
+}
+
+TEST(FreeList, TryPopSplitsChainAndKeepsRemainder) {
+    FreeList fl;
+    std::vector<LogRecord> nodes(4);
+    fl.push_chain(make_chain(nodes));
+
+    std::set<LogRecord*> popped;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        auto* p = static_cast<LogRecord*>(fl.try_pop());
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(p->free_next, nullptr);
+        popped.insert(p);
+    }
+    EXPECT_EQ(popped.size(), nodes.size());
+    EXPECT_TRUE(fl.empty());
+}
+
+TEST(FreeList, ChainsAndSinglesInterleave) {
+    FreeList fl;
+    std::vector<LogRecord> chain(3);
+    LogRecord single{};
+
+    fl.push_chain(make_chain(chain));
+    fl.push(&single);
+
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop_chain()), &single);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop_chain()), &chain.front());
+    EXPECT_EQ(fl.try_pop_chain(), nullptr);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include "logger/core/log_clock.hpp"
+
+using logger::core::LogClock;
+
+namespace {
+    std::int64_t realtime_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::int64_t distance_to_realtime(const LogClock& clock) {
+        const auto ours = static_cast<std::int64_t>(clock.now_ns());
+        const auto real = realtime_ns();
+        return ours > real ? ours - real : real - ours;
+    }
+}
+
+TEST(LogClock, AutoTracksWallTime) {
+    LogClock clock;
+    EXPECT_LT(distance_to_realtime(clock), 50'000'000) << "more than 50 ms off the wall clock";
+}
+
+TEST(LogClock, CoarseTracksWallTime) {
+    LogClock clock{LogClock::Source::Coarse};
+    EXPECT_FALSE(clock.uses_tsc());
+    EXPECT_EQ(clock.tsc_hz(), 0.0);
+    EXPECT_LT(distance_to_realtime(clock), 50'000'000);
+}
+
+TEST(LogClock, NowUsIsNowNsInMicroseconds) {
+    LogClock clock;
+    const std::uint64_t ns = clock.now_ns();
+    const std::uint64_t us = clock.now_us();
+    EXPECT_GE(us, ns / 1000);
+    EXPECT_LT(us - ns / 1000, 1'000'000u);
+}
+
+TEST(LogClock, NeverGoesBackwards) {
+    for (auto source : {LogClock::Source::Auto, LogClock::Source::Coarse}) {
+        LogClock clock{source};
+        std::uint64_t last = clock.now_ns();
+        for (int i = 0; i < 100000; ++i) {
+            const std::uint64_t t = clock.now_ns();
+            ASSERT_GE(t, last);
+            last = t;
+        }
+    }
+}
+
+TEST(LogClock, RecalibrateDoesNotStepBack) {
+    LogClock clock;
+    if (!clock.uses_tsc())
+        GTEST_SKIP() << "no invariant TSC";
+
+    for (int i = 0; i < 100; ++i) {
+        const std::uint64_t before = clock.now_ns();
+        clock.recalibrate();
+        EXPECT_GE(clock.now_ns(), before);
+    }
+    EXPECT_GT(clock.tsc_hz(), 1e8);
+    EXPECT_LT(clock.tsc_hz(), 1e10);
+    EXPECT_LT(distance_to_realtime(clock), 50'000'000);
+}
+
+TEST(LogClock, InstanceIsShared) {
+    EXPECT_EQ(&LogClock::instance(), &LogClock::instance());
+}
+
+TEST(LogClock, PortableScalingMatchesInt128) {
+#ifndef __SIZEOF_INT128__
+    GTEST_SKIP() << "no unsigned __int128 to compare against";
+#else
+    __extension__ typedef unsigned __int128 uint128;
+    using logger::core::detail::mul_shr32;
+    using logger::core::detail::shl32_div;
+
+    const std::uint64_t values[] = {
+        0, 1, 3, 0xffffffffull, 0x100000000ull, 1'000'000'000ull, 2'900'000'000ull,
+        0x123456789abcdefull, 0x8000000000000000ull, 0xfffffffffffffffeull, ~0ull};
+    for (const std::uint64_t a : values) {
+        for (const std::uint64_t b : values) {
+            EXPECT_EQ(mul_shr32(a, b), static_cast<std::uint64_t>((uint128(a) * b) >> 32))
+                << a << " * " << b;
+            if (b != 0) {
+                EXPECT_EQ(shl32_div(a, b), static_cast<std::uint64_t>((uint128(a) << 32) / b))
+                    << a << " / " << b;
+            }
+        }
+    }
+#endif
+}
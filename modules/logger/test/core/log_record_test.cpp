@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
 #include "logger/core/log_record.hpp"
+#include "logger/core/staging_buffer.hpp"
 
 using logger::core::detail::LogRecord;
+using logger::core::detail::StagingBuffer;
 
 TEST(LogRecord, Alignment) {
     static_assert(alignof(LogRecord) == 64);
@@ -24,7 +30,45 @@ TEST(LogRecord, NotPolymorphic) {
 TEST(LogRecord, FunctionPointersDefaultToNull) {
     LogRecord rec{};
     EXPECT_EQ(rec.destroy_fn, nullptr);
-    EXPECT_EQ(rec.submit_fn, nullptr);
+    EXPECT_EQ(rec.key_fn, nullptr);
+    EXPECT_EQ(rec.format_fn, nullptr);
+}
+
+// What the worker does with a record: format_fn renders the envelope in
+// storage straight into the staging buffer, within the limit it is given.
+TEST(LogRecord, FormatFnRendersIntoStagingBuffer) {
+    struct Pair {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    LogRecord rec{};
+    new (rec.storage_ptr()) Pair{7, 42};
+    rec.format_fn = [](void* storage, char* dst, std::size_t cap) -> std::size_t {
+        const auto* p = static_cast<const Pair*>(storage);
+        const std::string text = "a=" + std::to_string(p->a) + " b=" + std::to_string(p->b);
+        const std::size_t n = std::min(text.size(), cap);
+        std::memcpy(dst, text.data(), n);
+        return n;
+    };
+
+    StagingBuffer staging{64, 4};
+    auto render = [&rec](char* dst, std::size_t cap) { return rec.format_fn(rec.storage_ptr(), dst, cap); };
+    staging.append(render, 32);
+    staging.append(render, 5);
+
+    ASSERT_EQ(staging.views().size(), 2u);
+    EXPECT_EQ(staging.views()[0], "a=7 b=42");
+    EXPECT_EQ(staging.views()[1], "a=7 b");
+    EXPECT_EQ(staging.bytes(), 13u);
+}
+
+TEST(LogRecord, StampFitsBeforeStorage) {
+    LogRecord rec{};
+    EXPECT_EQ(reinterpret_cast<char*>(rec.storage_ptr()) - reinterpret_cast<char*>(&rec), 64);
+    EXPECT_EQ(rec.stamp, 0u);
+    EXPECT_EQ(rec.seq, 0u);
+    EXPECT_EQ(rec.producer, 0u);
 }
 
 TEST(LogRecord, NextPointersDefaultToNull) {
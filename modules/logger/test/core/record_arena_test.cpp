@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "logger/core/record_arena.hpp"
+#include "logger/core/tagged_freelist.hpp"
+
+using logger::core::detail::LogRecord;
+using logger::core::detail::RecordArena;
+using logger::core::detail::TaggedFreeList;
+
+TEST(RecordArena, ReserveCommitsNothing) {
+    RecordArena arena;
+    arena.reserve(4096);
+
+    EXPECT_NE(arena.base(), nullptr);
+    EXPECT_EQ(arena.reserved(), 4096u);
+    EXPECT_EQ(arena.capacity(), 0u);
+    EXPECT_EQ(arena.slabs(), 0u);
+}
+
+TEST(RecordArena, BaseIsHugePageAligned) {
+    RecordArena arena;
+    arena.reserve(16);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(arena.base()) % (std::uintptr_t{2} << 20), 0u);
+}
+
+TEST(RecordArena, SlabsAreContiguous) {
+    RecordArena arena;
+    arena.reserve(100);
+
+    LogRecord* a = arena.commit(10);
+    LogRecord* b = arena.commit(30);
+
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_EQ(a, arena.base());
+    EXPECT_EQ(b, a + 10);
+    EXPECT_EQ(arena.capacity(), 40u);
+    EXPECT_EQ(arena.slabs(), 2u);
+}
+
+TEST(RecordArena, CommittedRecordsAreConstructed) {
+    RecordArena arena;
+    arena.reserve(8);
+    LogRecord* recs = arena.commit(8);
+    ASSERT_NE(recs, nullptr);
+
+    for (std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(recs[i].next.load(), nullptr);
+        EXPECT_EQ(recs[i].destroy_fn, nullptr);
+        EXPECT_EQ(recs[i].format_fn, nullptr);
+        recs[i].storage[LogRecord::StorageSize - 1] = 0xAB;     // writable
+    }
+}
+
+TEST(RecordArena, CommitBeyondReservationFails) {
+    RecordArena arena;
+    arena.reserve(10);
+
+    ASSERT_NE(arena.commit(8), nullptr);
+    EXPECT_EQ(arena.commit(3), nullptr);
+    EXPECT_EQ(arena.commit(0), nullptr);
+    EXPECT_EQ(arena.capacity(), 8u);
+    EXPECT_NE(arena.commit(2), nullptr);
+    EXPECT_EQ(arena.capacity(), 10u);
+}
+
+// Records from later slabs round-trip through a TaggedFreeList attached to
+// the whole reservation
+TEST(RecordArena, GrownSlabsWorkWithTaggedFreeList) {
+    RecordArena arena;
+    arena.reserve(64);
+    TaggedFreeList fl{arena.base(), arena.reserved()};
+
+    LogRecord* first = arena.commit(16);
+    LogRecord* grown = arena.commit(48);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(grown, nullptr);
+
+    fl.push(&first[0]);
+    fl.push(&grown[47]);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &grown[47]);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &first[0]);
+}
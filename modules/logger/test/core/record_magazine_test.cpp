@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+#include "logger/core/lockfree_queue.hpp"
+#include "logger/core/record_magazine.hpp"
+
+using logger::core::detail::FreeList;
+using logger::core::detail::FreeNode;
+using logger::core::detail::LogRecord;
+using logger::core::detail::RecordMagazine;
+using logger::core::detail::RecycleBatch;
+
+namespace {
+    std::size_t drain_count(FreeList& fl) {
+        std::size_t n = 0;
+        while (fl.try_pop() != nullptr) ++n;
+        return n;
+    }
+}
+
+TEST(RecordMagazine, EmptyGlobalYieldsNull) {
+    FreeList fl;
+    RecordMagazine<FreeList> mag{8};
+    EXPECT_EQ(mag.acquire(fl), nullptr);
+}
+
+TEST(RecordMagazine, RefillTakesWholeChain) {
+    FreeList fl;
+    std::vector<LogRecord> pool(8);
+    RecycleBatch<FreeList> batch{8};
+    for (auto& r : pool) batch.add(&r, fl);
+    ASSERT_EQ(batch.size(), 0u) << "full batch must flush itself";
+
+    RecordMagazine<FreeList> mag{8};
+    ASSERT_NE(mag.acquire(fl), nullptr);
+    EXPECT_EQ(mag.size(), 7u);
+    EXPECT_TRUE(fl.empty());
+    mag.flush(fl);
+}
+
+TEST(RecordMagazine, ChainLongerThanCapacityReturnsTail) {
+    FreeList fl;
+    std::vector<LogRecord> pool(10);
+    RecycleBatch<FreeList> batch{10};
+    for (auto& r : pool) batch.add(&r, fl);
+
+    RecordMagazine<FreeList> mag{4};
+    ASSERT_NE(mag.acquire(fl), nullptr);
+    EXPECT_EQ(mag.size(), 3u);
+    EXPECT_EQ(drain_count(fl), 6u);
+    mag.flush(fl);
+}
+
+TEST(RecordMagazine, FlushReturnsEverythingAsOneChain) {
+    FreeList fl;
+    std::vector<LogRecord> pool(6);
+    RecycleBatch<FreeList> batch{6};
+    for (auto& r : pool) batch.add(&r, fl);
+
+    RecordMagazine<FreeList> mag{8};
+    LogRecord* taken = mag.acquire(fl);
+    ASSERT_NE(taken, nullptr);
+
+    mag.flush(fl);
+    EXPECT_EQ(mag.size(), 0u);
+
+    std::set<FreeNode*> chain;
+    for (FreeNode* n = fl.try_pop_chain(); n; n = n->free_next) chain.insert(n);
+    EXPECT_EQ(chain.size(), 5u);
+    EXPECT_EQ(chain.count(taken), 0u);
+    EXPECT_TRUE(fl.empty());
+}
+
+TEST(RecordMagazine, DestructorReturnsRecordsToHome) {
+    FreeList fl;
+    std::vector<LogRecord> pool(4);
+    RecycleBatch<FreeList> batch{4};
+    for (auto& r : pool) batch.add(&r, fl);
+
+    {
+        RecordMagazine<FreeList> mag{4};
+        ASSERT_NE(mag.acquire(fl), nullptr);
+    }
+    EXPECT_EQ(drain_count(fl), 3u);
+}
+
+TEST(RecycleBatch, FlushPushesPartialBatch) {
+    FreeList fl;
+    std::vector<LogRecord> pool(3);
+    RecycleBatch<FreeList> batch{16};
+    for (auto& r : pool) batch.add(&r, fl);
+    EXPECT_TRUE(fl.empty());
+
+    batch.flush(fl);
+    EXPECT_EQ(drain_count(fl), 3u);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <thread>
+#include <string>
+#include <vector>
+#include "logger/core/reorder_buffer.hpp"
+
+using logger::core::detail::ReorderBuffer;
+using logger::core::detail::StampKey;
+using logger::core::detail::producer_stamp;
+
+namespace {
+    auto writer(const std::string& text) {
+        return [text](char* dst, std::size_t cap) {
+            const std::size_t n = std::min(text.size(), cap);
+            std::memcpy(dst, text.data(), n);
+            return n;
+        };
+    }
+
+    struct Sink {
+        std::vector<std::string> out;
+        void operator()(std::string_view v) { out.emplace_back(v); }
+    };
+
+    void add(ReorderBuffer& rb, std::uint64_t stamp, std::uint32_t producer, std::uint64_t seq,
+             std::uint64_t now = 0) {
+        rb.append(StampKey{stamp, producer, seq}, now,
+                  writer(std::to_string(stamp) + "/" + std::to_string(producer)), 64);
+    }
+}
+
+TEST(ReorderBuffer, DefaultIsDisabled) {
+    ReorderBuffer rb;
+    EXPECT_FALSE(rb.enabled());
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(ReorderBuffer, ReleasesInStampOrderUpToCutoff) {
+    ReorderBuffer rb{1024, 16};
+    add(rb, 30, 1, 0);
+    add(rb, 10, 2, 0);
+    add(rb, 20, 3, 0);
+    add(rb, 50, 2, 1);
+
+    Sink sink;
+    EXPECT_EQ(rb.release(30, 0, sink), 3u);
+    EXPECT_EQ(sink.out, (std::vector<std::string>{"10/2", "20/3", "30/1"}));
+    EXPECT_EQ(rb.size(), 1u);
+    EXPECT_EQ(rb.oldest_stamp(), 50u);
+
+    rb.release_all(0, sink);
+    EXPECT_EQ(sink.out.back(), "50/2");
+    EXPECT_TRUE(rb.empty());
+}
+
+TEST(ReorderBuffer, EqualStampsKeepThreadThenSequenceOrder) {
+    ReorderBuffer rb{1024, 16};
+    rb.append({7, 2, 1}, 0, writer("b1"), 64);
+    rb.append({7, 2, 0}, 0, writer("b0"), 64);
+    rb.append({7, 1, 5}, 0, writer("a5"), 64);
+
+    Sink sink;
+    rb.release_all(0, sink);
+    EXPECT_EQ(sink.out, (std::vector<std::string>{"a5", "b0", "b1"}));
+}
+
+TEST(ReorderBuffer, LateRecordIsCounted) {
+    ReorderBuffer rb{1024, 16};
+    Sink sink;
+    add(rb, 100, 1, 0);
+    rb.release(100, 0, sink);
+
+    add(rb, 90, 2, 0);      // arrived after a later stamp went out
+    rb.release(100, 0, sink);
+
+    EXPECT_EQ(sink.out, (std::vector<std::string>{"100/1", "90/2"}));
+    EXPECT_EQ(rb.stats().late, 1u);
+    EXPECT_EQ(rb.stats().released, 2u);
+}
+
+TEST(ReorderBuffer, HoldTimeIsMeasuredFromArrival) {
+    ReorderBuffer rb{1024, 16};
+    add(rb, 1, 1, 0, 1000);
+    add(rb, 2, 1, 1, 1500);
+
+    Sink sink;
+    rb.release_all(2000, sink);
+    EXPECT_EQ(rb.stats().hold_ns_total, 1000u + 500u);
+    EXPECT_EQ(rb.stats().hold_ns_max, 1000u);
+}
+
+TEST(ReorderBuffer, RecordLimitBoundsTheBuffer) {
+    ReorderBuffer rb{1024, 2};
+    add(rb, 1, 1, 0);
+    add(rb, 2, 1, 1);
+    EXPECT_FALSE(rb.has_room(64));
+
+    Sink sink;
+    rb.release_oldest(0, sink);
+    EXPECT_EQ(rb.stats().forced, 1u);
+    EXPECT_TRUE(rb.has_room(64));
+}
+
+TEST(ReorderBuffer, SpaceComesBackAcrossWraps) {
+    ReorderBuffer rb{256, 64};
+    Sink sink;
+    std::uint64_t stamp = 0;
+
+    // Fill, drain, repeat: records land at every offset of the ring and
+    // skip the short tail before wrapping.
+    for (int round = 0; round < 50; ++round) {
+        while (rb.has_room(64)) {
+            ++stamp;
+            add(rb, stamp, 1, stamp);
+        }
+        rb.release(stamp - 1, 0, sink);
+    }
+    rb.release_all(0, sink);
+
+    ASSERT_EQ(sink.out.size(), stamp);
+    for (std::uint64_t i = 0; i < stamp; ++i)
+        EXPECT_EQ(sink.out[i], std::to_string(i + 1) + "/1");
+    EXPECT_EQ(rb.stats().late, 0u);
+}
+
+TEST(ReorderBuffer, ArrivalSpaceIsHeldUntilOldestArrivalGoes) {
+    ReorderBuffer rb{256, 64};
+    add(rb, 500, 1, 0);     // arrives first, goes out last
+    while (rb.has_room(64))
+        add(rb, 1, 2, rb.size());
+
+    Sink sink;
+    rb.release(1, 0, sink);
+    EXPECT_EQ(rb.size(), 1u);
+    EXPECT_FALSE(rb.has_room(128)) << "ring space after the held record is still pinned";
+
+    rb.release_all(0, sink);
+    EXPECT_TRUE(rb.has_room(128));
+}
+
+TEST(ProducerStamp, IdsAreDistinctPerThread) {
+    const auto mine = producer_stamp().id;
+    std::uint32_t other = 0;
+    std::thread([&] { other = producer_stamp().id; }).join();
+
+    EXPECT_NE(mine, 0u);
+    EXPECT_NE(other, 0u);
+    EXPECT_NE(mine, other);
+    EXPECT_EQ(&producer_stamp(), &producer_stamp());
+}
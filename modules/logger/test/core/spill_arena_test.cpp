@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "logger/core/spill_arena.hpp"
+
+using logger::core::SpillConfig;
+using logger::core::detail::SpillArena;
+using logger::core::detail::SpillBlock;
+using logger::core::detail::SpillChunk;
+using logger::core::detail::SpillPool;
+
+namespace {
+    SpillConfig config(std::size_t chunk, std::size_t max) {
+        SpillConfig cfg;
+        cfg.chunk_bytes = chunk;
+        cfg.max_bytes   = max;
+        return cfg;
+    }
+}
+
+TEST(SpillArenaTest, BumpsWithinOneChunk) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+    SpillArena arena{pool};
+
+    const SpillBlock a = arena.allocate(100, 8);
+    const SpillBlock b = arena.allocate(300, 64);
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(a.chunk, b.chunk);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b.ptr) % 64, 0u);
+    EXPECT_GE(static_cast<char*>(b.ptr), static_cast<char*>(a.ptr) + 100);
+    EXPECT_EQ(pool.stats().spilled, 2u);
+    EXPECT_EQ(pool.stats().spilled_bytes, 400u);
+
+    a.chunk->release();
+    b.chunk->release();
+}
+
+// Each arena counts on its own; stats() sums the live ones and keeps what
+// the finished threads' arenas counted.
+TEST(SpillArenaTest, StatsSumLiveAndFinishedArenas) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+    SpillArena mine{pool};
+    mine.allocate(10, 8).chunk->release();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&pool] {
+            SpillArena arena{pool};
+            for (int i = 0; i < 100; ++i)
+                arena.allocate(20, 8).chunk->release();
+        });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(pool.stats().spilled, 401u);
+    EXPECT_EQ(pool.stats().spilled_bytes, 10u + 400u * 20u);
+}
+
+TEST(SpillArenaTest, ChunkComesBackOnlyAfterCloseAndLastRelease) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+
+    std::vector<SpillBlock> blocks;
+    {
+        SpillArena arena{pool};
+        for (int i = 0; i < 10; ++i)
+            blocks.push_back(arena.allocate(1000, 8));     // 4 per chunk
+        EXPECT_EQ(pool.stats().chunks, 3u);
+    }   // thread exit: the current chunk is closed
+
+    // Release out of order; every chunk is then back in the pool.
+    for (std::size_t i = blocks.size(); i-- > 0;)
+        blocks[i].chunk->release();
+
+    SpillArena again{pool};
+    for (int i = 0; i < 12; ++i)
+        again.allocate(1000, 8).chunk->release();
+    EXPECT_EQ(pool.stats().chunks, 3u);             // reused, none allocated
+}
+
+TEST(SpillArenaTest, OpenChunkIsNotRecycledWhenEmpty) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+    SpillArena arena{pool};
+
+    const SpillBlock a = arena.allocate(64, 8);
+    a.chunk->release();                             // refs drop to the open bias only
+    const SpillBlock b = arena.allocate(64, 8);
+    EXPECT_EQ(a.chunk, b.chunk);
+    EXPECT_GT(b.ptr, a.ptr);                        // still bumping, nothing reused early
+    b.chunk->release();
+}
+
+TEST(SpillArenaTest, LargerThanChunkGetsItsOwn) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+    SpillArena arena{pool};
+
+    const SpillBlock small = arena.allocate(64, 8);
+    const SpillBlock big   = arena.allocate(10000, 8);
+    ASSERT_TRUE(big);
+    EXPECT_NE(big.chunk, small.chunk);
+    EXPECT_EQ(big.chunk->bytes, 10000u);
+    std::memset(big.ptr, 0xAB, big.bytes);
+
+    const auto held = pool.stats().held_bytes;
+    big.chunk->release();
+    EXPECT_EQ(pool.stats().held_bytes, held - sizeof(SpillChunk) - 10000);
+
+    // The shared chunk was not retired by the big one.
+    EXPECT_EQ(arena.allocate(64, 8).chunk, small.chunk);
+    small.chunk->release();
+    small.chunk->release();
+}
+
+TEST(SpillArenaTest, FailsAtMaxBytes) {
+    SpillPool pool;
+    pool.configure(config(4096, 2 * (4096 + sizeof(SpillChunk))));
+    SpillArena arena{pool};
+
+    std::vector<SpillBlock> held;
+    for (int i = 0; i < 8; ++i)
+        held.push_back(arena.allocate(1024, 8));
+    EXPECT_FALSE(arena.allocate(1024, 8));
+    EXPECT_FALSE(arena.allocate(100000, 8));
+    EXPECT_EQ(pool.stats().failed, 2u);
+    EXPECT_EQ(pool.stats().peak_bytes, 2 * (4096 + sizeof(SpillChunk)));
+
+    for (const auto& b : held)
+        b.chunk->release();
+}
+
+TEST(SpillArenaTest, ReleaseFromAnotherThread) {
+    SpillPool pool;
+    pool.configure(config(4096, 1 << 20));
+    std::vector<SpillBlock> blocks;
+
+    std::thread producer([&] {
+        SpillArena arena{pool};
+        for (int i = 0; i < 1000; ++i) {
+            SpillBlock b = arena.allocate(200, 8);
+            std::memset(b.ptr, i & 0xFF, b.bytes);
+            blocks.push_back(b);
+        }
+    });
+    producer.join();
+
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const auto* p = static_cast<const unsigned char*>(blocks[i].ptr);
+        ASSERT_EQ(p[0], i & 0xFF);
+        ASSERT_EQ(p[199], i & 0xFF);
+        blocks[i].chunk->release();
+    }
+
+    // All chunks pooled: a fresh arena reuses them.
+    const auto chunks = pool.stats().chunks;
+    SpillArena arena{pool};
+    for (int i = 0; i < 1000; ++i)
+        arena.allocate(200, 8).chunk->release();
+    EXPECT_EQ(pool.stats().chunks, chunks);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include "logger/core/spsc_ring.hpp"
+
+using logger::core::detail::LaneSet;
+using logger::core::detail::LogRecord;
+using logger::core::detail::SpscRing;
+
+TEST(SpscRing, StartsEmpty) {
+    SpscRing ring{8};
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(SpscRing, CapacityRoundedUpToPowerOfTwo) {
+    SpscRing ring{5};
+    EXPECT_EQ(ring.capacity(), 8u);
+}
+
+TEST(SpscRing, ReserveCommitFrontPop) {
+    SpscRing ring{4};
+    LogRecord* slot = ring.try_reserve();
+    ASSERT_NE(slot, nullptr);
+    new (slot->storage_ptr()) std::uint64_t{42};
+    ring.commit();
+
+    EXPECT_FALSE(ring.empty());
+    LogRecord* rec = ring.front();
+    ASSERT_EQ(rec, slot);
+    EXPECT_EQ(*static_cast<std::uint64_t*>(rec->storage_ptr()), 42u);
+    ring.pop();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRing, ReserveWithoutCommitIsInvisible) {
+    SpscRing ring{4};
+    ASSERT_NE(ring.try_reserve(), nullptr);
+    EXPECT_EQ(ring.front(), nullptr);
+}
+
+TEST(SpscRing, FullRingRefusesReserve) {
+    SpscRing ring{4};
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NE(ring.try_reserve(), nullptr);
+        ring.commit();
+    }
+    EXPECT_EQ(ring.try_reserve(), nullptr);
+
+    ring.front();
+    ring.pop();
+    EXPECT_NE(ring.try_reserve(), nullptr);
+}
+
+TEST(SpscRing, FIFOOrderingAcrossWrap) {
+    SpscRing ring{4};
+    std::uint64_t next_in = 0, next_out = 0;
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            LogRecord* slot = ring.try_reserve();
+            ASSERT_NE(slot, nullptr);
+            new (slot->storage_ptr()) std::uint64_t{next_in++};
+            ring.commit();
+        }
+        while (LogRecord* rec = ring.front()) {
+            EXPECT_EQ(*static_cast<std::uint64_t*>(rec->storage_ptr()), next_out++);
+            ring.pop();
+        }
+    }
+    EXPECT_EQ(next_in, next_out);
+}
+
+TEST(LaneSet, SameThreadGetsSameLane) {
+    LaneSet lanes{4, 16};
+    auto* a = lanes.local();
+    auto* b = lanes.local();
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(lanes.lane_count(), 1u);
+}
+
+TEST(LaneSet, DrainVisitsCommittedRecords) {
+    LaneSet lanes{4, 16};
+    auto* lane = lanes.local();
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(lane->try_reserve(), nullptr);
+        lane->commit();
+        lane->count_enqueued();
+    }
+
+    std::size_t seen = 0;
+    EXPECT_EQ(lanes.drain([&](LogRecord*) { ++seen; }, 3), 3u);
+    EXPECT_EQ(lanes.drain([&](LogRecord*) { ++seen; }, 3), 2u);
+    EXPECT_EQ(seen, 5u);
+    EXPECT_TRUE(lanes.empty());
+    EXPECT_EQ(lanes.enqueued(), 5u);
+}
+
+TEST(SpscRing, ProducerSizeCountsUnpoppedSlots) {
+    SpscRing ring{8};
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_NE(ring.try_reserve(), nullptr);
+        ring.commit();
+    }
+    ring.front();
+    ring.pop();
+    ring.pop();
+    EXPECT_EQ(ring.producer_size(0), 3u);
+}
+
+// A shed request on one lane is seen only by that lane's records.
+TEST(LaneSet, ShedRequestStaysOnItsLane) {
+    LaneSet lanes{4, 16};
+    auto fill = [&lanes] {
+        auto* lane = lanes.local();
+        for (int i = 0; i < 2; ++i) {
+            EXPECT_NE(lane->try_reserve(), nullptr);
+            lane->commit();
+        }
+        return lane;
+    };
+    auto* mine = fill();
+    std::thread([&] { fill(); }).join();
+    mine->shed.request();
+
+    std::size_t shed_mine = 0, shed_other = 0;
+    lanes.drain([&](LogRecord*, auto& lane) {
+        if (lane.shed.pending() && lane.shed.take())
+            ++(&lane == mine ? shed_mine : shed_other);
+    }, 16);
+    EXPECT_EQ(shed_mine, 1u);
+    EXPECT_EQ(shed_other, 0u);
+}
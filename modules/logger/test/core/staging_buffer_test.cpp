@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include "logger/core/staging_buffer.hpp"
+
+using logger::core::detail::StagingBuffer;
+
+namespace {
+    auto writer(const char* text) {
+        return [text](char* dst, std::size_t cap) {
+            const std::size_t n = std::min(std::strlen(text), cap);
+            std::memcpy(dst, text, n);
+            return n;
+        };
+    }
+}
+
+TEST(StagingBuffer, StartsEmpty) {
+    StagingBuffer sb{128, 4};
+    EXPECT_TRUE(sb.empty());
+    EXPECT_EQ(sb.bytes(), 0u);
+    EXPECT_EQ(sb.remaining(), 128u);
+    EXPECT_TRUE(sb.views().empty());
+}
+
+TEST(StagingBuffer, RecordsAreContiguous) {
+    StagingBuffer sb{128, 4};
+    sb.append(writer("one;"), 64);
+    sb.append(writer("two;"), 64);
+
+    auto v = sb.views();
+    ASSERT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[0], "one;");
+    EXPECT_EQ(v[1], "two;");
+    EXPECT_EQ(v[0].data() + v[0].size(), v[1].data());
+    EXPECT_EQ(sb.bytes(), 8u);
+}
+
+TEST(StagingBuffer, AppendIsCappedByLimit) {
+    StagingBuffer sb{128, 4};
+    sb.append(writer("truncated"), 5);
+    EXPECT_EQ(sb.views()[0], "trunc");
+}
+
+TEST(StagingBuffer, HasRoomTracksViewsAndBytes) {
+    StagingBuffer sb{16, 2};
+    EXPECT_TRUE(sb.has_room(16));
+    EXPECT_FALSE(sb.has_room(17));
+
+    sb.append(writer("abcd"), 16);
+    EXPECT_TRUE(sb.has_room(12));
+    EXPECT_FALSE(sb.has_room(13));
+
+    sb.append(writer("ef"), 16);
+    EXPECT_FALSE(sb.has_room(1)) << "view limit reached";
+}
+
+TEST(StagingBuffer, ClearReusesStorage) {
+    StagingBuffer sb{32, 4};
+    sb.append(writer("first"), 32);
+    const char* begin = sb.views()[0].data();
+
+    sb.clear();
+    EXPECT_TRUE(sb.empty());
+    EXPECT_EQ(sb.remaining(), 32u);
+
+    sb.append(writer("again"), 32);
+    EXPECT_EQ(sb.views()[0].data(), begin);
+}
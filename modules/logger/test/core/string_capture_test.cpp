@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+
+#include "logger/core/string_capture.hpp"
+
+using logger::core::SpillConfig;
+using logger::core::detail::CapturedString;
+using logger::core::detail::CapturedStrings;
+using logger::core::detail::CaptureTail;
+using logger::core::detail::capture_string;
+using logger::core::detail::capture_strings;
+using logger::core::detail::kStringFields;
+using logger::core::detail::kTruncatedMark;
+using logger::core::detail::SpillArena;
+using logger::core::detail::SpillPool;
+using logger::registry::GenericPayload;
+using logger::registry::RequestPayload;
+
+static_assert(kStringFields<RequestPayload> == 1);
+static_assert(kStringFields<GenericPayload> == 0);
+static_assert(kStringFields<int> == 0);
+
+TEST(StringCaptureTest, CopiesIntoTail) {
+    char storage[64];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    std::string src = "/api/orders";
+
+    const CapturedString c = capture_string(src, 1024, tail, nullptr);
+    src.assign(src.size(), 'X');
+
+    EXPECT_EQ(c.view, "/api/orders");
+    EXPECT_EQ(c.view.data(), storage);
+    EXPECT_EQ(c.chunk, nullptr);
+    EXPECT_FALSE(c.truncated);
+    EXPECT_EQ(tail.next, storage + 11);
+}
+
+TEST(StringCaptureTest, EmptyStaysEmpty) {
+    char storage[8];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    const CapturedString c = capture_string({}, 1024, tail, nullptr);
+    EXPECT_TRUE(c.view.empty());
+    EXPECT_EQ(tail.next, storage);
+}
+
+TEST(StringCaptureTest, LongerThanMaxIsMarked) {
+    char storage[64];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    const std::string src(100, 'a');
+
+    const CapturedString c = capture_string(src, 20, tail, nullptr);
+    EXPECT_TRUE(c.truncated);
+    EXPECT_EQ(c.view.size(), 20u);
+    EXPECT_EQ(c.view, std::string(20 - kTruncatedMark.size(), 'a') + std::string(kTruncatedMark));
+}
+
+TEST(StringCaptureTest, MarkNeverExceedsMax) {
+    char storage[64];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+
+    EXPECT_EQ(capture_string("abcdef", 2, tail, nullptr).view, "..");
+    EXPECT_EQ(capture_string("abcdef", 1, tail, nullptr).view, ".");
+    const CapturedString none = capture_string("abcdef", 0, tail, nullptr);
+    EXPECT_TRUE(none.truncated);
+    EXPECT_TRUE(none.view.empty());
+}
+
+TEST(StringCaptureTest, CutDoesNotSplitUtf8) {
+    char storage[64];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    const std::string src = "ab\xC5\x82\xC5\x82\xC5\x82";     // "abłłł"
+
+    const CapturedString c = capture_string(src, 6, tail, nullptr);   // 3 bytes before the mark
+    EXPECT_EQ(c.view, "ab...");
+}
+
+TEST(StringCaptureTest, SpillsWhenTailIsFull) {
+    SpillPool pool;
+    SpillArena arena{pool};
+    char storage[16];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    const std::string src(500, 'p');
+
+    const CapturedString c = capture_string(src, 1024, tail, &arena);
+    ASSERT_NE(c.chunk, nullptr);
+    EXPECT_FALSE(c.truncated);
+    EXPECT_EQ(c.view, src);
+    EXPECT_EQ(tail.next, storage);          // the tail is left for shorter fields
+    EXPECT_EQ(pool.stats().spilled_bytes, 500u);
+    c.chunk->release();
+}
+
+TEST(StringCaptureTest, SpillPoolFullKeepsInlinePrefix) {
+    SpillPool pool;
+    SpillConfig cfg;
+    cfg.max_bytes = 0;
+    pool.configure(cfg);
+    SpillArena arena{pool};
+
+    char storage[16];
+    CaptureTail tail{storage, storage + sizeof(storage)};
+    const CapturedString c = capture_string(std::string(500, 'p'), 1024, tail, &arena);
+    EXPECT_EQ(c.chunk, nullptr);
+    EXPECT_TRUE(c.truncated);
+    EXPECT_EQ(c.view, std::string(13, 'p') + "...");
+    EXPECT_EQ(pool.stats().failed, 1u);
+
+    // Nothing left inline: the mark alone, from static storage.
+    const CapturedString none = capture_string("more", 1024, tail, nullptr);
+    EXPECT_TRUE(none.truncated);
+    EXPECT_EQ(none.view, kTruncatedMark);
+    EXPECT_EQ(tail.next, tail.end);
+}
+
+TEST(StringCaptureTest, RebindsPayloadFields) {
+    SpillPool pool;
+    SpillArena arena{pool};
+    char storage[32];
+
+    std::string path = "/checkout/cart/1234567890/items";   // 31 bytes, fits
+    RequestPayload p{};
+    p.path = path;
+
+    CapturedStrings<kStringFields<RequestPayload>> held;
+    EXPECT_EQ(capture_strings(p, held, CaptureTail{storage, storage + sizeof(storage)}, &arena, 1024), 0u);
+    path.assign(path.size(), '#');
+    EXPECT_EQ(p.path, "/checkout/cart/1234567890/items");
+    EXPECT_EQ(p.path.data(), storage);
+    EXPECT_EQ(held.chunks[0], nullptr);
+}
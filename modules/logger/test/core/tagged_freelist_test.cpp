@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+#include "logger/core/tagged_freelist.hpp"
+
+using logger::core::detail::FreeNode;
+using logger::core::detail::LogRecord;
+using logger::core::detail::TaggedFreeList;
+
+TEST(TaggedFreeList, StartsEmpty) {
+    std::vector<LogRecord> pool(4);
+    TaggedFreeList fl{pool.data(), pool.size()};
+    EXPECT_TRUE(fl.empty());
+    EXPECT_EQ(fl.try_pop(), nullptr);
+}
+
+TEST(TaggedFreeList, LIFOOrdering) {
+    std::vector<LogRecord> pool(3);
+    TaggedFreeList fl{pool.data(), pool.size()};
+
+    fl.push(&pool[0]);
+    fl.push(&pool[1]);
+    fl.push(&pool[2]);
+
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool[2]);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool[1]);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool[0]);
+    EXPECT_TRUE(fl.empty());
+}
+
+TEST(TaggedFreeList, FirstAndLastIndexRoundTrip) {
+    std::vector<LogRecord> pool(64);
+    TaggedFreeList fl{pool.data(), pool.size()};
+
+    fl.push(&pool.front());
+    fl.push(&pool.back());
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool.back());
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool.front());
+}
+
+TEST(TaggedFreeList, ChainPushPopAndSplit) {
+    std::vector<LogRecord> pool(5);
+    TaggedFreeList fl{pool.data(), pool.size()};
+
+    for (std::size_t i = 0; i + 1 < pool.size(); ++i) pool[i].free_next = &pool[i + 1];
+    pool.back().free_next = nullptr;
+    fl.push_chain(&pool[0]);
+
+    std::set<FreeNode*> popped;
+    while (FreeNode* n = fl.try_pop()) {
+        EXPECT_EQ(n->free_next, nullptr);
+        popped.insert(n);
+    }
+    EXPECT_EQ(popped.size(), pool.size());
+}
+
+TEST(TaggedFreeList, AttachAfterDefaultConstruction) {
+    TaggedFreeList fl;
+    std::vector<LogRecord> pool(2);
+    fl.attach(pool.data(), pool.size());
+
+    fl.push(&pool[1]);
+    EXPECT_EQ(static_cast<LogRecord*>(fl.try_pop()), &pool[1]);
+}
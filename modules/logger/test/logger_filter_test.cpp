@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+
+#include "logger/logger.hpp"
+#include "mocks/mock_log_engine.hpp"
+
+using logger::Handler;
+using logger::core::Overflow;
+using logger::core::detail::TestLogEngine;
+namespace filter = logger::filter;
+
+using MockPolicyTextSink = logger::test::MockPolicyTemplate<TextSink>;
+
+namespace {
+    int g_evaluated = 0;
+
+    std::uint64_t counted_timestamp()
+    {
+        ++g_evaluated;
+        return 123456u;
+    }
+
+    // Leaves every class enabled for the next test.
+    struct ClassOff
+    {
+        LogClassId c;
+        explicit ClassOff(LogClassId id) : c(id) { filter::set_class_enabled(c, false); }
+        ~ClassOff() { filter::set_class_enabled(c, true); }
+    };
+}
+
+// Build settings as configured (Info and nothing disabled by default).
+static_assert(filter::compiled_in<Severity::Error, LogClassId::Handler, MethodId::Handler_Run> ==
+              (filter::kClassCompiled[static_cast<std::size_t>(LogClassId::Handler)] &&
+               filter::kMethodCompiled[static_cast<std::size_t>(MethodId::Handler_Run)]));
+static_assert(!filter::compiled_in<Severity::Info, LogClassId::Handler, MethodId::Handler_Run> ||
+              filter::kMinSeverity == Severity::Info);
+
+TEST(LoggerFilterTest, FillsClassAndMethodFromTemplate)
+{
+    if constexpr (!filter::compiled_in<Severity::Error, LogClassId::Handler, MethodId::Handler_Run>)
+        GTEST_SKIP() << "Handler::Run compiled out in this build";
+
+    MockPolicyTextSink::clear();
+    Handler::log<MsgTag::Generic, Severity::Error, LogClassId::Handler, MethodId::Handler_Run,
+                 Overflow::DropNewest, TestLogEngine>(
+        std::uint64_t{123456u}, std::uint32_t{7u}, std::uint32_t{999u}, std::uint16_t{1u});
+
+    const auto& logs = MockPolicyTextSink::get_output();
+    ASSERT_EQ(logs.size(), 1u);
+    EXPECT_NE(logs[0].find("severity=Error"), std::string::npos);
+    EXPECT_NE(logs[0].find("class_id=Handler"), std::string::npos);
+    EXPECT_NE(logs[0].find("method_id=Run"), std::string::npos);
+}
+
+TEST(LoggerFilterTest, ClassSwitchedOffAtRuntime)
+{
+    MockPolicyTextSink::clear();
+    {
+        const ClassOff off{LogClassId::Handler};
+        EXPECT_FALSE(filter::class_enabled(LogClassId::Handler));
+        EXPECT_TRUE(filter::class_enabled(LogClassId::Server));
+
+        Handler::log<MsgTag::Generic, Severity::Error, LogClassId::Handler, MethodId::Handler_Run,
+                     Overflow::DropNewest, TestLogEngine>(
+            std::uint64_t{1u}, std::uint32_t{1u}, std::uint32_t{1u}, std::uint16_t{1u});
+        EXPECT_TRUE(MockPolicyTextSink::get_output().empty());
+    }
+    EXPECT_TRUE(filter::class_enabled(LogClassId::Handler));
+}
+
+TEST(LoggerFilterTest, MacroSkipsArgumentsWhenFiltered)
+{
+    MockPolicyTextSink::clear();
+    g_evaluated = 0;
+    {
+        const ClassOff off{LogClassId::Server};
+        LOGGER_LOG_TO(TestLogEngine, Generic, Error, Server, AddEvent,
+                      counted_timestamp(), std::uint32_t{1u}, std::uint32_t{2u}, std::uint16_t{1u});
+    }
+    EXPECT_EQ(g_evaluated, 0);
+    EXPECT_TRUE(MockPolicyTextSink::get_output().empty());
+
+    LOGGER_LOG_TO(TestLogEngine, Generic, Error, Server, AddEvent,
+                  counted_timestamp(), std::uint32_t{1u}, std::uint32_t{2u}, std::uint16_t{1u});
+    if constexpr (filter::compiled_in<Severity::Error, LogClassId::Server, MethodId::Server_AddEvent>)
+    {
+        EXPECT_EQ(g_evaluated, 1);
+        ASSERT_EQ(MockPolicyTextSink::get_output().size(), 1u);
+        EXPECT_NE(MockPolicyTextSink::get_output()[0].find("method_id=AddEvent"), std::string::npos);
+    }
+    else
+        EXPECT_EQ(g_evaluated, 0);
+}
@@ -34,3 +34,21 @@ TEST(LoggerHeaderSmokeTest, AcceptsValidHeaderPacket)
     // If we reached this point, the basic logging pipeline is at least wired correctly.
     SUCCEED();
 }
+
+TEST(LoggerHeaderSmokeTest, AcceptsExplicitOverflowPolicy)
+{
+    using logger::Handler;
+    using logger::core::Overflow;
+
+    Handler::log<MsgTag::Generic, Overflow::Block>(
+        Severity::Error,
+        std::uint64_t{123456u},
+        std::uint32_t{7u},
+        std::uint32_t{999u},
+        std::uint16_t{1u},
+        std::uint16_t{2u},
+        std::uint16_t{1u}
+    );
+
+    SUCCEED();
+}
@@ -0,0 +1,183 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "logger/logger.hpp"
+#include "mocks/mock_log_engine.hpp"
+
+using logger::core::Overflow;
+using logger::core::detail::TestLogEngine;
+using logger::limit::EveryN;
+using logger::limit::Folded;
+using logger::limit::RateLimit;
+using logger::registry::GenericPayload;
+
+using MockPolicyTextSink = logger::test::MockPolicyTemplate<TextSink>;
+
+// Folded payloads keep their string fields captured at enqueue.
+static_assert(logger::core::detail::kStringFields<Folded<logger::registry::RequestPayload>> == 1);
+
+namespace {
+    void log_every_4th()
+    {
+        LOGGER_LOG_EVERY_N_TO(TestLogEngine, 4, Generic, Warn, Handler, handlingEvent,
+                              std::uint64_t{1u}, std::uint32_t{2u}, std::uint32_t{3u}, std::uint16_t{1u});
+    }
+
+    void log_rated()
+    {
+        LOGGER_LOG_RATE_TO(TestLogEngine, 1, 2, Generic, Warn, Handler, handlingEvent,
+                           std::uint64_t{1u}, std::uint32_t{2u}, std::uint32_t{3u}, std::uint16_t{1u});
+    }
+
+    // Stands in for LogEngine's in-place path: records which entry point
+    // each sampled record took and the suppressed count init() set.
+    struct EmplacingEngine
+    {
+        static EmplacingEngine &instance() noexcept
+        {
+            static EmplacingEngine eng;
+            return eng;
+        }
+
+        template <MsgTag, Overflow = Overflow::DropNewest, typename... Fields>
+        void emplace(Fields &&...)
+        {
+            ++emplaced;
+        }
+
+        template <MsgTag, typename Envelope, Overflow = Overflow::DropNewest, typename Init, typename... Fields>
+        void emplace_as(Init &&init, Fields &&...)
+        {
+            Envelope env{};
+            init(env);
+            folded.push_back(env.suppressed);
+        }
+
+        template <Overflow = Overflow::DropNewest, typename Envelope>
+        void enqueue(Envelope &&)
+        {
+            ++enqueued;
+        }
+
+        int emplaced{0};
+        int enqueued{0};
+        std::vector<std::uint64_t> folded;
+    };
+
+    void log_every_4th_in_place()
+    {
+        LOGGER_LOG_EVERY_N_TO(EmplacingEngine, 4, Generic, Warn, Handler, handlingEvent,
+                              std::uint64_t{1u}, std::uint32_t{2u}, std::uint32_t{3u}, std::uint16_t{1u});
+    }
+
+    void log_rated_in_place()
+    {
+        LOGGER_LOG_RATE_TO(EmplacingEngine, 1, 1, Generic, Warn, Handler, handlingEvent,
+                           std::uint64_t{1u}, std::uint32_t{2u}, std::uint32_t{3u}, std::uint16_t{1u});
+    }
+
+    constexpr bool kSiteCompiled =
+        logger::filter::compiled_in<Severity::Warn, LogClassId::Handler, MethodId::Handler_handlingEvent>;
+}
+
+TEST(LoggerLimitTest, EveryNAdmitsFirstAndEveryNth)
+{
+    EveryN<4> site;
+    std::vector<std::uint64_t> folded;
+    for (int i = 0; i < 10; ++i)
+    {
+        std::uint64_t skipped = 99;
+        if (site.admit(skipped))
+            folded.push_back(skipped);
+    }
+    EXPECT_EQ(folded, (std::vector<std::uint64_t>{0, 3, 3}));
+    EXPECT_EQ(site.skipped, 1u);
+}
+
+TEST(LoggerLimitTest, RateLimitBurstThenRefill)
+{
+    using Limit = RateLimit<10, 3>;     // one per 100 ms, three at once
+    Limit limit;
+    const std::uint64_t t0 = 5'000'000'000ull;
+
+    EXPECT_TRUE(limit.admit(t0));
+    EXPECT_TRUE(limit.admit(t0));
+    EXPECT_TRUE(limit.admit(t0));
+    EXPECT_FALSE(limit.admit(t0));
+    EXPECT_FALSE(limit.admit(t0 + Limit::kIntervalNs - 1));
+    EXPECT_TRUE(limit.admit(t0 + Limit::kIntervalNs));
+    EXPECT_FALSE(limit.admit(t0 + Limit::kIntervalNs));
+
+    // Idle for long enough refills the whole burst, no more.
+    const std::uint64_t later = t0 + 10 * Limit::kIntervalNs;
+    int admitted = 0;
+    for (int i = 0; i < 10; ++i)
+        admitted += limit.admit(later);
+    EXPECT_EQ(admitted, 3);
+}
+
+TEST(LoggerLimitTest, FoldedAppendsSuppressedCount)
+{
+    Folded<GenericPayload> p{};
+    p.severity   = Severity::Warn;
+    p.suppressed = 41;
+
+    char buf[256];
+    const std::string text{buf, p.format_to(buf, sizeof(buf))};
+    EXPECT_NE(text.find("severity=Warn"), std::string::npos);
+    EXPECT_EQ(text.substr(text.size() - 14), "suppressed=41 ");
+}
+
+TEST(LoggerLimitTest, EveryNMacroFoldsSkippedCalls)
+{
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    MockPolicyTextSink::clear();
+    for (int i = 0; i < 9; ++i)
+        log_every_4th();
+
+    const auto& logs = MockPolicyTextSink::get_output();
+    ASSERT_EQ(logs.size(), 3u);
+    EXPECT_EQ(logs[0].find("suppressed="), std::string::npos);
+    EXPECT_NE(logs[1].find("suppressed=3"), std::string::npos);
+    EXPECT_NE(logs[2].find("method_id=handlingEvent"), std::string::npos);
+}
+
+TEST(LoggerLimitTest, RateMacroSuppressesWithoutEngine)
+{
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    MockPolicyTextSink::clear();
+    for (int i = 0; i < 1000; ++i)
+        log_rated();
+
+    // Two at once, then one per second; this loop takes far less.
+    const auto n = MockPolicyTextSink::get_output().size();
+    EXPECT_GE(n, 2u);
+    EXPECT_LE(n, 3u);
+}
+
+// With an engine that builds records in place, neither macro builds a
+// payload to move: the first record goes through emplace, the ones after
+// skipped calls through emplace_as with suppressed set in the record.
+TEST(LoggerLimitTest, SampledMacrosBuildInPlace)
+{
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    EmplacingEngine &eng = EmplacingEngine::instance();
+    for (int i = 0; i < 9; ++i)
+        log_every_4th_in_place();
+    EXPECT_EQ(eng.emplaced, 1);
+    EXPECT_EQ(eng.folded, (std::vector<std::uint64_t>{3, 3}));
+
+    // One at once, one per second: the first call only.
+    for (int i = 0; i < 10; ++i)
+        log_rated_in_place();
+    EXPECT_EQ(eng.emplaced, 2);
+    EXPECT_EQ(eng.enqueued, 0);
+}
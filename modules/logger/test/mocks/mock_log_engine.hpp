@@ -1,6 +1,7 @@
 #pragma once
 
 #include "mock_output_policy.hpp"
+#include "logger/core/overflow_policy.hpp"
 #include "publisher/publisher.hpp"
 #include <sstream>
 #include <string>
@@ -31,7 +32,7 @@ namespace logger::core::detail
             return eng;
         }
 
-        template <typename Envelope>
+        template <Overflow = Overflow::DropNewest, typename Envelope>
         void enqueue(Envelope&& env)
         {
             using EnvClean = std::decay_t<Envelope>;
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <new>
 #include <tuple>
 #include <type_traits>
 #include <string_view>
@@ -113,6 +114,32 @@ TEST(Builder, Request_BuildsPayloadFromTuple_UsingDefs) {
     #undef X
 }
 
+// -----------------------
+// Builder::assign: fields from references into an existing payload
+// -----------------------
+
+TEST(Builder, Request_AssignsInPlaceFromReferences) {
+    using P = typename PayloadRegister<MsgTag::Request>::payload_type;
+
+    const std::string_view path = "/api/v1/orders";
+    std::uint64_t timestamp = 777;
+
+    alignas(P) unsigned char storage[sizeof(P)];
+    P* payload = new (storage) P{};
+    logger::registry::Builder::assign<MsgTag::Request>(*payload, std::forward_as_tuple(
+        Severity::Info, timestamp, std::uint32_t{5}, std::uint32_t{6},
+        std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{3},
+        std::uint64_t{42}, path));
+
+    EXPECT_EQ(payload->severity, Severity::Info);
+    EXPECT_EQ(payload->timestamp, 777u);
+    EXPECT_EQ(payload->request_id, 6u);
+    EXPECT_EQ(payload->schema_version, 3u);
+    EXPECT_EQ(payload->req_unique_id, 42u);
+    EXPECT_EQ(payload->path.data(), path.data());
+    payload->~P();
+}
+
 // -----------------------
 // Contract tests: args_tuple_type vs field_ptrs
 // -----------------------
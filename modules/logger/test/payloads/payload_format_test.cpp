@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "common/messages/traits.hpp"
+#include "logger/registry/payload_register.hpp"
+
+using logger::registry::GenericPayload;
+
+namespace {
+    template <typename P>
+    P filled() {
+        P p{};
+        p.severity       = Severity::Warn;
+        p.timestamp      = std::numeric_limits<std::uint64_t>::max();
+        p.thread_id      = 42;
+        p.request_id     = 0;
+        p.class_id       = 7;
+        p.method_id      = 65535;
+        p.schema_version = 3;
+        return p;
+    }
+
+    template <typename P>
+    std::string via_ostream(const P& p) {
+        std::ostringstream os;
+        p.debug_print(os);
+        return os.str();
+    }
+
+    template <typename P>
+    std::string via_format(const P& p) {
+        std::array<char, 512> buf{};
+        const std::size_t n = p.format_to(buf.data(), buf.size());
+        return std::string(buf.data(), n);
+    }
+}
+
+TEST(PayloadFormat, GenericMatchesDebugPrint) {
+    const auto p = filled<GenericPayload>();
+    EXPECT_EQ(via_format(p), via_ostream(p));
+}
+
+TEST(PayloadFormat, RegistryRequestMatchesDebugPrint) {
+    auto p = filled<logger::registry::RequestPayload>();
+    p.req_unique_id = 17;
+    p.path = "/a/b";
+    EXPECT_EQ(via_format(p), via_ostream(p));
+}
+
+TEST(PayloadFormat, RequestBodyFieldsMatchDebugPrint) {
+    auto p = filled<RequestPayload>();
+    p.req_unique_id = 17;
+    p.path = "/api/items?id=5";
+    EXPECT_EQ(via_format(p), via_ostream(p));
+    EXPECT_NE(via_format(p).find("path=/api/items?id=5 "), std::string::npos);
+}
+
+TEST(PayloadFormat, DefaultPayloadMatchesDebugPrint) {
+    const GenericPayload p{};
+    EXPECT_EQ(via_format(p), via_ostream(p));
+}
+
+TEST(PayloadFormat, ReturnsFullLengthWhenTruncated) {
+    const auto p = filled<GenericPayload>();
+    const std::string full = via_ostream(p);
+
+    std::array<char, 16> buf{};
+    const std::size_t need = p.format_to(buf.data(), buf.size());
+    EXPECT_EQ(need, full.size());
+    EXPECT_EQ(std::string(buf.data(), buf.size()), full.substr(0, buf.size()));
+}
+
+TEST(PayloadFormat, TruncatesInsideNumbers) {
+    const auto p = filled<GenericPayload>();
+    const std::string full = via_ostream(p);
+    const std::size_t cut = full.find("timestamp=") + 14;   // mid-number
+
+    std::string buf(cut, '\0');
+    EXPECT_EQ(p.format_to(buf.data(), buf.size()), full.size());
+    EXPECT_EQ(buf, full.substr(0, cut));
+}
+
+TEST(PayloadFormat, ZeroCapacityOnlyMeasures) {
+    const auto p = filled<GenericPayload>();
+    EXPECT_EQ(p.format_to(nullptr, 0), via_ostream(p).size());
+}
+
+TEST(FieldWriter, WritesIntegersAndEnums) {
+    std::array<char, 64> buf{};
+    FieldWriter w{buf.data(), buf.size()};
+    w.put(std::int32_t{-12});
+    w.put(' ');
+    w.put(std::uint8_t{200});
+    w.put(' ');
+    w.put(Severity::Error);
+    w.put(' ');
+    w.put(true);
+
+    EXPECT_EQ(std::string(buf.data(), w.written()), "-12 200 Error 1");
+    EXPECT_EQ(w.size(), w.written());
+}
+
+TEST(FieldWriter, FloatingPointMatchesOstream) {
+    for (double v : {0.0, 1.5, 3.14159265, 1e-7, 123456789.0}) {
+        std::array<char, 64> buf{};
+        FieldWriter w{buf.data(), buf.size()};
+        w.put(v);
+
+        std::ostringstream os;
+        os << v;
+        EXPECT_EQ(std::string(buf.data(), w.written()), os.str()) << v;
+    }
+}
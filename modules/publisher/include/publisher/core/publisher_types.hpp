@@ -28,7 +28,9 @@ namespace publisher::core
     {
         Terminal = 0,
         File,
-        Socket
+        Socket,
+        AsyncFile,  // io_uring; falls back to File when unavailable
+        MmapRing    // fixed-size mmap'ed ring file that survives a crash
     };
 
     [[nodiscard]] constexpr std::size_t toIndex(ChannelGroup group) noexcept
@@ -55,6 +57,8 @@ namespace publisher::core
             case SinkKind::Terminal: return "Terminal";
             case SinkKind::File:     return "File";
             case SinkKind::Socket:   return "Socket";
+            case SinkKind::AsyncFile: return "AsyncFile";
+            case SinkKind::MmapRing: return "MmapRing";
             default: return "UnknownSink";
         }
     }
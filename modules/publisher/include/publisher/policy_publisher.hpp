@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <fstream>
+#include <cstddef>
 #include <cstdio>
 #include <utility>
 
@@ -27,6 +28,17 @@ struct PolicyBase {
     //  - publish is synchronous: write_impl must complete before publish returns.
     //  - write_impl MUST NOT store the string_view beyond the call.
     void publish(view_type line) {
+        // Sinks with format_to (TextSink) render into a stack buffer and
+        // skip the std::string; longer lines take the path below.
+        if constexpr (requires(char* dst) { sink_type::format_to(line, dst, std::size_t{}); }) {
+            char buf[sink_type::kStackLine];
+            const std::size_t need = sink_type::format_to(line, buf, sizeof(buf));
+            if (need <= sizeof(buf)) {
+                static_cast<Derived*>(this)->write_impl(view_type{buf, need});
+                return;
+            }
+        }
+
         // 1) Sink formats the input view into a temporary std::string.
         //    Sink is a pure policy type with a static format(...) function.
         std::string msg = sink_type::format(line);
@@ -0,0 +1,146 @@
+//
+// Created by RyszardHalapacz on 17/10/2026.
+//
+
+#ifndef MYSERVER_MMAP_RING_HPP
+#define MYSERVER_MMAP_RING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace publisher::runtime
+{
+    // On-disk layout of a ring file: one page of RingFileHeader, then
+    // `capacity` bytes of frames. Frames never wrap; the space left at the
+    // end of the data area is a padding frame (or, if shorter than a frame
+    // header, simply skipped). Records live between the absolute byte
+    // positions head and tail (head <= tail <= head + capacity).
+    inline constexpr std::array<char, 8> kRingMagic{'M', 'Y', 'S', 'R', 'I', 'N', 'G', '1'};
+    inline constexpr std::uint32_t kRingVersion     = 1;
+    inline constexpr std::size_t   kRingHeaderBytes = 4096;
+
+    // What the records are, for the reader; set by the writer's owner.
+    enum class RingContent : std::uint32_t
+    {
+        Text   = 0,     // formatted records
+        Binary = 1      // logger::codec frames (no file header)
+    };
+
+    struct RingFileHeader
+    {
+        std::array<char, 8> magic = kRingMagic;
+        std::uint32_t version     = kRingVersion;
+        std::uint32_t header_bytes = kRingHeaderBytes;
+        std::uint64_t capacity    = 0;
+        RingContent   content     = RingContent::Text;
+        std::uint32_t reserved    = 0;
+        std::uint64_t head        = 0;  // oldest intact frame
+        std::uint64_t tail        = 0;  // end of the newest complete frame
+    };
+    static_assert(sizeof(RingFileHeader) == 48 && std::is_trivially_copyable_v<RingFileHeader>);
+
+    struct RingFrame
+    {
+        std::uint32_t size  = 0;        // payload bytes
+        std::uint32_t flags = 0;        // kRingPad: filler up to the end of the data area
+        std::uint64_t seq   = 0;
+    };
+    static_assert(sizeof(RingFrame) == 16);
+
+    inline constexpr std::uint32_t kRingPad = 1;
+
+    // Frame header + payload, rounded up to 8 bytes.
+    [[nodiscard]] constexpr std::size_t ring_frame_bytes(std::size_t payload) noexcept
+    {
+        return (sizeof(RingFrame) + payload + 7) & ~std::size_t{7};
+    }
+
+    struct MmapRingConfig
+    {
+        std::string path = "myserver.ring";
+
+        // Data area; the oldest records are overwritten once it is full.
+        std::size_t capacity_bytes = 4u << 20;
+
+        RingContent content = RingContent::Text;
+    };
+
+    // Crash-surviving sink behind MmapRingHandle.
+    //
+    // The ring file is mapped MAP_SHARED, so a write is a memcpy plus two
+    // release stores into the header and needs no syscall; the page cache
+    // keeps the data if the process is killed, even by SIGKILL (not if the
+    // machine goes down — sync() for that). A frame becomes visible only
+    // when tail moves past it, so a write cut short is never read back.
+    //
+    // Reopening a ring with the same capacity keeps its records and
+    // continues the sequence numbers, so a restart does not wipe the
+    // records of the run that crashed. Single writer.
+    class MmapRing
+    {
+    public:
+        MmapRing() = default;
+        ~MmapRing() { close(); }
+
+        MmapRing(const MmapRing&) = delete;
+        MmapRing& operator=(const MmapRing&) = delete;
+
+        // False if the file cannot be created, sized or mapped.
+        [[nodiscard]] bool open(MmapRingConfig cfg);
+        void close() noexcept;
+        [[nodiscard]] bool is_open() const noexcept { return hdr_ != nullptr; }
+
+        void write(std::string_view record) noexcept;
+
+        // msync(MS_ASYNC): only needed to survive power loss.
+        void sync() noexcept;
+
+        [[nodiscard]] const MmapRingConfig& config() const noexcept { return cfg_; }
+        [[nodiscard]] std::uint64_t next_seq()   const noexcept { return seq_; }
+        [[nodiscard]] std::uint64_t written()    const noexcept { return written_; }
+        [[nodiscard]] std::uint64_t overwritten() const noexcept { return overwritten_; }
+        [[nodiscard]] std::uint64_t dropped()    const noexcept { return dropped_; }     // larger than the ring
+
+    private:
+        bool resume() noexcept;
+        void make_room(std::uint64_t end) noexcept;
+        void publish(std::uint64_t& field, std::uint64_t value) noexcept;
+
+        MmapRingConfig cfg_{};
+        RingFileHeader* hdr_{};
+        char* data_{};
+        std::size_t map_bytes_{0};
+        std::uint64_t cap_{0};
+
+        std::uint64_t head_{0};         // writer copies of the header fields
+        std::uint64_t tail_{0};
+        std::uint64_t seq_{0};
+
+        std::uint64_t written_{0};
+        std::uint64_t overwritten_{0};
+        std::uint64_t dropped_{0};
+    };
+
+    struct RingReadSummary
+    {
+        bool          header_ok = false;
+        RingContent   content   = RingContent::Text;
+        std::size_t   records   = 0;
+        bool          corrupt   = false;        // stopped at a frame that does not check out
+        std::uint64_t first_seq = 0;
+        std::uint64_t last_seq  = 0;
+    };
+
+    // Walk the records of a ring file image, oldest first. Works on a
+    // snapshot of a live ring too: frames the writer overwrote while the
+    // snapshot was taken show up as a sequence gap and end the walk.
+    RingReadSummary read_ring(std::string_view file,
+                              const std::function<void(std::uint64_t seq, std::string_view record)>& fn);
+} // namespace publisher::runtime
+
+#endif // MYSERVER_MMAP_RING_HPP
@@ -5,6 +5,7 @@
 #ifndef MYSERVER_PUBLISHER_RUNTIME_HPP
 #define MYSERVER_PUBLISHER_RUNTIME_HPP
 
+#include <span>
 #include <string_view>
 
 #include "publisher/core/publish_token.hpp"
@@ -32,6 +33,19 @@ namespace publisher::runtime
             SinkTraits<publisher::core::SinkKind::Terminal>::write(handle, data);
         }
 
+        // Many records, one sink call; views staged back to back are written
+        // with a single stream write.
+        static void publish_batch(TokenRegistry& registry,
+                                  OutputResourceStore& store,
+                                  publisher::core::PublishToken token,
+                                  std::span<const std::string_view> views) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.terminals[idx];
+
+            SinkTraits<publisher::core::SinkKind::Terminal>::write_batch(handle, views);
+        }
+
         template<typename Derived>
         static void publish(TokenRegistry& registry,
                             OutputResourceStore& store,
@@ -56,6 +70,19 @@ namespace publisher::runtime
             SinkTraits<publisher::core::SinkKind::File>::write(handle, data);
         }
 
+        // Many records, one sink call; views staged back to back are written
+        // with a single stream write.
+        static void publish_batch(TokenRegistry& registry,
+                                  OutputResourceStore& store,
+                                  publisher::core::PublishToken token,
+                                  std::span<const std::string_view> views) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.files[idx];
+
+            SinkTraits<publisher::core::SinkKind::File>::write_batch(handle, views);
+        }
+
         template<typename Derived>
         static void publish(TokenRegistry& registry,
                             OutputResourceStore& store,
@@ -80,6 +107,93 @@ namespace publisher::runtime
             SinkTraits<publisher::core::SinkKind::Socket>::write(handle, data);
         }
 
+        // Many records, one sink call; the batch is queued and sent with a
+        // single non-blocking sendmsg.
+        static void publish_batch(TokenRegistry& registry,
+                                  OutputResourceStore& store,
+                                  publisher::core::PublishToken token,
+                                  std::span<const std::string_view> views) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.sockets[idx];
+
+            SinkTraits<publisher::core::SinkKind::Socket>::write_batch(handle, views);
+        }
+
+        template<typename Derived>
+        static void publish(TokenRegistry& registry,
+                            OutputResourceStore& store,
+                            publisher::core::PublishToken token,
+                            const Derived& obj) noexcept
+        {
+            publish_view(registry, store, token, obj.payload());
+        }
+    };
+
+    template<>
+    struct PublisherRuntime<publisher::core::SinkKind::AsyncFile>
+    {
+        static void publish_view(TokenRegistry& registry,
+                                 OutputResourceStore& store,
+                                 publisher::core::PublishToken token,
+                                 std::string_view data) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.async_files[idx];
+
+            SinkTraits<publisher::core::SinkKind::AsyncFile>::write(handle, data);
+        }
+
+        // Many records, one sink call; the batch is handed to io_uring
+        // without waiting for it to reach the disk.
+        static void publish_batch(TokenRegistry& registry,
+                                  OutputResourceStore& store,
+                                  publisher::core::PublishToken token,
+                                  std::span<const std::string_view> views) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.async_files[idx];
+
+            SinkTraits<publisher::core::SinkKind::AsyncFile>::write_batch(handle, views);
+        }
+
+        template<typename Derived>
+        static void publish(TokenRegistry& registry,
+                            OutputResourceStore& store,
+                            publisher::core::PublishToken token,
+                            const Derived& obj) noexcept
+        {
+            publish_view(registry, store, token, obj.payload());
+        }
+    };
+
+    template<>
+    struct PublisherRuntime<publisher::core::SinkKind::MmapRing>
+    {
+        static void publish_view(TokenRegistry& registry,
+                                 OutputResourceStore& store,
+                                 publisher::core::PublishToken token,
+                                 std::string_view data) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.mmap_rings[idx];
+
+            SinkTraits<publisher::core::SinkKind::MmapRing>::write(handle, data);
+        }
+
+        // Many records, one sink call; each record is copied into the
+        // mapped ring as its own frame.
+        static void publish_batch(TokenRegistry& registry,
+                                  OutputResourceStore& store,
+                                  publisher::core::PublishToken token,
+                                  std::span<const std::string_view> views) noexcept
+        {
+            const auto idx = registry.resolve(token);
+            auto& handle = store.mmap_rings[idx];
+
+            SinkTraits<publisher::core::SinkKind::MmapRing>::write_batch(handle, views);
+        }
+
         template<typename Derived>
         static void publish(TokenRegistry& registry,
                             OutputResourceStore& store,
@@ -21,6 +21,8 @@ namespace publisher::runtime
         std::array<TerminalHandle, kChannelCount> terminals{};
         std::array<FileHandle,     kChannelCount> files{};
         std::array<SocketHandle,   kChannelCount> sockets{};
+        std::array<AsyncFileHandle, kChannelCount> async_files{};
+        std::array<MmapRingHandle, kChannelCount> mmap_rings{};
     };
 } // namespace publisher::runtime
 
@@ -0,0 +1,105 @@
+//
+// Created by RyszardHalapacz on 17/10/2026.
+//
+
+#ifndef MYSERVER_ROTATING_FILE_HPP
+#define MYSERVER_ROTATING_FILE_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace publisher::runtime
+{
+    struct FileSinkConfig
+    {
+        std::string path = "myserver.log";
+
+        // Userspace buffer; records are copied here and reach the file in
+        // buffer-sized writes, or sooner once flush_interval has passed.
+        std::size_t buffer_bytes = 1u << 20;
+        std::chrono::milliseconds flush_interval{100};
+
+        // Rotation: the live file becomes path.1 (path.1 -> path.2, ...) when
+        // it would grow past rotate_bytes or is older than rotate_age.
+        // 0 disables either trigger. keep_files = 0 keeps no old files.
+        std::uint64_t rotate_bytes = 0;
+        std::chrono::seconds rotate_age{0};
+        std::size_t keep_files = 5;
+
+        // Written at the start of every new file (e.g. a binary log header).
+        std::string header;
+    };
+
+    // Buffered, rotating file writer behind FileHandle::writer.
+    //
+    // Single writer: only the thread that publishes (the logger worker)
+    // calls into it, so producers never wait on disk I/O or a rotation.
+    // Records are never split across files.
+    class RotatingFile
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        RotatingFile() = default;
+        ~RotatingFile() { close(); }
+
+        RotatingFile(const RotatingFile&) = delete;
+        RotatingFile& operator=(const RotatingFile&) = delete;
+
+        // Appends to cfg.path (creating it); false if it cannot be opened.
+        [[nodiscard]] bool open(FileSinkConfig cfg);
+        void close() noexcept;
+        [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+        void write(std::string_view record, clock::time_point now) noexcept;
+        void write(std::string_view record) noexcept { write(record, clock::now()); }
+
+        // Flush if flush_interval has passed, rotate if rotate_age has.
+        void tick(clock::time_point now) noexcept;
+        void flush() noexcept;
+
+        // When tick() will next flush whatever is buffered.
+        [[nodiscard]] clock::time_point flush_due() const noexcept { return last_flush_ + cfg_.flush_interval; }
+
+        [[nodiscard]] const FileSinkConfig& config() const noexcept { return cfg_; }
+        [[nodiscard]] std::size_t   buffered()      const noexcept { return used_; }
+        [[nodiscard]] std::uint64_t file_bytes()    const noexcept { return file_bytes_; }
+        [[nodiscard]] std::uint64_t bytes_written() const noexcept { return bytes_written_; }
+        [[nodiscard]] std::uint64_t flushes()       const noexcept { return flushes_; }
+        [[nodiscard]] std::uint64_t rotations()     const noexcept { return rotations_; }
+        [[nodiscard]] std::uint64_t write_errors()  const noexcept { return write_errors_; }
+
+    private:
+        struct AlignedDelete
+        {
+            void operator()(char* p) const noexcept;
+        };
+
+        bool open_file() noexcept;
+        bool rotation_due(std::size_t incoming, clock::time_point now) const noexcept;
+        void rotate(clock::time_point now) noexcept;
+        void write_all(const char* p, std::size_t n) noexcept;
+
+        FileSinkConfig cfg_{};
+        int fd_{-1};
+
+        std::unique_ptr<char[], AlignedDelete> buf_;
+        std::size_t cap_{0};
+        std::size_t used_{0};
+
+        std::uint64_t file_bytes_{0};           // in the live file, excluding buf_
+        clock::time_point opened_at_{};
+        clock::time_point last_flush_{};
+
+        std::uint64_t bytes_written_{0};
+        std::uint64_t flushes_{0};
+        std::uint64_t rotations_{0};
+        std::uint64_t write_errors_{0};
+    };
+} // namespace publisher::runtime
+
+#endif // MYSERVER_ROTATING_FILE_HPP
@@ -10,19 +10,36 @@
 
 namespace publisher::runtime {
 
+    class MmapRing;
+    class RotatingFile;
+    class SocketSink;
+    class UringFile;
+
     struct TerminalHandle
     {
         std::ostream* out{};
     };
 
+    // writer, when set, takes precedence over file.
     struct FileHandle
     {
         std::fstream* file{};
+        RotatingFile* writer{};
     };
 
     struct SocketHandle
     {
-        int fakeFd{-1};
+        SocketSink* sink{};
+    };
+
+    struct AsyncFileHandle
+    {
+        UringFile* writer{};
+    };
+
+    struct MmapRingHandle
+    {
+        MmapRing* ring{};
     };
 }
 #endif //MYSERVER_SINK_HANDLES_HPP
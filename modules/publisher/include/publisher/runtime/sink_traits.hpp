@@ -6,13 +6,39 @@
 #define MYSERVER_SINK_TRAITS_HPP
 
 #include <cassert>
+#include <span>
 #include <string_view>
 
 #include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/mmap_ring.hpp"
+#include "publisher/runtime/rotating_file.hpp"
 #include "publisher/runtime/sink_handles.hpp"
+#include "publisher/runtime/socket_sink.hpp"
+#include "publisher/runtime/uring_file.hpp"
 
 namespace publisher::runtime
 {
+    namespace detail
+    {
+        // Calls write(ptr, len) once per run of views that sit back to back
+        // in memory — a batch staged in one buffer becomes a single write.
+        template<typename Write>
+        void for_each_contiguous_run(std::span<const std::string_view> views, Write&& write)
+        {
+            std::size_t i = 0;
+            while (i < views.size())
+            {
+                const char* begin = views[i].data();
+                const char* end   = begin + views[i].size();
+                for (++i; i < views.size() && views[i].data() == end; ++i)
+                    end += views[i].size();
+
+                if (end != begin)
+                    write(begin, static_cast<std::size_t>(end - begin));
+            }
+        }
+    } // namespace detail
+
     template<publisher::core::SinkKind Sink>
     struct SinkTraits;
 
@@ -26,6 +52,14 @@ namespace publisher::runtime
             assert(handle.out != nullptr && "TerminalHandle: null stream");
             handle.out->write(data.data(), static_cast<std::streamsize>(data.size()));
         }
+
+        static void write_batch(handle_type& handle, std::span<const std::string_view> views) noexcept
+        {
+            assert(handle.out != nullptr && "TerminalHandle: null stream");
+            detail::for_each_contiguous_run(views, [&](const char* p, std::size_t n) {
+                handle.out->write(p, static_cast<std::streamsize>(n));
+            });
+        }
     };
 
     template<>
@@ -35,9 +69,33 @@ namespace publisher::runtime
 
         static void write(handle_type& handle, std::string_view data) noexcept
         {
+            if (handle.writer)
+            {
+                handle.writer->write(data);
+                return;
+            }
+
             assert(handle.file != nullptr && "FileHandle: null stream");
             handle.file->write(data.data(), static_cast<std::streamsize>(data.size()));
         }
+
+        // RotatingFile gets one record at a time (they are copied into its
+        // buffer anyway), so a rotation never splits a record.
+        static void write_batch(handle_type& handle, std::span<const std::string_view> views) noexcept
+        {
+            if (handle.writer)
+            {
+                const auto now = RotatingFile::clock::now();
+                for (std::string_view v : views)
+                    handle.writer->write(v, now);
+                return;
+            }
+
+            assert(handle.file != nullptr && "FileHandle: null stream");
+            detail::for_each_contiguous_run(views, [&](const char* p, std::size_t n) {
+                handle.file->write(p, static_cast<std::streamsize>(n));
+            });
+        }
     };
 
     template<>
@@ -47,12 +105,78 @@ namespace publisher::runtime
 
         static void write(handle_type& handle, std::string_view data) noexcept
         {
-            assert(handle.fakeFd >= 0 && "SocketHandle: invalid fd");
-            (void)handle;
-            (void)data;
-            // TODO: real socket write
+            assert(handle.sink != nullptr && "SocketHandle: null sink");
+            const auto now = SocketSink::clock::now();
+            handle.sink->write(data, now);
+            handle.sink->pump(now);
+        }
+
+        // Records are queued in the sink's send ring (dropped if it is
+        // full), then everything queued goes out in one sendmsg.
+        static void write_batch(handle_type& handle, std::span<const std::string_view> views) noexcept
+        {
+            assert(handle.sink != nullptr && "SocketHandle: null sink");
+            const auto now = SocketSink::clock::now();
+            for (std::string_view v : views)
+                handle.sink->write(v, now);
+            handle.sink->pump(now);
+        }
+    };
+
+    template<>
+    struct SinkTraits<publisher::core::SinkKind::AsyncFile>
+    {
+        using handle_type = AsyncFileHandle;
+
+        static void write(handle_type& handle, std::string_view data) noexcept
+        {
+            assert(handle.writer != nullptr && "AsyncFileHandle: null writer");
+            if (!handle.writer->async())
+            {
+                FileHandle sync{nullptr, &handle.writer->fallback()};
+                SinkTraits<publisher::core::SinkKind::File>::write(sync, data);
+                return;
+            }
+            handle.writer->write(data);
+        }
+
+        // Records are copied into the ring's buffers; full buffers are
+        // submitted as they fill, a partial one once the disk is idle.
+        static void write_batch(handle_type& handle, std::span<const std::string_view> views) noexcept
+        {
+            assert(handle.writer != nullptr && "AsyncFileHandle: null writer");
+            if (!handle.writer->async())
+            {
+                FileHandle sync{nullptr, &handle.writer->fallback()};
+                SinkTraits<publisher::core::SinkKind::File>::write_batch(sync, views);
+                return;
+            }
+            for (std::string_view v : views)
+                handle.writer->write(v);
+            handle.writer->kick();
+        }
+    };
+
+    template<>
+    struct SinkTraits<publisher::core::SinkKind::MmapRing>
+    {
+        using handle_type = MmapRingHandle;
+
+        static void write(handle_type& handle, std::string_view data) noexcept
+        {
+            assert(handle.ring != nullptr && "MmapRingHandle: null ring");
+            handle.ring->write(data);
+        }
+
+        // One frame per record, so the reader gets the records back one by
+        // one; no syscalls either way.
+        static void write_batch(handle_type& handle, std::span<const std::string_view> views) noexcept
+        {
+            assert(handle.ring != nullptr && "MmapRingHandle: null ring");
+            for (std::string_view v : views)
+                handle.ring->write(v);
         }
     };
 } // namespace publisher::runtime
 
-#endif // MYSERVER_SINK_TRAITS_HPP
+#endif // MYSERVER_SINK_TRAITS_HPP
@@ -0,0 +1,164 @@
+//
+// Created by RyszardHalapacz on 17/10/2026.
+//
+
+#ifndef MYSERVER_SOCKET_SINK_HPP
+#define MYSERVER_SOCKET_SINK_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace publisher::runtime
+{
+    struct SocketSinkConfig
+    {
+        enum class Transport : std::uint8_t { Tcp, Unix };
+
+        Transport transport = Transport::Tcp;
+        std::string address = "127.0.0.1";     // IPv4 address, or socket path for Unix
+        std::uint16_t port = 5170;
+
+        // Send ring: records wait here while the collector is slow or
+        // away. A record that does not fit is dropped, never blocked on.
+        std::size_t ring_bytes = 1u << 20;
+        std::size_t max_records = 16384;
+
+        // Reconnect delay doubles from backoff_min up to backoff_max.
+        std::chrono::milliseconds backoff_min{10};
+        std::chrono::milliseconds backoff_max{5000};
+
+        // TCP only: sends of at least zerocopy_min bytes use MSG_ZEROCOPY;
+        // their ring space is reused once the kernel reports completion.
+        bool zerocopy = false;
+        std::size_t zerocopy_min = 16 * 1024;
+
+        // How long an owner's shutdown may wait in drain() for queued
+        // records to go out.
+        std::chrono::milliseconds linger{200};
+    };
+
+    struct SocketSinkStats
+    {
+        std::uint64_t sent_bytes       = 0;
+        std::uint64_t sent_records     = 0;
+        std::uint64_t dropped_records  = 0;     // ring full
+        std::uint64_t dropped_bytes    = 0;
+        std::uint64_t torn_records     = 0;     // connection lost mid-record
+        std::uint64_t connects         = 0;
+        std::uint64_t connect_failures = 0;
+        std::uint64_t disconnects      = 0;
+        std::uint64_t writev_calls     = 0;
+        std::uint64_t zerocopy_sends   = 0;
+        std::uint64_t zerocopy_copied  = 0;     // kernel fell back to copying
+    };
+
+    // Non-blocking stream-socket sink behind SocketHandle.
+    //
+    // write() only copies the record into a bounded byte ring; pump() sends
+    // everything queued with one sendmsg of up to two iovecs (the ring may
+    // wrap), MSG_DONTWAIT. While the collector is slow or disconnected,
+    // records wait in the ring until it is full and are then dropped and
+    // counted. Reconnects are attempted from pump() with exponential
+    // backoff, and a new connection always starts on a record boundary.
+    // Single writer, like RotatingFile.
+    class SocketSink
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        SocketSink() = default;
+        ~SocketSink() { close(); }
+
+        SocketSink(const SocketSink&) = delete;
+        SocketSink& operator=(const SocketSink&) = delete;
+
+        // False only for an unusable config (bad address, sizes of 0); an
+        // absent collector is not an error.
+        [[nodiscard]] bool open(SocketSinkConfig cfg);
+        void close() noexcept;
+
+        void write(std::string_view record, clock::time_point now) noexcept;
+        void write(std::string_view record) noexcept { write(record, clock::now()); }
+
+        static constexpr std::chrono::milliseconds kProbeInterval{1};
+
+        // Connect / reconnect when due, send what the socket accepts, reap
+        // zerocopy completions; with nothing to send, check (at most every
+        // kProbeInterval) whether the collector has closed. Never blocks.
+        void pump(clock::time_point now) noexcept;
+        void pump() noexcept { pump(clock::now()); }
+
+        // Pump until the ring is empty or timeout passes (shutdown); true
+        // if everything was handed to the kernel.
+        bool drain(std::chrono::milliseconds timeout) noexcept;
+
+        [[nodiscard]] bool connected() const noexcept { return state_ == State::Connected; }
+        [[nodiscard]] std::size_t queued_bytes() const noexcept { return static_cast<std::size_t>(tail_ - release_); }
+        [[nodiscard]] std::size_t unsent_bytes() const noexcept { return static_cast<std::size_t>(tail_ - sent_); }
+        [[nodiscard]] const SocketSinkStats& stats() const noexcept { return stats_; }
+        [[nodiscard]] const SocketSinkConfig& config() const noexcept { return cfg_; }
+
+    private:
+        enum class State : std::uint8_t { Closed, Connecting, Connected };
+
+        // One MSG_ZEROCOPY send whose ring bytes are still owned by the
+        // kernel, or a copied send queued behind one.
+        struct PendingSend
+        {
+            std::uint64_t end{0};       // ring position just past the send
+            std::uint32_t id{0};
+            bool          zerocopy{false};
+            bool          done{false};
+        };
+
+        void start_connect(clock::time_point now) noexcept;
+        void finish_connect(clock::time_point now) noexcept;
+        void on_connected() noexcept;
+        void on_connect_failed(clock::time_point now) noexcept;
+        void drop_connection(clock::time_point now) noexcept;
+        void probe_peer(clock::time_point now) noexcept;
+        void send_some(clock::time_point now) noexcept;
+        void reap_zerocopy() noexcept;
+        void account_sent() noexcept;
+
+        SocketSinkConfig cfg_{};
+        int fd_{-1};
+        State state_{State::Closed};
+        bool zerocopy_on_{false};
+
+        clock::time_point next_attempt_{};
+        clock::time_point connect_started_{};
+        clock::time_point last_probe_{};
+        std::chrono::milliseconds backoff_{0};
+
+        // Byte ring; positions only grow: release_ <= sent_ <= tail_.
+        std::unique_ptr<char[]> ring_;
+        std::size_t cap_{0};
+        std::uint64_t release_{0};      // reusable below this
+        std::uint64_t sent_{0};         // handed to the kernel below this
+        std::uint64_t tail_{0};         // written below this
+
+        // End positions of records not yet fully sent, oldest first;
+        // rec_start_ is where the oldest of them begins.
+        std::vector<std::uint64_t> ends_;
+        std::size_t ends_head_{0};
+        std::size_t ends_count_{0};
+        std::uint64_t rec_start_{0};
+
+        static constexpr std::size_t kMaxPending = 64;
+        std::array<PendingSend, kMaxPending> pending_{};
+        std::size_t pending_head_{0};
+        std::size_t pending_count_{0};
+        std::uint32_t next_zc_id_{0};
+
+        SocketSinkStats stats_{};
+    };
+} // namespace publisher::runtime
+
+#endif // MYSERVER_SOCKET_SINK_HPP
@@ -0,0 +1,136 @@
+//
+// Created by RyszardHalapacz on 17/10/2026.
+//
+
+#ifndef MYSERVER_URING_FILE_HPP
+#define MYSERVER_URING_FILE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "publisher/runtime/rotating_file.hpp"
+
+namespace publisher::runtime
+{
+    struct AsyncFileConfig
+    {
+        std::string path = "myserver.log";
+
+        // Records are copied into one of `buffers` registered buffers; a
+        // full buffer is submitted as one write and reused on completion.
+        std::size_t buffer_bytes = 256 * 1024;
+        std::size_t buffers = 8;
+
+        // Written at the start of the file when it is created.
+        std::string header;
+
+        // Skip io_uring and use the synchronous fallback (testing, or
+        // kernels/sandboxes where io_uring is disabled by policy).
+        bool force_sync = false;
+    };
+
+    // Asynchronous file writer on io_uring, behind AsyncFileHandle.
+    //
+    // Uses registered buffers (IORING_OP_WRITE_FIXED) and a registered file
+    // when the kernel allows it, plain IORING_OP_WRITE otherwise. The
+    // caller never waits for storage: completions are reaped without
+    // blocking, and a record that finds every buffer still in flight is
+    // dropped and counted. Single writer, like RotatingFile.
+    //
+    // If io_uring cannot be set up, open() opens a RotatingFile on the same
+    // path instead and async() is false; SinkTraits<AsyncFile> then takes
+    // the synchronous SinkTraits<File> path through fallback().
+    class UringFile
+    {
+    public:
+        UringFile();
+        ~UringFile();
+
+        UringFile(const UringFile&) = delete;
+        UringFile& operator=(const UringFile&) = delete;
+
+        // False only if the file cannot be opened at all.
+        [[nodiscard]] bool open(AsyncFileConfig cfg);
+        void close() noexcept;
+        [[nodiscard]] bool is_open() const noexcept;
+
+        [[nodiscard]] bool async() const noexcept { return ring_ != nullptr; }
+        [[nodiscard]] RotatingFile& fallback() noexcept { return fallback_; }
+
+        void write(std::string_view record) noexcept;
+
+        // Submit the partly filled buffer and reap finished writes; does
+        // not wait.
+        void flush() noexcept;
+
+        // Like flush(), but only submits the partial buffer when nothing is
+        // in flight, so under a slow disk records coalesce into full
+        // buffers instead of using one buffer per batch.
+        void kick() noexcept;
+
+        // Wait until every submitted write has completed (shutdown).
+        void drain() noexcept;
+
+        [[nodiscard]] std::uint64_t bytes_written() const noexcept { return bytes_written_; }
+        [[nodiscard]] std::uint64_t submits()       const noexcept { return submits_; }
+        // Readable from any thread (LogEngine::file_dropped).
+        [[nodiscard]] std::uint64_t dropped()       const noexcept { return dropped_.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::uint64_t write_errors()  const noexcept { return write_errors_; }
+        [[nodiscard]] std::size_t   in_flight()     const noexcept { return in_flight_; }
+        [[nodiscard]] bool registered_buffers()     const noexcept { return fixed_buffers_; }
+        [[nodiscard]] bool registered_file()        const noexcept { return fixed_file_; }
+
+    private:
+        struct Ring;
+        struct AlignedDelete
+        {
+            void operator()(char* p) const noexcept;
+        };
+
+        struct Buffer
+        {
+            char*         data{};
+            std::size_t   len{0};       // bytes filled
+            std::size_t   done{0};      // bytes the kernel has written
+            std::uint64_t offset{0};
+            bool          in_flight{false};
+        };
+
+        bool setup_ring() noexcept;
+        bool acquire_current() noexcept;
+        void submit(std::size_t idx) noexcept;
+        void reap(bool wait) noexcept;
+        std::size_t free_bytes() const noexcept;
+
+        AsyncFileConfig cfg_{};
+        int fd_{-1};
+        bool seekable_{true};
+
+        std::unique_ptr<Ring> ring_;
+        bool fixed_buffers_{false};
+        bool fixed_file_{false};
+
+        std::unique_ptr<char[], AlignedDelete> arena_;
+        std::vector<Buffer> bufs_;
+        std::vector<std::size_t> free_;
+        std::size_t current_{kNone};
+        std::size_t in_flight_{0};
+        std::uint64_t next_offset_{0};
+
+        RotatingFile fallback_;
+
+        std::uint64_t bytes_written_{0};
+        std::uint64_t submits_{0};
+        std::atomic<std::uint64_t> dropped_{0};     // written by the single writer only
+        std::uint64_t write_errors_{0};
+
+        static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+    };
+} // namespace publisher::runtime
+
+#endif // MYSERVER_URING_FILE_HPP
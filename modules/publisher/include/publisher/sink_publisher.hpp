@@ -2,6 +2,8 @@
 // SinkBase + concrete sinks
 ///////////////////////////////////////
 #pragma once
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -17,16 +19,37 @@ struct SinkBase {
     }
 };
 
-// JSON sink
+// JSON sink: a line in the debug_print shape, "[tag=N] key=value ...",
+// becomes one object, {"tag":"<MsgTag name>","key":value,...}. A value
+// that is a JSON number stays a number, anything else is an escaped
+// string; a word without '=' belongs to the value before it, and text
+// before the first key goes to "msg".
 struct JsonSink : SinkBase<JsonSink> {
     using view_type = std::string_view;
     static std::string format_impl(view_type line);
+
+    // Same JSON into [dst, dst + cap), no allocation. Returns the length
+    // the whole object needs; anything past cap is cut off.
+    static std::size_t format_to(view_type line, char* dst, std::size_t cap);
+
+    // Lines up to this long are formatted on the stack.
+    static constexpr std::size_t kStackLine = 2048;
 };
 
-// TEXT sink
+// TEXT sink: timestamp=<us since epoch> becomes a local date and time,
+// class_id= and method_id= become names.
 struct TextSink : SinkBase<TextSink> {
     using view_type = std::string_view;
     static std::string format_impl(view_type line);
+
+    // Same text into [dst, dst + cap), no allocation. Returns the length
+    // the whole text needs; anything past cap is cut off.
+    static std::size_t format_to(view_type line, char* dst, std::size_t cap);
+
+    // Lines up to this long are formatted on the stack.
+    static constexpr std::size_t kStackLine = 2048;
+
 private:
-    static std::string format_timestamp_us(std::uint64_t us_since_epoch);
+    static constexpr std::size_t kTimestampBytes = 40;
+    static std::size_t render_timestamp_us(std::uint64_t us_since_epoch, char* out);
 };
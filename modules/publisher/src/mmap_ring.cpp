@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "publisher/runtime/mmap_ring.hpp"
+
+namespace publisher::runtime
+{
+
+bool MmapRing::open(MmapRingConfig cfg)
+{
+    close();
+
+    cfg_ = std::move(cfg);
+    cap_ = (std::max<std::uint64_t>(cfg_.capacity_bytes, 2 * sizeof(RingFrame)) + 7) & ~std::uint64_t{7};
+    const std::size_t bytes = kRingHeaderBytes + static_cast<std::size_t>(cap_);
+
+    const int fd = ::open(cfg_.path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return false;
+
+    struct stat st{};
+    bool ok = ::fstat(fd, &st) == 0;
+    if (ok && static_cast<std::size_t>(st.st_size) != bytes)
+        ok = ::ftruncate(fd, static_cast<off_t>(bytes)) == 0;
+
+    // Reserve the blocks now: a store into a hole the filesystem cannot
+    // fill later would be a SIGBUS, not an error code.
+    if (ok)
+    {
+        const int err = ::posix_fallocate(fd, 0, static_cast<off_t>(bytes));
+        ok = err == 0 || err == EOPNOTSUPP || err == EINVAL;
+    }
+
+    void* base = ok ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (base == MAP_FAILED)
+        return false;
+
+    map_bytes_ = bytes;
+    hdr_  = static_cast<RingFileHeader*>(base);
+    data_ = static_cast<char*>(base) + kRingHeaderBytes;
+
+    if (!resume())
+    {
+        *hdr_ = RingFileHeader{};
+        hdr_->capacity = cap_;
+        hdr_->content  = cfg_.content;
+        head_ = tail_ = seq_ = 0;
+    }
+    written_ = overwritten_ = dropped_ = 0;
+    return true;
+}
+
+// Keep the records of a previous run if the file is an intact ring of the
+// same shape.
+bool MmapRing::resume() noexcept
+{
+    if (hdr_->capacity != cap_ || hdr_->content != cfg_.content)
+        return false;
+
+    const std::string_view image(reinterpret_cast<const char*>(hdr_), map_bytes_);
+    const auto sum = read_ring(image, [](std::uint64_t, std::string_view) {});
+    if (!sum.header_ok || sum.corrupt)
+        return false;
+
+    head_ = hdr_->head;
+    tail_ = hdr_->tail;
+    seq_  = sum.records ? sum.last_seq + 1 : 0;
+    return true;
+}
+
+void MmapRing::close() noexcept
+{
+    if (!hdr_)
+        return;
+    ::munmap(hdr_, map_bytes_);
+    hdr_  = nullptr;
+    data_ = nullptr;
+}
+
+void MmapRing::write(std::string_view record) noexcept
+{
+    if (!hdr_)
+        return;
+
+    const std::uint64_t need = ring_frame_bytes(record.size());
+    if (need > cap_ || record.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        ++dropped_;
+        return;
+    }
+
+    std::uint64_t off = tail_ % cap_;
+    const std::uint64_t rem = cap_ - off;
+    if (rem < need)
+    {
+        // Frames never wrap: pad out the end of the data area first.
+        make_room(tail_ + rem);
+        if (rem >= sizeof(RingFrame))
+        {
+            const RingFrame pad{static_cast<std::uint32_t>(rem - sizeof(RingFrame)), kRingPad, 0};
+            std::memcpy(data_ + off, &pad, sizeof(pad));
+        }
+        tail_ += rem;
+        publish(hdr_->tail, tail_);
+        off = 0;
+    }
+
+    make_room(tail_ + need);
+
+    const RingFrame frame{static_cast<std::uint32_t>(record.size()), 0, seq_};
+    std::memcpy(data_ + off, &frame, sizeof(frame));
+    std::memcpy(data_ + off + sizeof(frame), record.data(), record.size());
+
+    tail_ += need;
+    ++seq_;
+    ++written_;
+    publish(hdr_->tail, tail_);
+}
+
+void MmapRing::sync() noexcept
+{
+    if (hdr_)
+        ::msync(hdr_, map_bytes_, MS_ASYNC);
+}
+
+// Move head past every frame the next `end - tail_` bytes will overwrite.
+// head is published before those bytes are touched, so the header never
+// points at a frame that is half overwritten.
+void MmapRing::make_room(std::uint64_t end) noexcept
+{
+    std::uint64_t head = head_;
+    while (end - head > cap_)
+    {
+        const std::uint64_t off = head % cap_;
+        const std::uint64_t rem = cap_ - off;
+        if (rem < sizeof(RingFrame))
+        {
+            head += rem;
+            continue;
+        }
+
+        RingFrame f{};
+        std::memcpy(&f, data_ + off, sizeof(f));
+        if (!(f.flags & kRingPad))
+            ++overwritten_;
+        head += ring_frame_bytes(f.size);
+    }
+
+    if (head != head_)
+    {
+        head_ = head;
+        publish(hdr_->head, head);
+    }
+}
+
+void MmapRing::publish(std::uint64_t& field, std::uint64_t value) noexcept
+{
+    std::atomic_ref<std::uint64_t>(field).store(value, std::memory_order_release);
+}
+
+RingReadSummary read_ring(std::string_view file,
+                          const std::function<void(std::uint64_t, std::string_view)>& fn)
+{
+    RingReadSummary sum{};
+    RingFileHeader h{};
+    if (file.size() < sizeof(h))
+        return sum;
+    std::memcpy(&h, file.data(), sizeof(h));
+
+    if (h.magic != kRingMagic || h.version != kRingVersion || h.header_bytes < sizeof(h) ||
+        file.size() < h.header_bytes || h.capacity == 0 || h.capacity % 8 ||
+        file.size() - h.header_bytes < h.capacity || h.tail < h.head || h.tail - h.head > h.capacity)
+        return sum;
+
+    sum.header_ok = true;
+    sum.content   = h.content;
+
+    const char* data = file.data() + h.header_bytes;
+    std::uint64_t pos = h.head;
+    while (pos < h.tail)
+    {
+        const std::uint64_t off = pos % h.capacity;
+        const std::uint64_t rem = h.capacity - off;
+        if (rem < sizeof(RingFrame))
+        {
+            pos += rem;
+            continue;
+        }
+
+        RingFrame f{};
+        std::memcpy(&f, data + off, sizeof(f));
+        const std::uint64_t bytes = ring_frame_bytes(f.size);
+        const bool pad = f.flags & kRingPad;
+        if (bytes > rem || bytes > h.tail - pos || (pad && bytes != rem) ||
+            (!pad && sum.records && f.seq != sum.last_seq + 1))
+        {
+            sum.corrupt = true;
+            break;
+        }
+
+        if (!pad)
+        {
+            if (sum.records++ == 0)
+                sum.first_seq = f.seq;
+            sum.last_seq = f.seq;
+            fn(f.seq, std::string_view(data + off + sizeof(f), f.size));
+        }
+        pos += bytes;
+    }
+    return sum;
+}
+
+} // namespace publisher::runtime
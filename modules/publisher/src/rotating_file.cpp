@@ -0,0 +1,181 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "publisher/runtime/rotating_file.hpp"
+
+namespace publisher::runtime
+{
+
+namespace
+{
+    // Page-aligned so a full-buffer write() hands the kernel whole pages.
+    constexpr std::size_t kBufferAlign = 4096;
+
+    std::string rotated_name(const std::string& path, std::size_t n)
+    {
+        return path + '.' + std::to_string(n);
+    }
+}
+
+void RotatingFile::AlignedDelete::operator()(char* p) const noexcept
+{
+    ::operator delete[](p, std::align_val_t{kBufferAlign});
+}
+
+bool RotatingFile::open(FileSinkConfig cfg)
+{
+    close();
+
+    cfg_ = std::move(cfg);
+    cap_ = cfg_.buffer_bytes ? cfg_.buffer_bytes : 1;
+    buf_.reset(static_cast<char*>(::operator new[](cap_, std::align_val_t{kBufferAlign})));
+    used_ = 0;
+
+    return open_file();
+}
+
+bool RotatingFile::open_file() noexcept
+{
+    fd_ = ::open(cfg_.path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+        return false;
+
+    struct stat st{};
+    file_bytes_ = ::fstat(fd_, &st) == 0 ? static_cast<std::uint64_t>(st.st_size) : 0;
+    opened_at_  = clock::now();
+    last_flush_ = opened_at_;
+
+    // Appending to an existing file keeps its header.
+    if (file_bytes_ == 0 && !cfg_.header.empty())
+        write_all(cfg_.header.data(), cfg_.header.size());
+    return true;
+}
+
+void RotatingFile::close() noexcept
+{
+    if (fd_ < 0)
+        return;
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+}
+
+void RotatingFile::write(std::string_view record, clock::time_point now) noexcept
+{
+    if (fd_ < 0)
+        return;
+
+    if (rotation_due(record.size(), now))
+        rotate(now);
+
+    if (record.size() > cap_ - used_)
+        flush();
+
+    // Larger than the whole buffer: bypass it.
+    if (record.size() > cap_)
+        write_all(record.data(), record.size());
+    else
+    {
+        std::memcpy(buf_.get() + used_, record.data(), record.size());
+        used_ += record.size();
+    }
+
+    if (now - last_flush_ >= cfg_.flush_interval)
+        flush();
+}
+
+void RotatingFile::tick(clock::time_point now) noexcept
+{
+    if (fd_ < 0)
+        return;
+
+    if (rotation_due(0, now))
+        rotate(now);
+    else if (used_ && now - last_flush_ >= cfg_.flush_interval)
+        flush();
+}
+
+void RotatingFile::flush() noexcept
+{
+    last_flush_ = clock::now();
+    if (fd_ < 0 || used_ == 0)
+        return;
+
+    write_all(buf_.get(), used_);
+    used_ = 0;
+    ++flushes_;
+}
+
+bool RotatingFile::rotation_due(std::size_t incoming, clock::time_point now) const noexcept
+{
+    // A file holding nothing but its header is never rotated away.
+    const std::uint64_t size = file_bytes_ + used_;
+    if (size <= cfg_.header.size())
+        return false;
+
+    if (cfg_.rotate_bytes && size + incoming > cfg_.rotate_bytes)
+        return true;
+    return cfg_.rotate_age.count() && now - opened_at_ >= cfg_.rotate_age;
+}
+
+// path.(keep-1) -> path.keep, ..., path -> path.1, then a fresh path.
+void RotatingFile::rotate(clock::time_point now) noexcept
+{
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+
+    try
+    {
+        if (cfg_.keep_files == 0)
+            ::unlink(cfg_.path.c_str());
+        else
+        {
+            for (std::size_t i = cfg_.keep_files; i > 1; --i)
+                std::rename(rotated_name(cfg_.path, i - 1).c_str(), rotated_name(cfg_.path, i).c_str());
+            std::rename(cfg_.path.c_str(), rotated_name(cfg_.path, 1).c_str());
+        }
+    }
+    catch (...)
+    {
+        // Name building ran out of memory; keep writing to the same file.
+        ++write_errors_;
+    }
+
+    if (!open_file())
+    {
+        ++write_errors_;
+        return;
+    }
+    opened_at_ = now;
+    ++rotations_;
+}
+
+void RotatingFile::write_all(const char* p, std::size_t n) noexcept
+{
+    while (n)
+    {
+        const ssize_t w = ::write(fd_, p, n);
+        if (w < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            // Disk full / I/O error: drop the rest rather than stall the worker.
+            ++write_errors_;
+            return;
+        }
+        p += w;
+        n -= static_cast<std::size_t>(w);
+        file_bytes_    += static_cast<std::uint64_t>(w);
+        bytes_written_ += static_cast<std::uint64_t>(w);
+    }
+}
+
+} // namespace publisher::runtime
@@ -1,99 +1,304 @@
-#include <sstream>
-#include <iomanip>
-#include <chrono>
+#include <charconv>
+#include <cstring>
 #include <ctime>
 
+#include "common/messages/log_message.hpp"
+#include "common/messages/payloads/field_writer.hpp"
+#include "common/messages/payloads/json_escape.hpp"
 #include "publisher/sink_publisher.hpp"
 
 // ---- JsonSink ----
 
-std::string JsonSink::format_impl(view_type line)
+namespace
 {
-    return "JsonTest" + std::string(line);
-}
+    bool is_key(std::string_view s) noexcept
+    {
+        if (s.empty())
+            return false;
+        for (const char c : s)
+            if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+                return false;
+        return true;
+    }
 
-// ---- TextSink ----
+    bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
 
-std::string TextSink::format_impl(view_type line)
+    // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool is_json_number(std::string_view s) noexcept
+    {
+        std::size_t i = 0;
+        const std::size_t n = s.size();
+        auto digits = [&] {
+            const std::size_t from = i;
+            while (i < n && is_digit(s[i]))
+                ++i;
+            return i > from;
+        };
+
+        if (i < n && s[i] == '-')
+            ++i;
+        if (i < n && s[i] == '0')
+            ++i;
+        else if (!digits())
+            return false;
+        if (i < n && s[i] == '.' && (++i, !digits()))
+            return false;
+        if (i < n && (s[i] == 'e' || s[i] == 'E'))
+        {
+            ++i;
+            if (i < n && (s[i] == '+' || s[i] == '-'))
+                ++i;
+            if (!digits())
+                return false;
+        }
+        return i == n;
+    }
+
+    class JsonObjectWriter
+    {
+    public:
+        explicit JsonObjectWriter(FieldWriter& w) noexcept : w_(w) { w_.put('{'); }
+
+        void key(std::string_view k) noexcept
+        {
+            w_.put(first_ ? "\"" : ",\"");
+            w_.put(k);
+            w_.put("\":");
+            first_ = false;
+        }
+
+        void value(std::string_view v) noexcept
+        {
+            if (is_json_number(v)) w_.put(v);
+            else                   put_json_string(w_, v);
+        }
+
+        void close() noexcept { w_.put('}'); }
+
+    private:
+        FieldWriter& w_;
+        bool first_ = true;
+    };
+}
+
+std::string JsonSink::format_impl(view_type line)
 {
-    std::string result;
-    result.reserve(line.size() + 100);
+    char buf[kStackLine];
+    const std::size_t need = format_to(line, buf, sizeof(buf));
+    if (need <= sizeof(buf))
+        return std::string(buf, need);
 
-    size_t pos = 0;
+    std::string result(need, '\0');
+    format_to(line, result.data(), result.size());
+    return result;
+}
 
-    while (pos < line.size()) {
-        auto ts_pos = line.find("timestamp=", pos);
-        if (ts_pos != std::string_view::npos) {
-            result.append(line.substr(pos, ts_pos - pos));
-            result.append("timestamp=");
+// Words are split on spaces; a value keeps the spaces inside it, so a
+// path with a space in it stays one string.
+std::size_t JsonSink::format_to(view_type line, char* dst, std::size_t cap)
+{
+    FieldWriter w{dst, cap};
+    JsonObjectWriter obj{w};
 
-            auto num_start = ts_pos + 10;
-            auto num_end   = line.find(' ', num_start);
-            if (num_end == std::string_view::npos) num_end = line.size();
+    // "[tag=N]" -> "tag":"<name>", as the JSON codec writes it.
+    if (line.starts_with("[tag="))
+    {
+        const std::size_t close = line.find(']');
+        unsigned tag = 0;
+        const char* const first = line.data() + 5;
+        const char* const last  = close == view_type::npos ? first : line.data() + close;
+        const auto [ptr, ec] = std::from_chars(first, last, tag);
+        if (close != view_type::npos && ec == std::errc{} && ptr == last && last != first)
+        {
+            obj.key("tag");
+            if (tag < static_cast<unsigned>(MsgTag::Count))
+                put_json_string(w, toString(static_cast<MsgTag>(tag)));
+            else
+                w.put(tag);
+            line.remove_prefix(close + 1);
+        }
+    }
 
-            auto ts_str = line.substr(num_start, num_end - num_start);
-            std::uint64_t us = std::stoull(std::string(ts_str));
-            result.append(format_timestamp_us(us));
+    std::string_view key;               // empty: text before the first key
+    const char* value_begin = nullptr;  // nullptr: nothing to write yet
+    const char* value_end   = nullptr;
+    auto flush = [&] {
+        if (!value_begin)
+            return;
+        const std::string_view value{value_begin, static_cast<std::size_t>(value_end - value_begin)};
+        if (key.empty())
+        {
+            obj.key("msg");
+            put_json_string(w, value);
+        }
+        else
+        {
+            obj.key(key);
+            obj.value(value);
+        }
+    };
 
-            pos = num_end;
+    std::size_t pos = 0;
+    while (pos < line.size())
+    {
+        if (line[pos] == ' ')
+        {
+            ++pos;
             continue;
         }
 
-        auto class_pos = line.find("class_id=", pos);
-        if (class_pos != std::string_view::npos && (ts_pos == std::string_view::npos || class_pos < ts_pos)) {
-            result.append(line.substr(pos, class_pos - pos));
-            result.append("class_id=");
+        std::size_t end = line.find(' ', pos);
+        if (end == view_type::npos)
+            end = line.size();
+        const std::string_view word = line.substr(pos, end - pos);
+        const std::size_t eq = word.find('=');
 
-            auto num_start = class_pos + 9;
-            auto num_end   = line.find(' ', num_start);
-            if (num_end == std::string_view::npos) num_end = line.size();
+        if (eq != view_type::npos && is_key(word.substr(0, eq)))
+        {
+            flush();
+            key = word.substr(0, eq);
+            value_begin = word.data() + eq + 1;
+        }
+        else if (!value_begin)
+            value_begin = word.data();
+        value_end = word.data() + word.size();
+        pos = end;
+    }
+    flush();
 
-            auto id_str = line.substr(num_start, num_end - num_start);
-            auto id = static_cast<LogClassId>(std::stoi(std::string(id_str)));
-            result.append(className(id));
+    obj.close();
+    return w.size();
+}
 
-            pos = num_end;
-            continue;
-        }
+// ---- TextSink ----
+
+namespace
+{
+    // Fields TextSink rewrites, named by the key before '='.
+    enum class TextField { Other, Timestamp, ClassId, MethodId };
+
+    // Key ending at `eq` (the '=') if it is a whole word: start of line or
+    // preceded by a space.
+    bool key_is(std::string_view line, std::size_t eq, std::string_view key) noexcept
+    {
+        if (eq < key.size() || line.compare(eq - key.size(), key.size(), key) != 0)
+            return false;
+        return eq == key.size() || line[eq - key.size() - 1] == ' ';
+    }
+
+    TextField field_at(std::string_view line, std::size_t eq) noexcept
+    {
+        if (key_is(line, eq, "timestamp")) return TextField::Timestamp;
+        if (key_is(line, eq, "class_id"))  return TextField::ClassId;
+        if (key_is(line, eq, "method_id")) return TextField::MethodId;
+        return TextField::Other;
+    }
+}
+
+std::string TextSink::format_impl(view_type line)
+{
+    char buf[kStackLine];
+    const std::size_t need = format_to(line, buf, sizeof(buf));
+    if (need <= sizeof(buf))
+        return std::string(buf, need);
 
-        auto method_pos = line.find("method_id=", pos);
-        if (method_pos != std::string_view::npos &&
-            (ts_pos == std::string_view::npos || method_pos < ts_pos) &&
-            (class_pos == std::string_view::npos || method_pos < class_pos)) {
-            result.append(line.substr(pos, method_pos - pos));
-            result.append("method_id=");
+    std::string result(need, '\0');
+    format_to(line, result.data(), result.size());
+    return result;
+}
 
-            auto num_start = method_pos + 10;
-            auto num_end   = line.find(' ', num_start);
-            if (num_end == std::string_view::npos) num_end = line.size();
+// One pass: memchr (vectorised in libc) jumps from '=' to '=', a value
+// runs to the next space, and only the three known keys are rewritten;
+// everything in between is copied through in one piece. A value that is
+// not a plain number, or an id out of range, is left as it is.
+std::size_t TextSink::format_to(view_type line, char* dst, std::size_t cap)
+{
+    FieldWriter w{dst, cap};
 
-            auto id_str = line.substr(num_start, num_end - num_start);
-            auto id = static_cast<MethodId>(std::stoi(std::string(id_str)));
-            result.append(methodName(id));
+    const char* const begin = line.data();
+    const char* const end   = begin + line.size();
+    const char* copied = begin;         // start of the text not yet written
+    const char* p      = begin;
 
-            pos = num_end;
+    while (p < end)
+    {
+        const auto* eq = static_cast<const char*>(std::memchr(p, '=', static_cast<std::size_t>(end - p)));
+        if (!eq)
+            break;
+
+        const char* val = eq + 1;
+        const auto* space = static_cast<const char*>(std::memchr(val, ' ', static_cast<std::size_t>(end - val)));
+        const char* val_end = space ? space : end;
+        p = val_end;
+
+        const TextField field = field_at(line, static_cast<std::size_t>(eq - begin));
+        if (field == TextField::Other)
             continue;
+
+        std::uint64_t n = 0;
+        const auto [ptr, ec] = std::from_chars(val, val_end, n);
+        if (ec != std::errc{} || ptr != val_end)
+            continue;
+
+        std::string_view text;
+        char ts[kTimestampBytes];
+        switch (field)
+        {
+            case TextField::Timestamp:
+                text = std::string_view(ts, render_timestamp_us(n, ts));
+                break;
+            case TextField::ClassId:
+                if (n < static_cast<std::size_t>(LogClassId::Count))
+                    text = className(static_cast<LogClassId>(n));
+                break;
+            case TextField::MethodId:
+                if (n < static_cast<std::size_t>(MethodId::Count))
+                    text = methodName(static_cast<MethodId>(n));
+                break;
+            case TextField::Other:
+                break;
         }
+        if (text.empty())
+            continue;
 
-        result.append(line.substr(pos));
-        break;
+        w.put(std::string_view(copied, static_cast<std::size_t>(val - copied)));
+        w.put(text);
+        copied = val_end;
     }
 
-    return result;
+    w.put(std::string_view(copied, static_cast<std::size_t>(end - copied)));
+    return w.size();
 }
 
-std::string TextSink::format_timestamp_us(std::uint64_t us_since_epoch)
+// "YYYY-MM-DD HH:MM:SS.uuuuuu", local time. localtime_r and strftime run
+// once per second per thread; every other record reuses the cached
+// date-second prefix and renders only the microseconds.
+std::size_t TextSink::render_timestamp_us(std::uint64_t us_since_epoch, char* out)
 {
-    using namespace std::chrono;
+    struct SecondCache
+    {
+        std::time_t second = -1;
+        std::size_t len    = 0;
+        char        prefix[kTimestampBytes - 7]{};
+    };
+    thread_local SecondCache cache;
+
+    const auto second = static_cast<std::time_t>(us_since_epoch / 1'000'000);
+    if (second != cache.second)
+    {
+        std::tm tm{};
+        localtime_r(&second, &tm);
+        cache.len    = std::strftime(cache.prefix, sizeof(cache.prefix), "%Y-%m-%d %H:%M:%S", &tm);
+        cache.second = second;
+    }
 
-    auto dur       = microseconds{us_since_epoch};
-    auto tp        = system_clock::time_point{duration_cast<system_clock::duration>(dur)};
-    auto time_t_tp = system_clock::to_time_t(tp);
-    auto us        = us_since_epoch % 1'000'000;
+    std::memcpy(out, cache.prefix, cache.len);
+    char* p = out + cache.len;
+    *p++ = '.';
 
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time_t_tp), "%Y-%m-%d %H:%M:%S")
-        << '.' << std::setfill('0') << std::setw(6) << us;
+    auto us = static_cast<unsigned>(us_since_epoch % 1'000'000);
+    for (int i = 5; i >= 0; --i, us /= 10)
+        p[i] = static_cast<char>('0' + us % 10);
 
-    return oss.str();
+    return cache.len + 7;
 }
@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "publisher/runtime/socket_sink.hpp"
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+namespace publisher::runtime
+{
+
+namespace
+{
+    using Transport = SocketSinkConfig::Transport;
+
+    bool make_address(const SocketSinkConfig& cfg, sockaddr_storage& addr, socklen_t& len) noexcept
+    {
+        std::memset(&addr, 0, sizeof(addr));
+        if (cfg.transport == Transport::Unix)
+        {
+            auto* un = reinterpret_cast<sockaddr_un*>(&addr);
+            if (cfg.address.empty() || cfg.address.size() >= sizeof(un->sun_path))
+                return false;
+            un->sun_family = AF_UNIX;
+            std::memcpy(un->sun_path, cfg.address.c_str(), cfg.address.size() + 1);
+            len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + cfg.address.size() + 1);
+            return true;
+        }
+
+        auto* in = reinterpret_cast<sockaddr_in*>(&addr);
+        in->sin_family = AF_INET;
+        in->sin_port   = htons(cfg.port);
+        if (::inet_pton(AF_INET, cfg.address.c_str(), &in->sin_addr) != 1)
+            return false;
+        len = sizeof(sockaddr_in);
+        return true;
+    }
+
+    bool would_block(int err) noexcept
+    {
+        return err == EAGAIN || err == EWOULDBLOCK;
+    }
+}
+
+bool SocketSink::open(SocketSinkConfig cfg)
+{
+    close();
+
+    sockaddr_storage addr{};
+    socklen_t len = 0;
+    if (cfg.ring_bytes == 0 || cfg.max_records == 0 || !make_address(cfg, addr, len))
+        return false;
+
+    cfg_ = std::move(cfg);
+    cap_ = cfg_.ring_bytes;
+    ring_ = std::make_unique<char[]>(cap_);
+    ends_.assign(cfg_.max_records, 0);
+    ends_head_ = ends_count_ = 0;
+    release_ = sent_ = tail_ = rec_start_ = 0;
+    pending_head_ = pending_count_ = 0;
+    backoff_ = std::chrono::milliseconds{0};
+    next_attempt_ = clock::time_point{};
+    last_probe_ = clock::time_point{};
+    stats_ = {};
+
+    start_connect(clock::now());
+    return true;
+}
+
+void SocketSink::close() noexcept
+{
+    if (fd_ >= 0)
+        ::close(fd_);
+    fd_ = -1;
+    state_ = State::Closed;
+    zerocopy_on_ = false;
+}
+
+void SocketSink::write(std::string_view record, clock::time_point now) noexcept
+{
+    if (!ring_ || record.empty())
+        return;
+
+    auto fits = [&] {
+        return record.size() <= cap_ - queued_bytes() && ends_count_ < ends_.size();
+    };
+
+    // Sending may free space; anything that still does not fit is dropped.
+    if (!fits())
+        pump(now);
+    if (!fits())
+    {
+        ++stats_.dropped_records;
+        stats_.dropped_bytes += record.size();
+        return;
+    }
+
+    const std::size_t at    = static_cast<std::size_t>(tail_ % cap_);
+    const std::size_t first = std::min(record.size(), cap_ - at);
+    std::memcpy(ring_.get() + at, record.data(), first);
+    std::memcpy(ring_.get(), record.data() + first, record.size() - first);
+    tail_ += record.size();
+
+    ends_[(ends_head_ + ends_count_) % ends_.size()] = tail_;
+    ++ends_count_;
+}
+
+void SocketSink::pump(clock::time_point now) noexcept
+{
+    if (!ring_)
+        return;
+
+    if (state_ == State::Closed && now >= next_attempt_)
+        start_connect(now);
+    if (state_ == State::Connecting)
+        finish_connect(now);
+    if (state_ != State::Connected)
+        return;
+
+    if (pending_count_)
+        reap_zerocopy();
+    if (sent_ != tail_)
+        send_some(now);
+    else
+        probe_peer(now);
+}
+
+bool SocketSink::drain(std::chrono::milliseconds timeout) noexcept
+{
+    const auto deadline = clock::now() + timeout;
+    for (;;)
+    {
+        const auto now = clock::now();
+        pump(now);
+        if (sent_ == tail_ && pending_count_ == 0)
+            return true;
+        if (now >= deadline)
+            return false;
+
+        // Wait (at most 10 ms) for buffer space, a connect to finish or a
+        // zerocopy completion (POLLERR); while closed, just sleep.
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now);
+        const int wait_ms = static_cast<int>(std::min<std::chrono::milliseconds::rep>(left.count() + 1, 10));
+        pollfd p{fd_, static_cast<short>(sent_ != tail_ || state_ == State::Connecting ? POLLOUT : 0), 0};
+        if (fd_ >= 0)
+            ::poll(&p, 1, wait_ms);
+        else
+            ::poll(nullptr, 0, wait_ms);
+    }
+}
+
+void SocketSink::start_connect(clock::time_point now) noexcept
+{
+    sockaddr_storage addr{};
+    socklen_t len = 0;
+    make_address(cfg_, addr, len);
+
+    const int domain = cfg_.transport == Transport::Unix ? AF_UNIX : AF_INET;
+    fd_ = ::socket(domain, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd_ < 0)
+    {
+        on_connect_failed(now);
+        return;
+    }
+
+    connect_started_ = now;
+    if (::connect(fd_, reinterpret_cast<const sockaddr*>(&addr), len) == 0)
+        on_connected();
+    else if (errno == EINPROGRESS)
+        state_ = State::Connecting;
+    else
+        on_connect_failed(now);
+}
+
+void SocketSink::finish_connect(clock::time_point now) noexcept
+{
+    pollfd p{fd_, POLLOUT, 0};
+    if (::poll(&p, 1, 0) <= 0)
+    {
+        // A collector that never answers is treated like a refusal.
+        if (now - connect_started_ >= std::max(cfg_.backoff_max, std::chrono::milliseconds{1000}))
+            on_connect_failed(now);
+        return;
+    }
+
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0)
+        on_connect_failed(now);
+    else
+        on_connected();
+}
+
+void SocketSink::on_connected() noexcept
+{
+    state_ = State::Connected;
+    backoff_ = std::chrono::milliseconds{0};
+    ++stats_.connects;
+
+    // Not supported on Unix sockets or older kernels; copying sends then.
+    zerocopy_on_ = false;
+    if (cfg_.zerocopy && cfg_.transport == Transport::Tcp)
+    {
+        const int one = 1;
+        zerocopy_on_ = ::setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0;
+    }
+    next_zc_id_ = 0;
+}
+
+void SocketSink::on_connect_failed(clock::time_point now) noexcept
+{
+    close();
+    ++stats_.connect_failures;
+
+    backoff_ = backoff_.count() == 0 ? cfg_.backoff_min
+                                     : std::min(backoff_ * 2, cfg_.backoff_max);
+    next_attempt_ = now + backoff_;
+}
+
+// The peer went away. Bytes the kernel accepted count as sent; a record it
+// only took part of is skipped so the next connection starts on a record
+// boundary. The first reconnect is attempted right away.
+void SocketSink::drop_connection(clock::time_point now) noexcept
+{
+    close();
+    ++stats_.disconnects;
+
+    pending_head_ = pending_count_ = 0;
+    if (ends_count_ && sent_ > rec_start_)
+    {
+        sent_ = ends_[ends_head_];
+        ++stats_.torn_records;
+        rec_start_ = sent_;
+        ends_head_ = (ends_head_ + 1) % ends_.size();
+        --ends_count_;
+    }
+    release_ = sent_;
+
+    backoff_ = std::chrono::milliseconds{0};
+    next_attempt_ = now;
+}
+
+// Nothing queued: look for a collector that closed its end, so the next
+// batch does not go into a dead connection the kernel would accept it on.
+// poll() reads nothing, so bytes the collector sent stay in the socket.
+// A close during steady traffic shows up as EPIPE / ECONNRESET from
+// sendmsg instead (MSG_NOSIGNAL), one batch later.
+void SocketSink::probe_peer(clock::time_point now) noexcept
+{
+    if (now - last_probe_ < kProbeInterval)
+        return;
+    last_probe_ = now;
+
+    pollfd p{fd_, POLLRDHUP, 0};
+    if (::poll(&p, 1, 0) > 0 && (p.revents & (POLLRDHUP | POLLHUP)))
+        drop_connection(now);
+}
+
+// One sendmsg over [sent_, tail_): a single iovec, or two when the ring
+// wraps, so every queued record goes out in one call.
+void SocketSink::send_some(clock::time_point now) noexcept
+{
+    const std::size_t len = static_cast<std::size_t>(tail_ - sent_);
+    const std::size_t at  = static_cast<std::size_t>(sent_ % cap_);
+    const std::size_t first = std::min(len, cap_ - at);
+
+    iovec iov[2] = {{ring_.get() + at, first}, {ring_.get(), len - first}};
+    msghdr msg{};
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = len > first ? 2 : 1;
+
+    const bool zc = zerocopy_on_ && len >= cfg_.zerocopy_min && pending_count_ < kMaxPending;
+    const int flags = MSG_DONTWAIT | MSG_NOSIGNAL | (zc ? MSG_ZEROCOPY : 0);
+
+    ssize_t n;
+    do
+        n = ::sendmsg(fd_, &msg, flags);
+    while (n < 0 && errno == EINTR);
+    ++stats_.writev_calls;
+
+    if (n < 0)
+    {
+        // Socket buffer full (ENOBUFS: zerocopy's locked-page budget):
+        // keep everything and retry on the next pump.
+        if (would_block(errno) || (zc && errno == ENOBUFS))
+            return;
+        drop_connection(now);
+        return;
+    }
+
+    sent_ += static_cast<std::uint64_t>(n);
+    stats_.sent_bytes += static_cast<std::uint64_t>(n);
+    account_sent();
+
+    if (zc && n > 0)
+    {
+        pending_[(pending_head_ + pending_count_) % kMaxPending] = {sent_, next_zc_id_++, true, false};
+        ++pending_count_;
+        ++stats_.zerocopy_sends;
+    }
+    else if (pending_count_ && n > 0)
+    {
+        // Copied, but must not be reused ahead of an earlier zerocopy send.
+        if (pending_count_ < kMaxPending)
+        {
+            pending_[(pending_head_ + pending_count_) % kMaxPending] = {sent_, 0, false, true};
+            ++pending_count_;
+        }
+        else
+            pending_[(pending_head_ + pending_count_ - 1) % kMaxPending].end = sent_;
+    }
+    else if (!pending_count_)
+        release_ = sent_;
+}
+
+// Completions arrive on the socket error queue as ranges of send ids.
+void SocketSink::reap_zerocopy() noexcept
+{
+    for (;;)
+    {
+        char control[128];
+        msghdr msg{};
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+        if (::recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+            break;
+
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm))
+        {
+            if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                  (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+                continue;
+
+            sock_extended_err err{};
+            std::memcpy(&err, CMSG_DATA(cm), sizeof(err));
+            if (err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                continue;
+            if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                ++stats_.zerocopy_copied;
+
+            const std::uint32_t lo = err.ee_info, hi = err.ee_data;
+            for (std::size_t i = 0; i < pending_count_; ++i)
+            {
+                PendingSend& p = pending_[(pending_head_ + i) % kMaxPending];
+                if (p.zerocopy && p.id - lo <= hi - lo)
+                    p.done = true;
+            }
+        }
+    }
+
+    while (pending_count_ && pending_[pending_head_].done)
+    {
+        release_ = pending_[pending_head_].end;
+        pending_head_ = (pending_head_ + 1) % kMaxPending;
+        --pending_count_;
+    }
+    if (!pending_count_)
+        release_ = sent_;
+}
+
+void SocketSink::account_sent() noexcept
+{
+    while (ends_count_ && ends_[ends_head_] <= sent_)
+    {
+        rec_start_ = ends_[ends_head_];
+        ends_head_ = (ends_head_ + 1) % ends_.size();
+        --ends_count_;
+        ++stats_.sent_records;
+    }
+}
+
+} // namespace publisher::runtime
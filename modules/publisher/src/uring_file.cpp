@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MYSERVER_HAVE_IO_URING 1
+#else
+#define MYSERVER_HAVE_IO_URING 0
+#endif
+
+#include "publisher/runtime/uring_file.hpp"
+
+namespace publisher::runtime
+{
+
+namespace
+{
+    constexpr std::size_t kBufferAlign = 4096;
+}
+
+#if MYSERVER_HAVE_IO_URING
+
+// Minimal io_uring over the raw syscalls (no liburing): one SQ/CQ pair,
+// one submitter.
+struct UringFile::Ring
+{
+    int fd{-1};
+
+    void*       sq_map{MAP_FAILED};
+    std::size_t sq_map_bytes{0};
+    void*       cq_map{MAP_FAILED};
+    std::size_t cq_map_bytes{0};
+    io_uring_sqe* sqes{static_cast<io_uring_sqe*>(MAP_FAILED)};
+    std::size_t   sqes_bytes{0};
+
+    unsigned* sq_head{};
+    unsigned* sq_tail{};
+    unsigned* sq_mask{};
+    unsigned* sq_array{};
+    unsigned* cq_head{};
+    unsigned* cq_tail{};
+    unsigned* cq_mask{};
+    io_uring_cqe* cqes{};
+
+    ~Ring()
+    {
+        if (sqes != MAP_FAILED)
+            ::munmap(sqes, sqes_bytes);
+        if (cq_map != MAP_FAILED && cq_map != sq_map)
+            ::munmap(cq_map, cq_map_bytes);
+        if (sq_map != MAP_FAILED)
+            ::munmap(sq_map, sq_map_bytes);
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    bool init(unsigned entries) noexcept
+    {
+        io_uring_params p{};
+        fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+        if (fd < 0)
+            return false;
+
+        sq_map_bytes = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_map_bytes = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single)
+            sq_map_bytes = cq_map_bytes = std::max(sq_map_bytes, cq_map_bytes);
+
+        sq_map = ::mmap(nullptr, sq_map_bytes, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq_map == MAP_FAILED)
+            return false;
+
+        cq_map = single ? sq_map
+                        : ::mmap(nullptr, cq_map_bytes, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_map == MAP_FAILED)
+            return false;
+
+        sqes_bytes = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_bytes, PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+        if (sqes == MAP_FAILED)
+            return false;
+
+        auto* sq = static_cast<char*>(sq_map);
+        sq_head  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sq_tail  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask  = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+
+        auto* cq = static_cast<char*>(cq_map);
+        cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                                          flags, nullptr, 0));
+    }
+
+    int register_op(unsigned op, const void* arg, unsigned n) noexcept
+    {
+        return static_cast<int>(::syscall(__NR_io_uring_register, fd, op, arg, n));
+    }
+
+    // The SQ never holds more than one entry per buffer, so it cannot be
+    // full here.
+    io_uring_sqe* next_sqe() noexcept
+    {
+        const unsigned tail = *sq_tail;
+        const unsigned idx  = tail & *sq_mask;
+        sq_array[idx] = idx;
+        io_uring_sqe* sqe = &sqes[idx];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    void publish_sqe() noexcept
+    {
+        __atomic_store_n(sq_tail, *sq_tail + 1, __ATOMIC_RELEASE);
+    }
+
+    template <typename Fn>
+    void for_each_cqe(Fn&& fn) noexcept
+    {
+        unsigned head = *cq_head;
+        const unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head)
+            fn(cqes[head & *cq_mask]);
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+    }
+};
+
+#else
+
+struct UringFile::Ring
+{
+};
+
+#endif // MYSERVER_HAVE_IO_URING
+
+void UringFile::AlignedDelete::operator()(char* p) const noexcept
+{
+    ::operator delete[](p, std::align_val_t{kBufferAlign});
+}
+
+UringFile::UringFile() = default;
+
+UringFile::~UringFile()
+{
+    close();
+}
+
+bool UringFile::is_open() const noexcept
+{
+    return fd_ >= 0 || fallback_.is_open();
+}
+
+bool UringFile::open(AsyncFileConfig cfg)
+{
+    close();
+    cfg_ = std::move(cfg);
+
+    if (!cfg_.force_sync)
+    {
+        fd_ = ::open(cfg_.path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ >= 0)
+        {
+            struct stat st{};
+            ::fstat(fd_, &st);
+            seekable_    = S_ISREG(st.st_mode);
+            next_offset_ = seekable_ ? static_cast<std::uint64_t>(st.st_size) : 0;
+
+            if (setup_ring())
+            {
+                if (next_offset_ == 0 && !cfg_.header.empty())
+                    write(cfg_.header);
+                return true;
+            }
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    FileSinkConfig sync;
+    sync.path         = cfg_.path;
+    sync.buffer_bytes = cfg_.buffer_bytes;
+    sync.header       = cfg_.header;
+    return fallback_.open(std::move(sync));
+}
+
+bool UringFile::setup_ring() noexcept
+{
+#if MYSERVER_HAVE_IO_URING
+    const std::size_t n = cfg_.buffers ? cfg_.buffers : 1;
+    const std::size_t bytes = cfg_.buffer_bytes ? cfg_.buffer_bytes : kBufferAlign;
+
+    auto ring = std::make_unique<Ring>();
+    if (!ring->init(static_cast<unsigned>(n)))
+        return false;
+
+    std::vector<iovec> iov;
+    try
+    {
+        arena_.reset(static_cast<char*>(::operator new[](n * bytes, std::align_val_t{kBufferAlign})));
+        bufs_.assign(n, Buffer{});
+        free_.clear();
+        free_.reserve(n);
+        iov.resize(n);
+    }
+    catch (...)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        bufs_[i].data = arena_.get() + i * bytes;
+        iov[i] = {bufs_[i].data, bytes};
+        free_.push_back(n - 1 - i);
+    }
+    cfg_.buffer_bytes = bytes;
+
+    // Both registrations are optimisations; RLIMIT_MEMLOCK or an old
+    // kernel only costs the per-write page pinning / fd lookup.
+    fixed_buffers_ = ring->register_op(IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(n)) == 0;
+    fixed_file_    = ring->register_op(IORING_REGISTER_FILES, &fd_, 1) == 0;
+
+    ring_ = std::move(ring);
+    current_ = kNone;
+    in_flight_ = 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UringFile::close() noexcept
+{
+    if (ring_)
+    {
+        flush();
+        drain();
+        ring_.reset();
+    }
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    fallback_.close();
+    arena_.reset();
+    bufs_.clear();
+    free_.clear();
+    current_ = kNone;
+    fixed_buffers_ = fixed_file_ = false;
+}
+
+std::size_t UringFile::free_bytes() const noexcept
+{
+    const std::size_t room = current_ == kNone ? 0 : cfg_.buffer_bytes - bufs_[current_].len;
+    return room + free_.size() * cfg_.buffer_bytes;
+}
+
+bool UringFile::acquire_current() noexcept
+{
+    if (free_.empty())
+        return false;
+    current_ = free_.back();
+    free_.pop_back();
+    bufs_[current_].len = 0;
+    bufs_[current_].done = 0;
+    return true;
+}
+
+void UringFile::write(std::string_view record) noexcept
+{
+    if (!ring_)
+    {
+        fallback_.write(record);
+        return;
+    }
+
+    // Room is checked for the whole record up front, so a record is
+    // either written entirely or dropped entirely.
+    if (free_bytes() < record.size())
+        reap(false);
+    if (free_bytes() < record.size())
+    {
+        dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+
+    while (!record.empty())
+    {
+        if (current_ == kNone)
+            acquire_current();
+
+        Buffer& b = bufs_[current_];
+        const std::size_t n = std::min(record.size(), cfg_.buffer_bytes - b.len);
+        std::memcpy(b.data + b.len, record.data(), n);
+        b.len += n;
+        record.remove_prefix(n);
+
+        if (b.len == cfg_.buffer_bytes)
+            submit(std::exchange(current_, kNone));
+    }
+}
+
+void UringFile::flush() noexcept
+{
+    if (!ring_)
+    {
+        fallback_.flush();
+        return;
+    }
+
+    if (current_ != kNone && bufs_[current_].len)
+        submit(std::exchange(current_, kNone));
+    reap(false);
+}
+
+void UringFile::kick() noexcept
+{
+    if (!ring_)
+        return;
+
+    reap(false);
+    if (in_flight_ == 0 && current_ != kNone && bufs_[current_].len)
+        submit(std::exchange(current_, kNone));
+}
+
+void UringFile::drain() noexcept
+{
+    while (ring_ && in_flight_)
+        reap(true);
+}
+
+void UringFile::submit(std::size_t idx) noexcept
+{
+#if MYSERVER_HAVE_IO_URING
+    Buffer& b = bufs_[idx];
+    if (!b.in_flight)
+    {
+        b.in_flight = true;
+        b.done = 0;
+        b.offset = next_offset_;
+        if (seekable_)
+            next_offset_ += b.len;
+        ++in_flight_;
+    }
+
+    io_uring_sqe* sqe = ring_->next_sqe();
+    sqe->opcode    = fixed_buffers_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd        = fixed_file_ ? 0 : fd_;
+    sqe->flags     = fixed_file_ ? IOSQE_FIXED_FILE : 0;
+    // Pipes and sockets have no offset to keep concurrent writes apart;
+    // each write waits for the ones before it instead.
+    if (!seekable_)
+        sqe->flags |= IOSQE_IO_DRAIN;
+    sqe->addr      = reinterpret_cast<std::uint64_t>(b.data + b.done);
+    sqe->len       = static_cast<std::uint32_t>(b.len - b.done);
+    // -1: "current position", for files without offsets.
+    sqe->off       = seekable_ ? b.offset + b.done : static_cast<std::uint64_t>(-1);
+    sqe->buf_index = fixed_buffers_ ? static_cast<std::uint16_t>(idx) : 0;
+    sqe->user_data = idx;
+    ring_->publish_sqe();
+
+    while (ring_->enter(1, 0, 0) < 0 && errno == EINTR)
+    {
+    }
+    ++submits_;
+#else
+    (void)idx;
+#endif
+}
+
+void UringFile::reap(bool wait) noexcept
+{
+#if MYSERVER_HAVE_IO_URING
+    if (wait)
+        ring_->enter(0, 1, IORING_ENTER_GETEVENTS);
+
+    std::size_t resubmit[64];
+    std::size_t n_resubmit = 0;
+
+    ring_->for_each_cqe([&](const io_uring_cqe& cqe) {
+        const auto idx = static_cast<std::size_t>(cqe.user_data);
+        Buffer& b = bufs_[idx];
+
+        if (cqe.res > 0)
+        {
+            b.done += static_cast<std::size_t>(cqe.res);
+            bytes_written_ += static_cast<std::uint64_t>(cqe.res);
+        }
+
+        // Short write: send the rest of the same buffer.
+        if (cqe.res > 0 && b.done < b.len && n_resubmit < std::size(resubmit))
+        {
+            resubmit[n_resubmit++] = idx;
+            return;
+        }
+        if (cqe.res <= 0 || b.done < b.len)
+            ++write_errors_;
+
+        b.in_flight = false;
+        b.len = 0;
+        --in_flight_;
+        free_.push_back(idx);
+    });
+
+    for (std::size_t i = 0; i < n_resubmit; ++i)
+        submit(resubmit[i]);
+#else
+    (void)wait;
+#endif
+}
+
+} // namespace publisher::runtime
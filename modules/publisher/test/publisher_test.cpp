@@ -37,7 +37,7 @@ TEST_F(PublisherFixture, TerminalJson_UsesJsonSinkAndWritesToStdout) {
     std::string output = testing::internal::GetCapturedStdout();
 
     EXPECT_EQ(adapter_call_count_, 1);
-    EXPECT_EQ(output, "JsonTestREQ");
+    EXPECT_EQ(output, R"({"msg":"REQ"})");
 }
 
 TEST_F(PublisherFixture, TerminalText_UsesTextSinkAndWritesToStdout) {
@@ -72,7 +72,7 @@ TEST_F(PublisherFixture, FileJson_PublishesFormattedMessageToLocalFile) {
     std::string file_content;
     std::getline(in, file_content);
 
-    EXPECT_EQ(file_content, "JsonTestREQ");
+    EXPECT_EQ(file_content, R"({"msg":"REQ"})");
 }
 
 TEST_F(PublisherFixture, FileText_PublishesFormattedMessageToLocalFile) {
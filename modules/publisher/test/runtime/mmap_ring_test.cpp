@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/mmap_ring.hpp"
+#include "publisher/runtime/publisher_runtime.hpp"
+#include "publisher/runtime/resource_store.hpp"
+#include "publisher/runtime/token_registry.hpp"
+
+using namespace publisher::core;
+using namespace publisher::runtime;
+
+// ─── Helper ──────────────────────────────────────────────────────
+
+namespace {
+    std::string fresh_path(const std::string& name)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(path.c_str());
+        return path;
+    }
+
+    MmapRingConfig config(const std::string& path, std::size_t capacity = 4096)
+    {
+        MmapRingConfig cfg;
+        cfg.path = path;
+        cfg.capacity_bytes = capacity;
+        return cfg;
+    }
+
+    struct Dump
+    {
+        RingReadSummary sum;
+        std::vector<std::uint64_t> seqs;
+        std::vector<std::string> records;
+    };
+
+    // Reads the file from disk, the way ringdump does after a crash.
+    Dump dump(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        const std::string image{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}};
+
+        Dump d;
+        d.sum = read_ring(image, [&](std::uint64_t seq, std::string_view rec) {
+            d.seqs.push_back(seq);
+            d.records.emplace_back(rec);
+        });
+        return d;
+    }
+
+    std::string record(int i)
+    {
+        return "record-" + std::to_string(i);
+    }
+}
+
+// ─── Writing and reading back ────────────────────────────────────
+
+TEST(MmapRingTest, ReadsRecordsInOrder)
+{
+    const auto path = fresh_path("mmap_ring_order.ring");
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path)));
+
+    for (int i = 0; i < 20; ++i)
+        ring.write(record(i));
+
+    const auto d = dump(path);
+    ASSERT_TRUE(d.sum.header_ok);
+    EXPECT_FALSE(d.sum.corrupt);
+    ASSERT_EQ(d.records.size(), 20u);
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_EQ(d.records[i], record(i));
+        EXPECT_EQ(d.seqs[i], static_cast<std::uint64_t>(i));
+    }
+}
+
+TEST(MmapRingTest, WrapKeepsNewestRecordsInOrder)
+{
+    const auto path = fresh_path("mmap_ring_wrap.ring");
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path, 1024)));
+
+    // Odd sizes so frames land at every offset and the end gets padded.
+    for (int i = 0; i < 500; ++i)
+        ring.write(record(i) + std::string(static_cast<std::size_t>(i % 37), '.'));
+
+    const auto d = dump(path);
+    ASSERT_FALSE(d.sum.corrupt);
+    ASSERT_FALSE(d.records.empty());
+    EXPECT_EQ(d.sum.last_seq, 499u);
+    EXPECT_EQ(d.sum.first_seq + d.records.size() - 1, 499u);
+    for (std::size_t k = 0; k < d.records.size(); ++k)
+    {
+        const int i = static_cast<int>(d.seqs[k]);
+        EXPECT_EQ(d.records[k], record(i) + std::string(static_cast<std::size_t>(i % 37), '.'));
+    }
+
+    EXPECT_EQ(ring.written(), 500u);
+    EXPECT_EQ(ring.overwritten(), 500u - d.records.size());
+}
+
+TEST(MmapRingTest, DropsRecordLargerThanRing)
+{
+    const auto path = fresh_path("mmap_ring_big.ring");
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path, 256)));
+
+    ring.write("small");
+    ring.write(std::string(1000, 'x'));
+
+    EXPECT_EQ(ring.dropped(), 1u);
+    const auto d = dump(path);
+    ASSERT_EQ(d.records.size(), 1u);
+    EXPECT_EQ(d.records[0], "small");
+}
+
+TEST(MmapRingTest, ReopenContinuesSequence)
+{
+    const auto path = fresh_path("mmap_ring_reopen.ring");
+    {
+        MmapRing ring;
+        ASSERT_TRUE(ring.open(config(path)));
+        ring.write("before-1");
+        ring.write("before-2");
+    }
+
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path)));
+    EXPECT_EQ(ring.next_seq(), 2u);
+    ring.write("after");
+
+    const auto d = dump(path);
+    EXPECT_EQ(d.records, (std::vector<std::string>{"before-1", "before-2", "after"}));
+    EXPECT_EQ(d.sum.last_seq, 2u);
+}
+
+TEST(MmapRingTest, ReopenWithOtherCapacityStartsOver)
+{
+    const auto path = fresh_path("mmap_ring_resize.ring");
+    {
+        MmapRing ring;
+        ASSERT_TRUE(ring.open(config(path, 4096)));
+        ring.write("old");
+    }
+
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path, 8192)));
+    ring.write("new");
+
+    const auto d = dump(path);
+    EXPECT_EQ(d.records, std::vector<std::string>{"new"});
+    EXPECT_EQ(std::filesystem::file_size(path), kRingHeaderBytes + 8192);
+}
+
+TEST(MmapRingTest, RejectsForeignFile)
+{
+    EXPECT_FALSE(read_ring("definitely not a ring file", [](std::uint64_t, std::string_view) {}).header_ok);
+}
+
+// ─── Crash survival ──────────────────────────────────────────────
+
+TEST(MmapRingTest, RecordsSurviveSigkill)
+{
+    const auto path = fresh_path("mmap_ring_kill.ring");
+
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0)
+    {
+        MmapRing ring;
+        if (!ring.open(config(path, 64 * 1024)))
+            ::_exit(1);
+        for (int i = 0; i < 100; ++i)
+            ring.write(record(i));
+        ::raise(SIGKILL);       // no destructor, no munmap, no msync
+        ::_exit(2);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGKILL);
+
+    const auto d = dump(path);
+    ASSERT_TRUE(d.sum.header_ok);
+    ASSERT_EQ(d.records.size(), 100u);
+    EXPECT_EQ(d.records.front(), record(0));
+    EXPECT_EQ(d.records.back(), record(99));
+}
+
+// ─── Through the runtime ─────────────────────────────────────────
+
+TEST(MmapRingTest, PublishBatchThroughRuntime)
+{
+    const auto path = fresh_path("mmap_ring_runtime.ring");
+    MmapRing ring;
+    ASSERT_TRUE(ring.open(config(path)));
+
+    TokenRegistry reg;
+    OutputResourceStore store;
+    auto tok = reg.acquire();
+    store.mmap_rings[reg.resolve(tok)].ring = &ring;
+
+    const std::vector<std::string_view> views{"a", "bb", "ccc"};
+    PublisherRuntime<SinkKind::MmapRing>::publish_batch(reg, store, tok, views);
+    PublisherRuntime<SinkKind::MmapRing>::publish_view(reg, store, tok, "d");
+
+    EXPECT_EQ(dump(path).records, (std::vector<std::string>{"a", "bb", "ccc", "d"}));
+    EXPECT_STREQ(toString(SinkKind::MmapRing), "MmapRing");
+}
@@ -340,6 +340,63 @@ TEST(SinkTraitsTerminalTest, WritesEmptyView)
     EXPECT_EQ(oss.str(), "");
 }
 
+namespace {
+    // streambuf that counts sputn calls (one per ostream::write)
+    struct CountingBuf : std::stringbuf
+    {
+        int writes = 0;
+
+    protected:
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            ++writes;
+            return std::stringbuf::xsputn(s, n);
+        }
+    };
+}
+
+TEST(SinkTraitsTerminalTest, WriteBatchCoalescesContiguousViews)
+{
+    CountingBuf buf;
+    std::ostream os(&buf);
+    TerminalHandle handle{&os};
+
+    const std::string staged = "aaabbcccc";
+    const std::string_view sv = staged;
+    const std::string_view views[] = {sv.substr(0, 3), sv.substr(3, 2), sv.substr(5)};
+
+    SinkTraits<SinkKind::Terminal>::write_batch(handle, views);
+
+    EXPECT_EQ(buf.str(), "aaabbcccc");
+    EXPECT_EQ(buf.writes, 1);
+}
+
+TEST(SinkTraitsTerminalTest, WriteBatchSplitsAtGaps)
+{
+    CountingBuf buf;
+    std::ostream os(&buf);
+    TerminalHandle handle{&os};
+
+    const std::string a = "first|";
+    const std::string b = "second|";
+    const std::string_view views[] = {a, std::string_view{}, b};
+
+    SinkTraits<SinkKind::Terminal>::write_batch(handle, views);
+
+    EXPECT_EQ(buf.str(), "first|second|");
+    EXPECT_EQ(buf.writes, 2);
+}
+
+TEST(SinkTraitsTerminalTest, WriteBatchEmptySpanWritesNothing)
+{
+    CountingBuf buf;
+    std::ostream os(&buf);
+    TerminalHandle handle{&os};
+
+    SinkTraits<SinkKind::Terminal>::write_batch(handle, {});
+    EXPECT_EQ(buf.writes, 0);
+}
+
 // ─── SinkTraits<File> ────────────────────────────────────────────
 
 TEST(SinkTraitsFileTest, WritesToFstream)
@@ -430,6 +487,24 @@ TEST(PublisherRuntimeTerminalTest, PublishViewRoutesToCorrectChannel)
     EXPECT_EQ(ts.at(ch1), "ch1_data");
 }
 
+TEST(PublisherRuntimeTerminalTest, PublishBatchWritesAllViewsInOrder)
+{
+    TokenRegistry reg;
+    OutputResourceStore store;
+    TestStreams ts;
+    ts.bind(store);
+
+    auto tok = reg.acquire();
+    const std::string staged = "r1\nr2\nr3\n";
+    const std::string_view sv = staged;
+    const std::string_view views[] = {sv.substr(0, 3), sv.substr(3, 3), sv.substr(6, 3)};
+
+    PublisherRuntime<SinkKind::Terminal>::publish_batch(reg, store, tok, views);
+
+    EXPECT_EQ(ts.at(reg.resolve(tok)), "r1\nr2\nr3\n");
+    EXPECT_EQ(ts.writtenCount(), 1);
+}
+
 // ─── PublisherRuntime<File> ──────────────────────────────────────
 
 TEST(PublisherRuntimeFileTest, PublishViewWritesToBoundFile)
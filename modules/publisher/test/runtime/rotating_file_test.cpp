@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/publisher_runtime.hpp"
+#include "publisher/runtime/resource_store.hpp"
+#include "publisher/runtime/rotating_file.hpp"
+#include "publisher/runtime/token_registry.hpp"
+
+using namespace publisher::core;
+using namespace publisher::runtime;
+using namespace std::chrono_literals;
+
+// ─── Helper ──────────────────────────────────────────────────────
+
+namespace {
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}};
+    }
+
+    // Fresh path with no leftovers from an earlier run (rotated files too).
+    std::string fresh_path(const std::string& name)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(path.c_str());
+        for (int i = 1; i <= 8; ++i)
+            std::remove((path + '.' + std::to_string(i)).c_str());
+        return path;
+    }
+
+    FileSinkConfig config(const std::string& path)
+    {
+        FileSinkConfig cfg;
+        cfg.path = path;
+        cfg.buffer_bytes = 64;
+        cfg.flush_interval = 1h;
+        return cfg;
+    }
+}
+
+// ─── Buffering ───────────────────────────────────────────────────
+
+TEST(RotatingFileTest, BuffersUntilFlush)
+{
+    const auto path = fresh_path("rotating_buffers.log");
+    RotatingFile f;
+    ASSERT_TRUE(f.open(config(path)));
+
+    f.write("abc;");
+    f.write("def;");
+    EXPECT_EQ(f.buffered(), 8u);
+    EXPECT_EQ(read_file(path), "");
+
+    f.flush();
+    EXPECT_EQ(f.buffered(), 0u);
+    EXPECT_EQ(read_file(path), "abc;def;");
+    EXPECT_EQ(f.flushes(), 1u);
+}
+
+TEST(RotatingFileTest, FlushesWhenBufferFills)
+{
+    const auto path = fresh_path("rotating_fills.log");
+    RotatingFile f;
+    ASSERT_TRUE(f.open(config(path)));
+
+    const std::string rec(40, 'x');
+    f.write(rec);
+    f.write(rec);                   // does not fit next to the first
+
+    EXPECT_EQ(read_file(path), rec);
+    EXPECT_EQ(f.buffered(), rec.size());
+}
+
+TEST(RotatingFileTest, OversizedRecordBypassesBuffer)
+{
+    const auto path = fresh_path("rotating_oversized.log");
+    RotatingFile f;
+    ASSERT_TRUE(f.open(config(path)));
+
+    f.write("head;");
+    const std::string big(200, 'b');
+    f.write(big);
+
+    EXPECT_EQ(f.buffered(), 0u);
+    EXPECT_EQ(read_file(path), "head;" + big);
+}
+
+TEST(RotatingFileTest, TickFlushesAfterInterval)
+{
+    const auto path = fresh_path("rotating_tick.log");
+    auto cfg = config(path);
+    cfg.flush_interval = 10ms;
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    const auto t0 = RotatingFile::clock::now();
+
+    f.write("r;", t0);
+    f.tick(t0 + 1ms);
+    EXPECT_EQ(f.buffered(), 2u);
+    EXPECT_LE(f.flush_due(), t0 + 10ms);
+
+    f.tick(t0 + 1s);
+    EXPECT_EQ(f.buffered(), 0u);
+    EXPECT_EQ(read_file(path), "r;");
+    EXPECT_GT(f.flush_due(), t0 + 10ms);
+}
+
+TEST(RotatingFileTest, AppendsAndCloseFlushes)
+{
+    const auto path = fresh_path("rotating_append.log");
+    {
+        RotatingFile f;
+        ASSERT_TRUE(f.open(config(path)));
+        f.write("one;");
+    }
+    {
+        RotatingFile f;
+        ASSERT_TRUE(f.open(config(path)));
+        f.write("two;");
+    }
+    EXPECT_EQ(read_file(path), "one;two;");
+}
+
+TEST(RotatingFileTest, OpenFailsForMissingDirectory)
+{
+    RotatingFile f;
+    EXPECT_FALSE(f.open(config("/nonexistent-dir/x/rotating.log")));
+    EXPECT_FALSE(f.is_open());
+    f.write("ignored");             // no-op, no crash
+}
+
+// ─── Rotation ────────────────────────────────────────────────────
+
+TEST(RotatingFileTest, RotatesBySizeWithoutSplittingRecords)
+{
+    const auto path = fresh_path("rotating_size.log");
+    auto cfg = config(path);
+    cfg.rotate_bytes = 10;
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    f.write("aaaa;");
+    f.write("bbbb;");
+    f.write("cccc;");               // 15 > 10: rotate first
+    f.flush();
+
+    EXPECT_EQ(f.rotations(), 1u);
+    EXPECT_EQ(read_file(path + ".1"), "aaaa;bbbb;");
+    EXPECT_EQ(read_file(path), "cccc;");
+}
+
+TEST(RotatingFileTest, KeepsAtMostKeepFiles)
+{
+    const auto path = fresh_path("rotating_keep.log");
+    auto cfg = config(path);
+    cfg.rotate_bytes = 4;
+    cfg.keep_files = 2;
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    for (const char* rec : {"r1;", "r2;", "r3;", "r4;"})
+        f.write(rec);
+    f.flush();
+
+    EXPECT_EQ(f.rotations(), 3u);
+    EXPECT_EQ(read_file(path), "r4;");
+    EXPECT_EQ(read_file(path + ".1"), "r3;");
+    EXPECT_EQ(read_file(path + ".2"), "r2;");
+    EXPECT_FALSE(std::filesystem::exists(path + ".3"));
+}
+
+TEST(RotatingFileTest, RotatesByAgeOnTick)
+{
+    const auto path = fresh_path("rotating_age.log");
+    auto cfg = config(path);
+    cfg.rotate_age = 60s;
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    const auto t0 = RotatingFile::clock::now();
+
+    f.write("old;", t0);
+    f.tick(t0 + 1s);
+    EXPECT_EQ(f.rotations(), 0u);
+
+    f.tick(t0 + 61s);
+    EXPECT_EQ(f.rotations(), 1u);
+    f.write("new;", t0 + 62s);
+    f.flush();
+
+    EXPECT_EQ(read_file(path + ".1"), "old;");
+    EXPECT_EQ(read_file(path), "new;");
+}
+
+TEST(RotatingFileTest, HeaderStartsEveryFile)
+{
+    const auto path = fresh_path("rotating_header.log");
+    auto cfg = config(path);
+    cfg.rotate_bytes = 12;
+    cfg.header = "HDR|";
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    f.write("1111;");
+    f.write("2222;");
+    f.flush();
+
+    EXPECT_EQ(read_file(path + ".1"), "HDR|1111;");
+    EXPECT_EQ(read_file(path), "HDR|2222;");
+}
+
+TEST(RotatingFileTest, HeaderOnlyFileIsNotRotated)
+{
+    const auto path = fresh_path("rotating_header_only.log");
+    auto cfg = config(path);
+    cfg.rotate_age = 1s;
+    cfg.header = "HDR|";
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    f.tick(RotatingFile::clock::now() + 1h);
+    EXPECT_EQ(f.rotations(), 0u);
+}
+
+// ─── PublisherRuntime<File> with a RotatingFile ──────────────────
+
+TEST(PublisherRuntimeFileTest, PublishBatchGoesThroughWriter)
+{
+    const auto path = fresh_path("rotating_runtime.log");
+    RotatingFile f;
+    ASSERT_TRUE(f.open(config(path)));
+
+    TokenRegistry reg;
+    OutputResourceStore store;
+    auto tok = reg.acquire();
+    store.files[reg.resolve(tok)].writer = &f;
+
+    const std::string text = "a;bb;ccc;";
+    const std::vector<std::string_view> views{
+        std::string_view{text}.substr(0, 2),
+        std::string_view{text}.substr(2, 3),
+        std::string_view{text}.substr(5, 4)};
+
+    PublisherRuntime<SinkKind::File>::publish_batch(reg, store, tok, views);
+    PublisherRuntime<SinkKind::File>::publish_view(reg, store, tok, "d;");
+    EXPECT_EQ(f.buffered(), 11u);
+
+    f.flush();
+    EXPECT_EQ(read_file(path), "a;bb;ccc;d;");
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/publisher_runtime.hpp"
+#include "publisher/runtime/resource_store.hpp"
+#include "publisher/runtime/token_registry.hpp"
+#include "publisher/runtime/uring_file.hpp"
+
+using namespace publisher::core;
+using namespace publisher::runtime;
+
+// ─── Helper ──────────────────────────────────────────────────────
+
+namespace {
+    std::string read_file(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}};
+    }
+
+    std::string fresh_path(const std::string& name)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(path.c_str());
+        return path;
+    }
+
+    AsyncFileConfig config(const std::string& path, bool force_sync = false)
+    {
+        AsyncFileConfig cfg;
+        cfg.path = path;
+        cfg.buffer_bytes = 4096;
+        cfg.buffers = 4;
+        cfg.force_sync = force_sync;
+        return cfg;
+    }
+
+    // Run against io_uring where the host has it, and the forced fallback.
+    // ctest runs the two instances as separate processes, possibly at the
+    // same time, so each backend gets its own file.
+    class UringFileTest : public ::testing::TestWithParam<bool>
+    {
+    protected:
+        static std::string backend_path(const std::string& name)
+        {
+            return fresh_path((GetParam() ? "sync_" : "uring_") + name);
+        }
+    };
+}
+
+// ─── Both backends ───────────────────────────────────────────────
+
+TEST_P(UringFileTest, WritesRecordsInOrder)
+{
+    const auto path = backend_path("order.log");
+    auto cfg = config(path, GetParam());
+    cfg.buffer_bytes = 64 * 1024;   // everything fits: nothing can be dropped
+
+    UringFile f;
+    ASSERT_TRUE(f.open(cfg));
+
+    std::string expected;
+    for (int i = 0; i < 5000; ++i)
+    {
+        const std::string rec = "record-" + std::to_string(i) + ";";
+        f.write(rec);
+        expected += rec;
+    }
+    f.close();
+
+    EXPECT_EQ(read_file(path), expected);
+    EXPECT_EQ(f.dropped(), 0u);
+}
+
+TEST_P(UringFileTest, HeaderOnNewFileOnly)
+{
+    const auto path = backend_path("header.log");
+    auto cfg = config(path, GetParam());
+    cfg.header = "HDR|";
+    {
+        UringFile f;
+        ASSERT_TRUE(f.open(cfg));
+        f.write("a;");
+    }
+    {
+        UringFile f;
+        ASSERT_TRUE(f.open(cfg));
+        f.write("b;");
+    }
+    EXPECT_EQ(read_file(path), "HDR|a;b;");
+}
+
+TEST_P(UringFileTest, RecordLargerThanBufferSpansBuffers)
+{
+    const auto path = backend_path("large.log");
+    UringFile f;
+    ASSERT_TRUE(f.open(config(path, GetParam())));
+
+    const std::string big(10000, 'z');
+    f.write("x;");
+    f.write(big);
+    f.close();
+
+    EXPECT_EQ(read_file(path), "x;" + big);
+}
+
+TEST_P(UringFileTest, PublishBatchThroughRuntime)
+{
+    const auto path = backend_path("runtime.log");
+    UringFile f;
+    ASSERT_TRUE(f.open(config(path, GetParam())));
+
+    TokenRegistry reg;
+    OutputResourceStore store;
+    auto tok = reg.acquire();
+    store.async_files[reg.resolve(tok)].writer = &f;
+
+    const std::vector<std::string_view> views{"a;", "bb;", "ccc;"};
+    PublisherRuntime<SinkKind::AsyncFile>::publish_batch(reg, store, tok, views);
+    PublisherRuntime<SinkKind::AsyncFile>::publish_view(reg, store, tok, "d;");
+    f.close();
+
+    EXPECT_EQ(read_file(path), "a;bb;ccc;d;");
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Backends,
+    UringFileTest,
+    ::testing::Values(false, true),
+    [](const auto& info) { return info.param ? std::string("Sync") : std::string("IoUring"); }
+);
+
+// ─── io_uring specifics ──────────────────────────────────────────
+
+TEST(UringFileAsyncTest, ForceSyncUsesFallback)
+{
+    const auto path = fresh_path("uring_force_sync.log");
+    UringFile f;
+    ASSERT_TRUE(f.open(config(path, true)));
+    EXPECT_FALSE(f.async());
+    EXPECT_TRUE(f.fallback().is_open());
+}
+
+TEST(UringFileAsyncTest, FlushDoesNotWaitButDrainDoes)
+{
+    const auto path = fresh_path("uring_drain.log");
+    UringFile f;
+    ASSERT_TRUE(f.open(config(path)));
+    if (!f.async())
+        GTEST_SKIP() << "io_uring unavailable on this host";
+
+    f.write("pending;");
+    f.flush();
+    EXPECT_EQ(f.submits(), 1u);
+
+    f.drain();
+    EXPECT_EQ(f.in_flight(), 0u);
+    EXPECT_EQ(f.bytes_written(), 8u);
+    EXPECT_EQ(read_file(path), "pending;");
+}
+
+TEST(UringFileAsyncTest, OpenFailsForMissingDirectory)
+{
+    UringFile f;
+    EXPECT_FALSE(f.open(config("/nonexistent-dir/x/uring.log")));
+    EXPECT_FALSE(f.is_open());
+}
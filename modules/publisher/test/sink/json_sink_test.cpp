@@ -3,43 +3,57 @@
 #include <string_view>
 #include "publisher/sink_publisher.hpp"
 
-// Include your real header here, e.g.:
-// #include "logger/core/sink.hpp"
-
-// For clarity in the example we assume JsonSink is in the global namespace.
-
-TEST(JsonSinkTest, FormatsLiteralWithPrefix) {
+TEST(JsonSinkTest, PlainTextBecomesMsg) {
     JsonSink sink{};
-    std::string_view input{"ABC"};
-
-    // Call the generic interface provided by SinkBase.
-    auto result = sink.format(input);
-
-    // Expect the prefix "JsonTest" followed by the original content.
-    EXPECT_EQ(result, "JsonTestABC");
+    EXPECT_EQ(sink.format("ABC"), R"({"msg":"ABC"})");
 }
 
 TEST(JsonSinkTest, FormatsEmptyString) {
     JsonSink sink{};
-    std::string_view input{""};
-
-    // An empty input should still return just the prefix.
-    auto result = sink.format(input);
-
-    EXPECT_EQ(result, "JsonTest");
+    EXPECT_EQ(sink.format(""), "{}");
 }
 
 TEST(JsonSinkTest, AcceptsViewFromStdString) {
     JsonSink sink{};
     std::string tmp = "payload";
-
-    // Simulate a typical usage pattern:
-    // we build a std::string, then pass a string_view into the sink.
     std::string_view view{tmp};
+    EXPECT_EQ(sink.format(view), R"({"msg":"payload"})");
+}
+
+TEST(JsonSinkTest, HeaderLineBecomesObject) {
+    const auto result = JsonSink::format(
+        "[tag=1] severity=Error timestamp=99 thread_id=1 request_id=2 class_id=5 method_id=6 schema_version=2 ");
+    EXPECT_EQ(result,
+              R"({"tag":"Request","severity":"Error","timestamp":99,"thread_id":1,"request_id":2,)"
+              R"("class_id":5,"method_id":6,"schema_version":2})");
+}
+
+TEST(JsonSinkTest, UnknownTagStaysANumber) {
+    EXPECT_EQ(JsonSink::format("[tag=200] a=1"), R"({"tag":200,"a":1})");
+}
+
+TEST(JsonSinkTest, NumbersFollowJsonGrammar) {
+    EXPECT_EQ(JsonSink::format("a=-1.5e3 b=007 c=1. d=+1 e=0"),
+              R"({"a":-1.5e3,"b":"007","c":"1.","d":"+1","e":0})");
+}
+
+TEST(JsonSinkTest, ValueKeepsSpacesUpToNextKey) {
+    EXPECT_EQ(JsonSink::format("path=/a b  c code=7"), R"({"path":"/a b  c","code":7})");
+}
+
+TEST(JsonSinkTest, TextBeforeFirstKeyIsMsg) {
+    EXPECT_EQ(JsonSink::format("hello there x=1"), R"({"msg":"hello there","x":1})");
+}
+
+TEST(JsonSinkTest, EscapesStrings) {
+    EXPECT_EQ(JsonSink::format("p=a\"b\\c\td"), R"({"p":"a\"b\\c\td"})");
+}
 
-    auto result = sink.format(view);
+TEST(JsonSinkTest, FormatToReportsFullLength) {
+    const std::string_view line = "k=some-value";
+    const std::string full = JsonSink::format(line);
 
-    // The sink should not care about the original storage,
-    // only about the characters visible through std::string_view.
-    EXPECT_EQ(result, "JsonTestpayload");
+    char buf[8];
+    EXPECT_EQ(JsonSink::format_to(line, buf, sizeof(buf)), full.size());
+    EXPECT_EQ(std::string_view(buf, sizeof(buf)), std::string_view(full).substr(0, sizeof(buf)));
 }
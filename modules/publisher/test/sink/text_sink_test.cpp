@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <string>
 #include "publisher/sink_publisher.hpp"
 
 TEST(TextSinkTest, PassthroughWhenNoTokens) {
@@ -30,6 +31,20 @@ TEST(TextSinkTest, FormatsTimestamp) {
     EXPECT_EQ(result.find("timestamp=1000000"), std::string::npos);
 }
 
+TEST(TextSinkTest, TimestampKeepsMicrosecondsWithinOneSecond) {
+    // Same second twice (the cached prefix), then the next second.
+    auto a = TextSink::format("timestamp=86400000007");
+    auto b = TextSink::format("timestamp=86400999999");
+    auto c = TextSink::format("timestamp=86401000000");
+
+    EXPECT_EQ(a.substr(0, a.size() - 6), b.substr(0, b.size() - 6));
+    EXPECT_EQ(a.substr(a.size() - 7), ".000007");
+    EXPECT_EQ(b.substr(b.size() - 7), ".999999");
+    EXPECT_NE(c.substr(0, c.size() - 6), b.substr(0, b.size() - 6));
+    EXPECT_EQ(c.substr(c.size() - 7), ".000000");
+    EXPECT_EQ(a.size(), std::string("timestamp=1970-01-02 00:00:00.000007").size());
+}
+
 TEST(TextSinkTest, HandlesMultipleTokensInLine) {
     auto result = TextSink::format(
         "severity=Info timestamp=1000000 class_id=0 method_id=0 end");
@@ -38,3 +53,43 @@ TEST(TextSinkTest, HandlesMultipleTokensInLine) {
     EXPECT_NE(result.find("class_id=Server"), std::string::npos);
     EXPECT_NE(result.find("method_id=AddEvent"), std::string::npos);
 }
+
+TEST(TextSinkTest, ResolvesTokensInAnyOrder) {
+    auto result = TextSink::format("class_id=0 method_id=0 timestamp=1000000");
+    EXPECT_NE(result.find("class_id=Server"), std::string::npos);
+    EXPECT_NE(result.find("method_id=AddEvent"), std::string::npos);
+    EXPECT_NE(result.find("timestamp=1970"), std::string::npos);
+}
+
+TEST(TextSinkTest, RewritesWholeKeysOnly) {
+    EXPECT_EQ(TextSink::format("req_timestamp=5 subclass_id=0"), "req_timestamp=5 subclass_id=0");
+}
+
+TEST(TextSinkTest, LeavesUnparsableValuesAlone) {
+    EXPECT_EQ(TextSink::format("class_id=abc method_id=65000 timestamp="),
+              "class_id=abc method_id=65000 timestamp=");
+}
+
+TEST(TextSinkTest, FormatToMatchesFormat) {
+    const std::string_view line = "[tag=1] severity=Info timestamp=1700000000123456 thread_id=3 "
+                                  "class_id=0 method_id=0 path=/a?b=c";
+    char buf[256];
+    const std::size_t n = TextSink::format_to(line, buf, sizeof(buf));
+    EXPECT_EQ(std::string_view(buf, n), TextSink::format(line));
+}
+
+TEST(TextSinkTest, FormatToReportsFullLengthWhenTruncated) {
+    const std::string_view line = "class_id=0 rest";
+    const std::string full = TextSink::format(line);
+
+    char buf[8];
+    EXPECT_EQ(TextSink::format_to(line, buf, sizeof(buf)), full.size());
+    EXPECT_EQ(std::string_view(buf, sizeof(buf)), std::string_view(full).substr(0, sizeof(buf)));
+}
+
+TEST(TextSinkTest, LongLineFallsBackToHeap) {
+    const std::string line = "class_id=0 " + std::string(TextSink::kStackLine * 2, 'x');
+    const std::string result = TextSink::format(line);
+    EXPECT_EQ(result.size(), line.size() - 1 + std::string("Server").size());
+    EXPECT_EQ(result.substr(0, 15), "class_id=Server");
+}
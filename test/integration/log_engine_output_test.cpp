@@ -0,0 +1,581 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "logger/codec/binary_codec.hpp"
+#include "logger/logger.hpp"
+
+// The real LogEngine end to end. It is a process-wide singleton that can be
+// configured once, so every test runs its engine in a forked child (a death
+// test expected to exit 0) and the parent checks what it left on disk.
+// Inside the child a failed check prints why and exits non-zero.
+
+using logger::core::EngineConfig;
+using logger::core::FileBackend;
+using logger::core::Overflow;
+using logger::core::QueueMode;
+using logger::core::SinkFormat;
+using logger::core::WaitStrategy;
+using logger::core::detail::LogEngine;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string fresh_path(const std::string& name) {
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              (name + "." + std::to_string(::getpid()))).string();
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}};
+}
+
+std::uintmax_t file_size(const std::string& path) {
+    std::error_code ec;
+    const auto n = std::filesystem::file_size(path, ec);
+    return ec ? 0 : n;
+}
+
+[[noreturn]] void child_fail(const char* why) {
+    std::fprintf(stderr, "%s\n", why);
+    std::_Exit(1);
+}
+
+void log_generic(std::uint64_t ts) {
+    logger::Handler::log<MsgTag::Generic>(Severity::Info, ts, std::uint32_t{1}, std::uint32_t{0},
+                                          std::uint16_t{1}, std::uint16_t{4}, std::uint16_t{1});
+}
+
+// Handler::log of a Request whose path lives in a heap buffer that is
+// overwritten and freed as soon as the call returns.
+template <Overflow Policy = Overflow::DropNewest>
+void log_request(Severity sev, std::uint64_t id, std::size_t path_len) {
+    auto* path = new std::string(path_len, static_cast<char>('a' + id % 26));
+    (*path)[0] = '/';
+    logger::Handler::log<MsgTag::Request, Policy>(sev, std::uint64_t{100 + id}, std::uint32_t{2}, std::uint32_t{3},
+                                                  std::uint16_t{1}, std::uint16_t{4}, std::uint16_t{1},
+                                                  std::uint64_t{id}, std::string_view{*path});
+    path->assign(path->size(), '#');
+    delete path;
+}
+
+// The Json line the worker should write for log_request(sev, id, path_len).
+std::string request_line(Severity sev, std::uint64_t id, std::size_t path_len) {
+    std::string path(path_len, static_cast<char>('a' + id % 26));
+    path[0] = '/';
+    return "{\"tag\":\"Request\",\"severity\":\"" + std::string(toString(sev)) +
+           "\",\"timestamp\":" + std::to_string(100 + id) +
+           ",\"thread_id\":2,\"request_id\":3,\"class_id\":1,\"method_id\":4,\"schema_version\":1"
+           ",\"req_unique_id\":" + std::to_string(id) + ",\"path\":\"" + path + "\"}\n";
+}
+
+// The terminal sinks write to std::cout; in the child it is pointed at a
+// string for the lifetime of this object.
+struct CapturedStdout {
+    std::ostringstream text;
+    std::streambuf* saved = std::cout.rdbuf(text.rdbuf());
+    ~CapturedStdout() { std::cout.rdbuf(saved); }
+};
+
+[[noreturn]] void child_fail_output(const char* why, const std::string& got, const std::string& want) {
+    std::fprintf(stderr, "%s\n got: %s\nwant: %s\n", why, got.c_str(), want.c_str());
+    std::_Exit(1);
+}
+
+// An envelope outside the codec schema: it only knows how to print itself.
+struct Note {
+    int n;
+    void debug_print(std::ostream& os) const { os << "note " << n; }
+};
+
+constexpr bool kSampledSiteCompiled =
+    logger::filter::compiled_in<Severity::Warn, LogClassId::Handler, MethodId::Handler_handlingEvent>;
+
+// Every other call is suppressed; the admitted ones after the first carry
+// suppressed=1 (limit::Folded).
+void log_every_2nd(std::uint64_t ts) {
+    LOGGER_LOG_EVERY_N(2, Generic, Warn, Handler, handlingEvent,
+                       ts, std::uint32_t{2}, std::uint32_t{3}, std::uint16_t{1});
+}
+
+// The worker parks more than `n` times before a generous deadline; a
+// loaded box may take a while to schedule it.
+bool parks_above(const LogEngine& eng, std::uint64_t n) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (eng.parks() <= n) {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+EngineConfig binary_config(const std::string& path, std::chrono::milliseconds flush_interval) {
+    EngineConfig cfg;
+    cfg.sink_format = SinkFormat::Binary;
+    cfg.binary_file.path = path;
+    cfg.binary_file.flush_interval = flush_interval;
+    return cfg;
+}
+
+} // namespace
+
+// Quiet spells do not flush the file sink early: records wait in its buffer
+// for flush_interval, and shutdown writes the rest.
+TEST(LogEngineOutput, FileSinkKeepsFlushInterval) {
+    const std::string path = fresh_path("engine_flush_interval.bin");
+
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(binary_config(path, 1h)))
+            child_fail("configure failed");
+        for (std::uint64_t i = 1; i <= 3; ++i) {
+            log_generic(i);
+            std::this_thread::sleep_for(20ms);       // the worker goes idle
+        }
+        if (file_size(path) != sizeof(logger::codec::FileHeader))
+            child_fail("records reached the file before flush_interval");
+        eng.shutdown();
+        std::_Exit(eng.written() == 3 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    EXPECT_GT(file_size(path), sizeof(logger::codec::FileHeader));
+    std::remove(path.c_str());
+}
+
+// An idle worker still flushes once flush_interval is up, without a new
+// record to wake it.
+TEST(LogEngineOutput, IdleWorkerFlushesWhenIntervalIsUp) {
+    const std::string path = fresh_path("engine_flush_idle.bin");
+
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(binary_config(path, 10ms)))
+            child_fail("configure failed");
+        log_generic(1);
+        std::this_thread::sleep_for(200ms);
+        if (file_size(path) <= sizeof(logger::codec::FileHeader))
+            child_fail("idle worker never flushed");
+        eng.shutdown();
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    std::remove(path.c_str());
+}
+
+// Bytes waiting for flush_interval do not keep the worker polling: it parks
+// until the flush is due or a record arrives.
+TEST(LogEngineOutput, WorkerParksWhileFileHoldsBytes) {
+    const std::string path = fresh_path("engine_flush_park.bin");
+
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        EngineConfig cfg = binary_config(path, 1h);
+        cfg.wait.strategy = WaitStrategy::Park;
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_generic(1);
+        if (!parks_above(eng, 0))
+            child_fail("worker never parked with bytes buffered");
+        const std::uint64_t parked = eng.parks();
+        log_generic(2);
+        if (!parks_above(eng, parked))
+            child_fail("worker did not park again after the second record");
+        std::this_thread::sleep_for(50ms);
+        if (file_size(path) != sizeof(logger::codec::FileHeader))
+            child_fail("records reached the file before flush_interval");
+        if (eng.parks() > parked + 8)
+            child_fail("worker kept waking while bytes were buffered");
+        eng.shutdown();
+        std::_Exit(eng.written() == 2 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    std::remove(path.c_str());
+}
+
+// Likewise a repeat held for its coalescing window: the worker parks until
+// the window closes rather than polling through it.
+TEST(LogEngineOutput, WorkerParksThroughCoalescingWindow) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        LogEngine& eng = LogEngine::instance();
+        EngineConfig cfg;
+        cfg.coalesce.window = 1h;
+        cfg.wait.strategy = WaitStrategy::Park;
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_generic(1);
+        log_generic(2);                             // held as a repeat
+        if (!parks_above(eng, 0))
+            child_fail("worker never parked with a repeat pending");
+        const std::uint64_t parked = eng.parks();
+        log_generic(3);
+        if (!parks_above(eng, parked))
+            child_fail("worker did not park again with a repeat pending");
+        std::this_thread::sleep_for(50ms);
+        if (eng.parks() > parked + 8)
+            child_fail("worker kept waking through the coalescing window");
+        eng.shutdown();
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// And records held for the reorder window: the worker parks until the
+// oldest one is due.
+TEST(LogEngineOutput, WorkerParksThroughReorderWindow) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        LogEngine& eng = LogEngine::instance();
+        EngineConfig cfg;
+        cfg.ordering.reorder_window = 1h;
+        cfg.wait.strategy = WaitStrategy::Park;
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_generic(1);
+        if (!parks_above(eng, 0))
+            child_fail("worker never parked with records held");
+        const std::uint64_t parked = eng.parks();
+        log_generic(2);
+        if (!parks_above(eng, parked))
+            child_fail("worker did not park again with records held");
+        std::this_thread::sleep_for(50ms);
+        if (eng.parks() > parked + 8)
+            child_fail("worker kept waking through the reorder window");
+        eng.shutdown();
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// A configure() that fails part way closes what it opened on earlier
+// workers and removes the files it created; the engine can then be
+// configured afresh.
+TEST(LogEngineOutput, FailedConfigureClosesOpenedSinks) {
+    const std::string path = fresh_path("engine_configure_fail.bin");
+    const std::string ring = fresh_path("engine_configure_fail.ring");
+    std::filesystem::create_directory(ring + ".w1");    // worker 1's ring cannot open
+
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        EngineConfig cfg = binary_config(path, 1h);
+        cfg.workers = 2;
+        cfg.crash_ring.path = ring;
+        if (eng.configure(cfg))
+            child_fail("configure succeeded");
+        for (const std::string& p : {path, path + ".w1", ring})
+            if (std::filesystem::exists(p))
+                child_fail("configure left a file behind");
+        if (!eng.configure(binary_config(path, 1h)))
+            child_fail("configure after a failure failed");
+        log_generic(1);
+        eng.shutdown();
+        std::_Exit(eng.written() == 1 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    EXPECT_GT(file_size(path), sizeof(logger::codec::FileHeader));
+    std::remove(path.c_str());
+    std::filesystem::remove(ring + ".w1");
+}
+
+// Configuring again with another format closes the previous binary file.
+TEST(LogEngineOutput, ReconfigureClosesPreviousFile) {
+    const std::string path = fresh_path("engine_reconfigure.bin");
+
+    EXPECT_EXIT({
+        CapturedStdout out;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(binary_config(path, 1h)))
+            child_fail("configure failed");
+        const EngineConfig terminal;
+        if (!eng.configure(terminal))
+            child_fail("second configure failed");
+        for (const auto& fd : std::filesystem::directory_iterator("/proc/self/fd")) {
+            std::error_code ec;
+            if (std::filesystem::read_symlink(fd.path(), ec) == path)
+                child_fail("previous binary file still open");
+        }
+        log_generic(1);
+        eng.shutdown();
+        if (out.text.str().empty())
+            child_fail("record did not reach the terminal");
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    EXPECT_EQ(file_size(path), sizeof(logger::codec::FileHeader));
+    std::remove(path.c_str());
+}
+
+// TextFile writes the terminal's lines through the same buffered file as
+// Binary: nothing reaches the file before flush_interval, nothing reaches
+// std::cout, and shutdown writes every line.
+TEST(LogEngineOutput, TextFileKeepsFlushInterval) {
+    const std::string path = fresh_path("engine_text_file.txt");
+
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::TextFile;
+        cfg.text_file.path = path;
+        cfg.text_file.flush_interval = 1h;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        for (std::uint64_t i = 1; i <= 3; ++i) {
+            log_generic(i);
+            std::this_thread::sleep_for(20ms);       // the worker goes idle
+        }
+        if (file_size(path) != 0)
+            child_fail("lines reached the file before flush_interval");
+        eng.shutdown();
+        if (!out.text.str().empty())
+            child_fail("lines reached the terminal");
+        std::_Exit(eng.written() == 3 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    const std::string text = read_file(path);
+    std::size_t records = 0;
+    for (auto at = text.find("[tag="); at != std::string::npos; at = text.find("[tag=", at + 1))
+        ++records;
+    EXPECT_EQ(records, 3u);
+    std::remove(path.c_str());
+}
+
+// JsonFile writes the same lines as Json, with no codec header.
+TEST(LogEngineOutput, JsonFileWritesJsonLines) {
+    const std::string path = fresh_path("engine_json_file.txt");
+
+    EXPECT_EXIT({
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::JsonFile;
+        cfg.text_file.path = path;
+        cfg.text_file.flush_interval = 1h;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_request(Severity::Warn, 1, 18);
+        eng.shutdown();
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    EXPECT_EQ(read_file(path), request_line(Severity::Warn, 1, 18));
+    std::remove(path.c_str());
+}
+
+// Every record the worker wrote either reached the io_uring file or is
+// counted in file_dropped() (every buffer in flight); none vanish.
+TEST(LogEngineOutput, AsyncFileAccountsForEveryWrittenRecord) {
+    const std::string path = fresh_path("engine_async_file.bin");
+
+    EXPECT_EXIT({
+        EngineConfig cfg = binary_config(path, 100ms);
+        cfg.binary_backend = FileBackend::IoUring;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        for (std::uint64_t i = 1; i <= 20000; ++i)
+            log_generic(i);
+        eng.shutdown();
+
+        std::ostringstream text;
+        const auto sum = logger::codec::decode_to(read_file(path), text, logger::codec::OutputFormat::Text);
+        if (!sum.header_ok || sum.truncated || sum.skipped)
+            child_fail("unreadable output");
+        if (sum.records + eng.file_dropped() != eng.written())
+            child_fail("written records neither in the file nor in file_dropped()");
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+
+    std::remove(path.c_str());
+}
+
+// Handler::log<MsgTag::Request> on the real engine goes through emplace:
+// the worker's Json line has every field, and the path the caller freed
+// right after the call comes out intact from its copy in the record.
+TEST(LogEngineOutput, RequestThroughHandlerKeepsFreedPath) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_request(Severity::Warn, 1, 18);
+        eng.shutdown();
+
+        if (eng.spill_stats().spilled != 0)
+            child_fail("a short path was spilled");
+        const std::string want = request_line(Severity::Warn, 1, 18);
+        if (out.text.str() != want)
+            child_fail_output("wrong line", out.text.str(), want);
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// A path longer than what is left of the record after the payload is
+// copied into the spill arena instead, still whole.
+TEST(LogEngineOutput, LongRequestPathIsSpilledWhole) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_request(Severity::Info, 2, 600);
+        eng.shutdown();
+
+        if (eng.spill_stats().spilled != 1)
+            child_fail("the path was not spilled");
+        if (eng.truncated_strings() != 0)
+            child_fail("the path was cut");
+        const std::string want = request_line(Severity::Info, 2, 600);
+        if (out.text.str() != want)
+            child_fail_output("wrong line", out.text.str(), want);
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// emplace has no payload before the record, so BySeverity decides on the
+// severity probed from the first field. With Info shed at any occupancy,
+// only the Info call is refused.
+TEST(LogEngineOutput, BySeverityShedsOnEmplacedSeverity) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        cfg.overflow.shed_info_percent = 0;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_request<Overflow::BySeverity>(Severity::Info, 3, 10);
+        log_request<Overflow::BySeverity>(Severity::Error, 4, 10);
+        log_request<Overflow::BySeverity>(Severity::Warn, 5, 10);
+        eng.shutdown();
+
+        if (eng.overflow_stats().shed_by_severity != 1 || eng.dropped() != 1)
+            child_fail("expected exactly the Info record shed");
+        const std::string want = request_line(Severity::Error, 4, 10) + request_line(Severity::Warn, 5, 10);
+        if (out.text.str() != want)
+            child_fail_output("wrong lines", out.text.str(), want);
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// Under SpscLanes BySeverity measures the producer's lane instead of the
+// pool, rather than falling back to DropNewest.
+TEST(LogEngineOutput, BySeverityShedsOnLanePath) {
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        cfg.queue_mode = QueueMode::SpscLanes;
+        cfg.overflow.shed_info_percent = 0;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        log_request<Overflow::BySeverity>(Severity::Info, 3, 10);
+        log_request<Overflow::BySeverity>(Severity::Error, 4, 10);
+        eng.shutdown();
+
+        if (eng.overflow_stats().shed_by_severity != 1 || eng.dropped() != 1)
+            child_fail("expected exactly the Info record shed");
+        const std::string want = request_line(Severity::Error, 4, 10);
+        if (out.text.str() != want)
+            child_fail_output("wrong lines", out.text.str(), want);
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// Records a sampled site folds its skipped calls into are frames like any
+// other: the binary file decodes whole (logdecode's decode_to), with
+// suppressed after the schema's fields, and the JSON sink writes the same
+// objects.
+TEST(LogEngineOutput, FoldedRecordsRoundTripInBinaryAndJson) {
+    if constexpr (!kSampledSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    const std::string path = fresh_path("engine_folded.bin");
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(binary_config(path, 1h)))
+            child_fail("configure failed");
+        for (std::uint64_t i = 1; i <= 5; ++i)
+            log_every_2nd(i);
+        eng.shutdown();
+        std::_Exit(eng.written() == 3 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    const std::string file = read_file(path);
+    std::ostringstream text, json;
+    const auto sum = logger::codec::decode_to(file, text, logger::codec::OutputFormat::Text);
+    logger::codec::decode_to(file, json, logger::codec::OutputFormat::Json);
+    EXPECT_TRUE(sum.header_ok);
+    EXPECT_FALSE(sum.truncated);
+    EXPECT_EQ(sum.records, 3u);
+    EXPECT_EQ(sum.skipped, 0u);
+
+    std::istringstream text_lines(text.str());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(text_lines, line);)
+        lines.push_back(line);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0].find("suppressed="), std::string::npos);
+    EXPECT_NE(lines[1].find("timestamp=3 "), std::string::npos);
+    EXPECT_EQ(lines[1].substr(lines[1].size() - 13), "suppressed=1 ");
+    EXPECT_EQ(lines[2].substr(lines[2].size() - 13), "suppressed=1 ");
+    std::remove(path.c_str());
+
+    EXPECT_EXIT({
+        CapturedStdout out;
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            child_fail("configure failed");
+        for (std::uint64_t i = 1; i <= 5; ++i)
+            log_every_2nd(i);
+        eng.shutdown();
+        if (out.text.str() != json.str())
+            child_fail_output("JSON sink differs from the decoded file", out.text.str(), json.str());
+        std::_Exit(0);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// Under SinkFormat::Binary an envelope the codec has no schema for is a
+// text frame, so the records after it still decode.
+TEST(LogEngineOutput, NonSchemaEnvelopeIsATextFrame) {
+    const std::string path = fresh_path("engine_text_frame.bin");
+    EXPECT_EXIT({
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(binary_config(path, 1h)))
+            child_fail("configure failed");
+        log_generic(1);
+        eng.enqueue(Note{7});
+        log_generic(2);
+        eng.shutdown();
+        std::_Exit(eng.written() == 3 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+
+    std::ostringstream text;
+    const auto sum = logger::codec::decode_to(read_file(path), text, logger::codec::OutputFormat::Text);
+    EXPECT_TRUE(sum.header_ok);
+    EXPECT_FALSE(sum.truncated);
+    EXPECT_EQ(sum.records, 2u);
+    EXPECT_EQ(sum.text, 1u);
+    EXPECT_EQ(sum.skipped, 0u);
+    EXPECT_NE(text.str().find("\nnote 7\n[tag=0] severity=Info timestamp=2 "), std::string::npos) << text.str();
+    std::remove(path.c_str());
+}
@@ -1,10 +1,10 @@
 #include <gtest/gtest.h>
 #include "verifiable_engine.hpp"
 
-// submit_fn is called for every enqueued record
-TEST(LogEnginePipeline, SubmitFnCalledForEveryRecord)
+// format_fn is called for every enqueued record
+TEST(LogEnginePipeline, FormatFnCalledForEveryRecord)
 {
-    g_submit_count.store(0, std::memory_order_relaxed);
+    g_format_count.store(0, std::memory_order_relaxed);
     constexpr uint64_t N = 100;
 
     VerifiableEngine engine;
@@ -18,13 +18,13 @@ TEST(LogEnginePipeline, SubmitFnCalledForEveryRecord)
     EXPECT_EQ(engine.enqueued(), N);
     EXPECT_EQ(engine.written(),  N);
     EXPECT_EQ(engine.dropped(),  0u);
-    EXPECT_EQ(g_submit_count.load(), N);
+    EXPECT_EQ(g_format_count.load(), N);
 }
 
 // Records enqueued just before shutdown are processed by drain loop
 TEST(LogEnginePipeline, DrainLoopProcessesAllPendingRecords)
 {
-    g_submit_count.store(0, std::memory_order_relaxed);
+    g_format_count.store(0, std::memory_order_relaxed);
     constexpr uint64_t N = 50;
 
     VerifiableEngine engine;
@@ -36,13 +36,13 @@ TEST(LogEnginePipeline, DrainLoopProcessesAllPendingRecords)
     engine.shutdown();  // immediate — records may still be in queue
 
     EXPECT_EQ(engine.written(), engine.enqueued());
-    EXPECT_EQ(g_submit_count.load(), engine.enqueued());
+    EXPECT_EQ(g_format_count.load(), engine.enqueued());
 }
 
 // Pool exhaustion — excess records are dropped, not corrupted
 TEST(LogEnginePipeline, DropsWhenPoolExhausted)
 {
-    g_submit_count.store(0, std::memory_order_relaxed);
+    g_format_count.store(0, std::memory_order_relaxed);
     constexpr std::size_t pool_size    = 16;
     constexpr uint64_t    enqueue_count = 64;
 
@@ -60,7 +60,7 @@ TEST(LogEnginePipeline, DropsWhenPoolExhausted)
 // Pool is recycled — after processing, new records can be enqueued without drops
 TEST(LogEnginePipeline, PoolRecycledAfterProcessing)
 {
-    g_submit_count.store(0, std::memory_order_relaxed);
+    g_format_count.store(0, std::memory_order_relaxed);
     constexpr std::size_t pool_size = 32;
 
     VerifiableEngine engine{pool_size};
@@ -81,5 +81,5 @@ TEST(LogEnginePipeline, PoolRecycledAfterProcessing)
     engine.shutdown();
 
     EXPECT_EQ(engine.dropped(), 0u);
-    EXPECT_EQ(g_submit_count.load(), pool_size * 2);
+    EXPECT_EQ(g_format_count.load(), pool_size * 2);
 }
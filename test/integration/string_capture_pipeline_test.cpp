@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger/codec/json_codec.hpp"
+#include "logger/core/lockfree_queue.hpp"
+#include "logger/core/log_record.hpp"
+#include "logger/core/string_capture.hpp"
+
+// The request path handed to enqueue lives in a buffer the producer frees
+// as soon as the call returns; the worker encodes the record afterwards.
+// Built with -DMYSERVER_SANITIZE=ON a missed copy is a heap-use-after-free
+// report; without it the freed buffer is overwritten first, so the path
+// comes out wrong.
+
+using logger::core::SpillConfig;
+using logger::core::detail::CapturedStrings;
+using logger::core::detail::CaptureTail;
+using logger::core::detail::capture_strings;
+using logger::core::detail::FreeList;
+using logger::core::detail::kStringFields;
+using logger::core::detail::kTruncatedMark;
+using logger::core::detail::LogRecord;
+using logger::core::detail::MpscQueue;
+using logger::core::detail::SpillArena;
+using logger::core::detail::SpillPool;
+using logger::registry::RequestPayload;
+
+namespace {
+
+// LogEngine's record layout for an inline payload.
+struct Stored {
+    RequestPayload env;
+    CapturedStrings<kStringFields<RequestPayload>> strings{};
+};
+static_assert(sizeof(Stored) < LogRecord::StorageSize);
+
+constexpr std::size_t kMaxString = 1024;
+
+char fill_of(std::uint64_t id) { return static_cast<char>('a' + id % 26); }
+
+std::size_t path_len(std::uint64_t seq) {
+    switch (seq % 4) {
+        case 0:  return 24;         // in the record
+        case 1:  return 100;        // in the record
+        case 2:  return 600;        // spilled
+        default: return 3000;       // spilled and cut to kMaxString
+    }
+}
+
+struct Pipeline {
+    explicit Pipeline(std::size_t pool_size, std::size_t spill_max)
+        : pool(std::make_unique<LogRecord[]>(pool_size)) {
+        for (std::size_t i = 0; i < pool_size; ++i)
+            freelist.push(&pool[i]);
+        SpillConfig cfg;
+        cfg.max_bytes = spill_max;
+        spill.configure(cfg);
+    }
+
+    // As LogEngine::emplace_envelope, then the caller's buffer goes away.
+    void enqueue(SpillArena& arena, std::uint64_t id, std::size_t len) {
+        LogRecord* rec = nullptr;
+        while (!(rec = static_cast<LogRecord*>(freelist.try_pop())))
+            std::this_thread::yield();
+
+        auto buf = std::make_unique<char[]>(len);
+        std::memset(buf.get(), fill_of(id), len);
+
+        RequestPayload p{};
+        p.req_unique_id = id;
+        p.path          = std::string_view{buf.get(), len};
+
+        auto* obj = new (rec->storage_ptr()) Stored{p};
+        const CaptureTail tail{reinterpret_cast<char*>(rec->storage) + sizeof(Stored),
+                               reinterpret_cast<char*>(rec->storage) + LogRecord::StorageSize};
+        truncated += capture_strings(obj->env, obj->strings, tail, &arena, kMaxString);
+
+        std::memset(buf.get(), 'X', len);
+        buf.reset();
+        queue.push(rec);
+    }
+
+    // Encodes each record as the Json sink would and checks its path.
+    void drain(std::uint64_t total) {
+        LogRecord* pending = nullptr;
+        char line[2 * kMaxString];
+        while (written < total) {
+            auto* rec = static_cast<LogRecord*>(queue.pop());
+            if (!rec) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (pending)
+                freelist.push(pending);
+            pending = rec;
+
+            auto* obj = static_cast<Stored*>(rec->storage_ptr());
+            const std::size_t n = logger::codec::encode_json(obj->env, line, sizeof(line));
+            const std::string_view json{line, n};
+            const std::size_t at = json.find("\"path\":\"");
+            const std::string_view path = at == std::string_view::npos
+                ? std::string_view{}
+                : json.substr(at + 8, json.size() - at - 8 - 2);     // up to "}
+
+            const std::uint64_t id = obj->env.req_unique_id;
+            const std::size_t len = path_len(id);
+            const bool cut = len > kMaxString;
+            const std::string want = cut
+                ? std::string(kMaxString - kTruncatedMark.size(), fill_of(id)) + std::string(kTruncatedMark)
+                : std::string(len, fill_of(id));
+            if (path != want)
+                ++corrupt;
+
+            obj->~Stored();
+            ++written;
+        }
+        queue.reset();
+        if (pending)
+            freelist.push(pending);
+    }
+
+    std::unique_ptr<LogRecord[]> pool;
+    FreeList freelist;
+    MpscQueue queue;
+    SpillPool spill;
+    std::atomic<std::uint64_t> truncated{0};
+    std::uint64_t written = 0;      // worker only
+    std::uint64_t corrupt = 0;      // worker only
+};
+
+} // namespace
+
+TEST(StringCapturePipeline, PathOutlivesCallerBuffer) {
+    constexpr std::size_t kProducers = 4, kPer = 2000;
+    Pipeline pipe{256, 16u << 20};
+
+    std::thread worker([&] { pipe.drain(kProducers * kPer); });
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < kProducers; ++t)
+        producers.emplace_back([&, t] {
+            SpillArena arena{pipe.spill};
+            for (std::uint64_t s = 0; s < kPer; ++s) {
+                const std::uint64_t id = t * kPer + s;
+                pipe.enqueue(arena, id, path_len(id));
+            }
+        });
+    for (auto& t : producers)
+        t.join();
+    worker.join();
+
+    EXPECT_EQ(pipe.written, kProducers * kPer);
+    EXPECT_EQ(pipe.corrupt, 0u);
+    EXPECT_EQ(pipe.truncated.load(), kProducers * kPer / 4);
+    EXPECT_EQ(pipe.spill.stats().failed, 0u);
+    EXPECT_GT(pipe.spill.stats().spilled, 0u);
+}
+
+// Every spilled copy is released with its record: a second run reuses the
+// pooled chunks and allocates none.
+TEST(StringCapturePipeline, SpilledCopiesAreReleased) {
+    constexpr std::uint64_t kRecords = 1000;
+    Pipeline pipe{64, 16u << 20};
+    std::uint64_t chunks = 0;
+
+    for (int round = 0; round < 2; ++round) {
+        const std::uint64_t total = pipe.written + kRecords;
+        std::thread worker([&] { pipe.drain(total); });
+        {
+            SpillArena arena{pipe.spill};
+            for (std::uint64_t i = 0; i < kRecords; ++i) {
+                const std::uint64_t id = 4 * i + 2 + (i & 1);       // 600 and 3000 bytes
+                pipe.enqueue(arena, id, path_len(id));
+            }
+        }
+        worker.join();
+
+        EXPECT_EQ(pipe.corrupt, 0u);
+        if (round == 0)
+            chunks = pipe.spill.stats().chunks;
+    }
+    EXPECT_GT(chunks, 0u);
+    EXPECT_EQ(pipe.spill.stats().chunks, chunks);
+    EXPECT_EQ(pipe.spill.stats().spilled, 2 * kRecords);
+}
@@ -15,9 +15,9 @@ using logger::core::detail::MpscQueue;
 using logger::core::detail::MpscNode;
 using logger::core::detail::LogRecord;
 
-// Global submit counter — required because SubmitFn is a raw function pointer
+// Global format counter — required because FormatFn is a raw function pointer
 // (no captures). Reset to 0 before each test.
-inline std::atomic<uint64_t> g_submit_count{0};
+inline std::atomic<uint64_t> g_format_count{0};
 
 class VerifiableEngine
 {
@@ -58,8 +58,9 @@ public:
 
         new (rec->storage_ptr()) Stored{std::forward<Envelope>(env)};
 
-        rec->submit_fn  = [](void*) {
-            g_submit_count.fetch_add(1, std::memory_order_relaxed);
+        rec->format_fn  = [](void*, char*, std::size_t) -> std::size_t {
+            g_format_count.fetch_add(1, std::memory_order_relaxed);
+            return 0;
         };
         rec->destroy_fn = [](void* s) noexcept {
             static_cast<Stored*>(s)->~Stored();
@@ -95,7 +96,7 @@ private:
 
             if (pending_recycle) freelist_.push(pending_recycle);
 
-            rec->submit_fn(rec->storage_ptr());
+            rec->format_fn(rec->storage_ptr(), line_, sizeof(line_));
             rec->destroy_fn(rec->storage_ptr());
             written_.fetch_add(1, std::memory_order_relaxed);
             pending_recycle = rec;
@@ -106,7 +107,7 @@ private:
             LogRecord* rec = static_cast<LogRecord*>(node);
             if (pending_recycle) freelist_.push(pending_recycle);
 
-            rec->submit_fn(rec->storage_ptr());
+            rec->format_fn(rec->storage_ptr(), line_, sizeof(line_));
             rec->destroy_fn(rec->storage_ptr());
             written_.fetch_add(1, std::memory_order_relaxed);
             pending_recycle = rec;
@@ -119,6 +120,7 @@ private:
 
     std::size_t pool_size_;
     std::unique_ptr<LogRecord[]> pool_;
+    char      line_[256];   // worker-only
     FreeList  freelist_;
     MpscQueue queue_;
     std::atomic<bool>     run_{false};
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/rotating_file.hpp"
+#include "publisher/runtime/sink_traits.hpp"
+#include "publisher/runtime/uring_file.hpp"
+
+using namespace publisher::core;
+using namespace publisher::runtime;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Slow storage stand-in: a FIFO drained by a reader that takes 16 KiB at
+// a time and stalls for `hiccup` after every `hiccup_every` bytes.
+class ThrottledFifo {
+public:
+    ThrottledFifo(std::string path, std::size_t hiccup_every, std::chrono::milliseconds hiccup)
+        : path_(std::move(path))
+    {
+        std::filesystem::remove(path_);
+        if (::mkfifo(path_.c_str(), 0600) != 0)
+            return;
+        ok_ = true;
+
+        reader_ = std::thread([this, hiccup_every, hiccup] {
+            const int fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return;
+            std::vector<char> buf(16 * 1024);
+            std::size_t since = 0;
+            for (;;) {
+                const ssize_t n = ::read(fd, buf.data(), buf.size());
+                if (n <= 0)
+                    break;
+                read_ += static_cast<std::size_t>(n);
+                since += static_cast<std::size_t>(n);
+                if (since >= hiccup_every) {
+                    since = 0;
+                    std::this_thread::sleep_for(hiccup);
+                }
+            }
+            ::close(fd);
+        });
+    }
+
+    ~ThrottledFifo() {
+        if (reader_.joinable())
+            reader_.join();
+        std::filesystem::remove(path_);
+    }
+
+    bool ok() const noexcept { return ok_; }
+    const std::string& path() const noexcept { return path_; }
+    void wait_reader() { if (reader_.joinable()) reader_.join(); }
+    std::size_t bytes_read() const noexcept { return read_.load(); }
+
+private:
+    std::string path_;
+    bool ok_ = false;
+    std::thread reader_;
+    std::atomic<std::size_t> read_{0};
+};
+
+struct Result {
+    std::vector<std::uint64_t> batch_ns;
+    std::uint64_t dropped = 0;
+};
+
+// 64 x 100-byte records per batch, one batch every `gap`: what the logger
+// worker hands SinkTraits::write_batch after each drain pass.
+template <SinkKind Sink, typename Handle>
+Result run_batches(Handle& handle, std::size_t batches, std::chrono::microseconds gap) {
+    const std::string record(99, 'r');
+    const std::string line = record + '\n';
+    const std::vector<std::string_view> views(64, std::string_view{line});
+
+    Result r;
+    r.batch_ns.reserve(batches);
+    for (std::size_t i = 0; i < batches; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        SinkTraits<Sink>::write_batch(handle, views);
+        const auto t1 = std::chrono::steady_clock::now();
+        r.batch_ns.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+        std::this_thread::sleep_for(gap);
+    }
+    std::sort(r.batch_ns.begin(), r.batch_ns.end());
+    return r;
+}
+
+void print_row(const char* name, const Result& r) {
+    auto pct = [&](double p) {
+        return static_cast<unsigned long long>(
+            r.batch_ns[static_cast<std::size_t>(p * static_cast<double>(r.batch_ns.size() - 1))] / 1000);
+    };
+    std::printf("%12s %10llu %10llu %10llu %10llu %10llu\n", name,
+                pct(0.50), pct(0.99), pct(0.999),
+                static_cast<unsigned long long>(r.batch_ns.back() / 1000),
+                static_cast<unsigned long long>(r.dropped));
+}
+
+std::string fifo_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+// io_uring keeps the file intact under a throttled reader: every record
+// not counted as dropped arrives, none torn.
+TEST(AsyncFileStress, ThrottledReaderGetsWholeRecords) {
+    ThrottledFifo fifo{fifo_path("async_file_stress.fifo"), 256 * 1024, 5ms};
+    if (!fifo.ok())
+        GTEST_SKIP() << "mkfifo unavailable";
+
+    AsyncFileConfig cfg;
+    cfg.path = fifo.path();
+    cfg.buffer_bytes = 64 * 1024;
+
+    UringFile f;
+    ASSERT_TRUE(f.open(cfg));
+    AsyncFileHandle handle{&f};
+    const auto r = run_batches<SinkKind::AsyncFile>(handle, 400, 100us);
+    f.close();
+    fifo.wait_reader();
+
+    const std::size_t record = 100;
+    EXPECT_EQ(fifo.bytes_read() % record, 0u);
+    EXPECT_EQ(fifo.bytes_read() / record + f.dropped(), 400u * 64u);
+    EXPECT_EQ(f.write_errors(), 0u);
+    (void)r;
+}
+
+// Per-batch latency of the publishing call on storage that stalls for
+// 30 ms every 1 MiB. The synchronous writer blocks for the stall; the
+// io_uring writer returns once the batch is queued (and drops if all its
+// buffers are still in flight). Numbers only; depends on the host.
+TEST(AsyncFileBench, ThrottledStorageTailLatency) {
+    constexpr std::size_t kBatches = 2000;
+    constexpr auto kGap = 300us;
+
+    std::printf("\n%12s %10s %10s %10s %10s %10s\n",
+                "backend", "p50 us", "p99 us", "p999 us", "max us", "dropped");
+
+    {
+        ThrottledFifo fifo{fifo_path("async_file_bench_sync.fifo"), 1 << 20, 30ms};
+        if (!fifo.ok())
+            GTEST_SKIP() << "mkfifo unavailable";
+
+        FileSinkConfig cfg;
+        cfg.path = fifo.path();
+        cfg.buffer_bytes = 64 * 1024;
+        cfg.flush_interval = 1ms;
+        RotatingFile f;
+        ASSERT_TRUE(f.open(cfg));
+        FileHandle handle{nullptr, &f};
+        auto r = run_batches<SinkKind::File>(handle, kBatches, kGap);
+        f.close();
+        print_row("RotatingFile", r);
+    }
+
+    {
+        ThrottledFifo fifo{fifo_path("async_file_bench_uring.fifo"), 1 << 20, 30ms};
+        AsyncFileConfig cfg;
+        cfg.path = fifo.path();
+        cfg.buffer_bytes = 64 * 1024;
+        cfg.buffers = 16;
+        UringFile f;
+        ASSERT_TRUE(f.open(cfg));
+        AsyncFileHandle handle{&f};
+        auto r = run_batches<SinkKind::AsyncFile>(handle, kBatches, kGap);
+        r.dropped = f.dropped();
+        const bool async = f.async();
+        f.close();
+        print_row(async ? "UringFile" : "Uring(sync)", r);
+    }
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "logger/core/coalescer.hpp"
+
+using logger::core::detail::Coalescer;
+using logger::core::detail::coalesce_key;
+using logger::registry::RepeatPayload;
+
+namespace {
+
+struct Result {
+    std::uint64_t written = 0;      // records that would reach the sink
+    std::uint64_t summaries = 0;
+    std::uint64_t summed = 0;       // repeated= over every summary
+    double ns_per_record = 0;
+};
+
+// A failure storm as the worker sees it: `distinct` different requests,
+// one record every `step_ns` of simulated time, `noise_every`-th record a
+// one-off. Only timestamp differs between the repeats.
+Result run(std::uint64_t window_ns, std::size_t records, std::size_t distinct, std::size_t noise_every,
+           std::uint64_t step_ns) {
+    std::vector<std::string> paths;
+    for (std::size_t i = 0; i < distinct; ++i)
+        paths.push_back("/api/v1/orders/" + std::to_string(i));
+
+    Coalescer c{window_ns, 256};
+    Result r;
+    auto emit = [&](const RepeatPayload& s) {
+        ++r.summaries;
+        r.summed += s.repeated;
+    };
+
+    logger::registry::RequestPayload p{};
+    p.severity = Severity::Error;
+    p.thread_id = 4;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < records; ++i) {
+        const std::uint64_t now = i * step_ns;
+        p.timestamp = now / 1000;
+        p.path = paths[i % distinct];
+        p.request_id = i % noise_every == 0 ? static_cast<std::uint32_t>(i) : 0u;
+
+        RepeatPayload header;
+        const std::uint64_t key = coalesce_key(p, header);
+        if (!window_ns || !c.absorb(key, header, now, emit))
+            ++r.written;
+    }
+    c.expire_all(emit);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    r.ns_per_record = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+                      static_cast<double>(records);
+    return r;
+}
+
+} // namespace
+
+// Every record is either written or counted in a summary.
+TEST(CoalesceStress, EveryRecordAccountedFor) {
+    constexpr std::size_t kRecords = 1'000'000;
+    const Result r = run(1'000'000, kRecords, 8, 100, 100);
+    EXPECT_EQ(r.written + r.summed, kRecords);
+    EXPECT_LT(r.written + r.summaries, kRecords / 20);
+}
+
+// More live keys than the table holds: windows are evicted, nothing lost.
+TEST(CoalesceStress, EvictionKeepsCounts) {
+    constexpr std::size_t kRecords = 500'000;
+    const Result r = run(1'000'000'000, kRecords, 1000, 1'000'000, 100);
+    EXPECT_EQ(r.written + r.summed, kRecords);
+}
+
+// Output records per input record and worker-side cost of the stage.
+// Numbers only; absolute values depend on the host.
+TEST(CoalesceBench, StormReduction) {
+    constexpr std::size_t kRecords = 2'000'000;
+    std::printf("\n%10s %10s %10s %10s %10s %10s\n", "window_ms", "distinct", "records", "written", "summaries",
+                "ns/rec");
+    for (std::uint64_t window_ms : {0u, 1u, 10u, 100u})
+        for (std::size_t distinct : {1u, 16u}) {
+            const Result r = run(window_ms * 1'000'000, kRecords, distinct, 100, 100);
+            std::printf("%10llu %10zu %10zu %10llu %10llu %10.2f\n", static_cast<unsigned long long>(window_ms),
+                        distinct, kRecords, static_cast<unsigned long long>(r.written),
+                        static_cast<unsigned long long>(r.summaries), r.ns_per_record);
+        }
+}
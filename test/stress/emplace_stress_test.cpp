@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "logger/core/log_clock.hpp"
+#include "logger/core/log_engine.hpp"
+#include "logger/registry/builder.hpp"
+#include "logger/registry/header_args.hpp"
+
+// LogEngine::emplace against what Handler::log did before it: build the
+// payload with Builder, then enqueue it. Both run on the real engine, a
+// process-wide singleton, so each test runs it in a forked child (a death
+// test expected to exit 0).
+
+using logger::core::EngineConfig;
+using logger::core::LogClock;
+using logger::core::SinkFormat;
+using logger::core::detail::LogEngine;
+using logger::registry::Builder;
+
+namespace {
+
+template <MsgTag Tag, typename... Args>
+[[gnu::noinline]] void via_emplace(LogEngine& eng, Args&&... args) {
+    eng.emplace<Tag>(std::forward<Args>(args)...);
+}
+
+template <MsgTag Tag, typename... Args>
+[[gnu::noinline]] void via_enqueue(LogEngine& eng, Args&&... args) {
+    auto header_tuple = logger::registry::pack_header_args(std::forward<Args>(args)...);
+    eng.enqueue(Builder::build<Tag>(header_tuple));
+}
+
+auto generic(auto put) {
+    return [put](LogEngine& eng, std::uint64_t i) {
+        put(eng, Severity::Info, std::uint64_t{i + 1}, std::uint32_t{7}, static_cast<std::uint32_t>(i),
+            std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1});
+    };
+}
+
+auto request(auto put) {
+    return [put](LogEngine& eng, std::uint64_t i) {
+        static constexpr std::string_view kPath = "/api/v1/orders";
+        put(eng, Severity::Info, std::uint64_t{i + 1}, std::uint32_t{7}, static_cast<std::uint32_t>(i),
+            std::uint16_t{1}, std::uint16_t{2}, std::uint16_t{1}, std::uint64_t{i}, kPath);
+    };
+}
+
+// The terminal sink's std::cout, thrown away: the bench times producers.
+struct DiscardBuf : std::streambuf {
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    int overflow(int c) override { return c; }
+};
+
+// Calls timed in batches the pool always has room for; between batches
+// the worker catches up, untimed.
+constexpr std::size_t kBatch = 512;
+
+template <typename Fn>
+double ns_per_call(LogEngine& eng, Fn fn, std::uint64_t calls) {
+    std::chrono::nanoseconds spent{0};
+    for (std::uint64_t i = 0; i < calls;) {
+        const std::uint64_t end = i + kBatch;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (; i < end; ++i)
+            fn(eng, i);
+        spent += std::chrono::steady_clock::now() - t0;
+        while (eng.written() < eng.enqueued())
+            std::this_thread::yield();
+    }
+    return static_cast<double>(spent.count()) / static_cast<double>(calls);
+}
+
+// Lines taken two at a time (emplace, then enqueue of the same call);
+// the number of pairs, or exits the child at the first that differ.
+std::size_t equal_pairs(const std::string& text) {
+    std::istringstream lines(text);
+    std::string a, b;
+    std::size_t pairs = 0;
+    while (std::getline(lines, a) && std::getline(lines, b)) {
+        if (a != b) {
+            std::fprintf(stderr, "emplace: %s\nenqueue: %s\n", a.c_str(), b.c_str());
+            std::_Exit(1);
+        }
+        ++pairs;
+    }
+    return pairs;
+}
+
+} // namespace
+
+// Both paths leave the same record: the worker writes identical lines.
+TEST(EmplaceStress, SameLineEitherWay) {
+    EXPECT_EXIT({
+        std::ostringstream text;
+        std::cout.rdbuf(text.rdbuf());
+        EngineConfig cfg;
+        cfg.sink_format = SinkFormat::Json;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            std::_Exit(2);
+
+        auto emplaced = request([](auto&&... a) { via_emplace<MsgTag::Request>(std::forward<decltype(a)>(a)...); });
+        auto enqueued = request([](auto&&... a) { via_enqueue<MsgTag::Request>(std::forward<decltype(a)>(a)...); });
+        auto g_emplaced = generic([](auto&&... a) { via_emplace<MsgTag::Generic>(std::forward<decltype(a)>(a)...); });
+        auto g_enqueued = generic([](auto&&... a) { via_enqueue<MsgTag::Generic>(std::forward<decltype(a)>(a)...); });
+        for (std::uint64_t i = 0; i < 100; ++i) {
+            emplaced(eng, i);
+            enqueued(eng, i);
+            g_emplaced(eng, i);
+            g_enqueued(eng, i);
+        }
+        eng.shutdown();
+
+        std::_Exit(equal_pairs(text.str()) == 200 && eng.written() == 400 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+}
+
+// Producer-side cost of one record on the real engine, worker running.
+// Numbers only; absolute values depend on the host. Cycles from the
+// calibrated TSC.
+TEST(EmplaceBench, EmplaceVsEnqueueBuilt) {
+    EXPECT_EXIT({
+        DiscardBuf discard;
+        std::cout.rdbuf(&discard);
+        EngineConfig cfg;
+        cfg.pool_size = 4 * kBatch;
+        LogEngine& eng = LogEngine::instance();
+        if (!eng.configure(cfg))
+            std::_Exit(2);
+
+        constexpr std::uint64_t kCalls = 2'000'000;
+        const double ghz = LogClock::instance().tsc_hz() / 1e9;
+
+        auto enqueue_g = [](auto&&... a) { via_enqueue<MsgTag::Generic>(std::forward<decltype(a)>(a)...); };
+        auto emplace_g = [](auto&&... a) { via_emplace<MsgTag::Generic>(std::forward<decltype(a)>(a)...); };
+        auto enqueue_r = [](auto&&... a) { via_enqueue<MsgTag::Request>(std::forward<decltype(a)>(a)...); };
+        auto emplace_r = [](auto&&... a) { via_emplace<MsgTag::Request>(std::forward<decltype(a)>(a)...); };
+
+        std::printf("\n%10s %18s %10s %10s\n", "payload", "path", "ns/call", "cycles");
+        auto row = [&](const char* payload, const char* path, double ns) {
+            std::printf("%10s %18s %10.2f %10.1f\n", payload, path, ns, ns * ghz);
+        };
+        row("Generic", "enqueue(build)", ns_per_call(eng, generic(enqueue_g), kCalls));
+        row("Generic", "emplace", ns_per_call(eng, generic(emplace_g), kCalls));
+        row("Request", "enqueue(build)", ns_per_call(eng, request(enqueue_r), kCalls));
+        row("Request", "emplace", ns_per_call(eng, request(emplace_r), kCalls));
+        std::fflush(stdout);
+
+        eng.shutdown();
+        std::_Exit(eng.dropped() == 0 ? 0 : 1);
+    }, ::testing::ExitedWithCode(0), "");
+}
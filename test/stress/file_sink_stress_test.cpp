@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "publisher/core/publisher_types.hpp"
+#include "publisher/runtime/rotating_file.hpp"
+#include "publisher/runtime/sink_traits.hpp"
+
+using namespace publisher::core;
+using namespace publisher::runtime;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void remove_all(const std::string& path, std::size_t keep) {
+    std::filesystem::remove(path);
+    for (std::size_t i = 1; i <= keep; ++i)
+        std::filesystem::remove(path + '.' + std::to_string(i));
+}
+
+// ~100-byte text lines, like a formatted GenericPayload.
+std::vector<std::string> make_lines(std::size_t n) {
+    std::vector<std::string> lines;
+    lines.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        lines.push_back("[tag=0] severity=Info timestamp=" + std::to_string(1'700'000'000'000ull + i) +
+                        " thread_id=3 request_id=" + std::to_string(i) + " class_id=1 method_id=2\n");
+    return lines;
+}
+
+std::uint64_t total_bytes(const std::vector<std::string>& lines) {
+    std::uint64_t n = 0;
+    for (const auto& l : lines)
+        n += l.size();
+    return n;
+}
+
+template <typename Fn>
+double mb_per_s(std::uint64_t bytes, Fn&& fn) {
+    const auto t0 = std::chrono::steady_clock::now();
+    fn();
+    const auto t1 = std::chrono::steady_clock::now();
+    const double s = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(bytes) / (1024.0 * 1024.0) / s;
+}
+
+} // namespace
+
+// Rotation under volume: every byte lands in exactly one of the files and
+// each file is a whole number of lines.
+TEST(FileSinkStress, RotationKeepsEveryLine) {
+    const auto path = temp_path("file_sink_stress_rotation.log");
+    constexpr std::size_t kKeep = 64;
+    remove_all(path, kKeep);
+
+    const auto lines = make_lines(50000);
+    FileSinkConfig cfg;
+    cfg.path = path;
+    cfg.buffer_bytes = 64 * 1024;
+    cfg.rotate_bytes = 256 * 1024;
+    cfg.keep_files = kKeep;
+
+    RotatingFile f;
+    ASSERT_TRUE(f.open(cfg));
+    for (const auto& l : lines)
+        f.write(l);
+    f.close();
+
+    std::uint64_t bytes = 0;
+    std::size_t newlines = 0;
+    for (std::size_t i = 0; i <= f.rotations(); ++i) {
+        const std::string p = i == 0 ? path : path + '.' + std::to_string(i);
+        std::ifstream in(p, std::ios::binary);
+        const std::string content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>{}};
+        ASSERT_FALSE(content.empty()) << p;
+        EXPECT_EQ(content.back(), '\n') << p << " ends mid-line";
+        EXPECT_LE(content.size(), cfg.rotate_bytes) << p;
+        bytes += content.size();
+        newlines += static_cast<std::size_t>(std::count(content.begin(), content.end(), '\n'));
+    }
+
+    EXPECT_GT(f.rotations(), 0u);
+    EXPECT_EQ(f.write_errors(), 0u);
+    EXPECT_EQ(bytes, total_bytes(lines));
+    EXPECT_EQ(newlines, lines.size());
+    remove_all(path, kKeep);
+}
+
+// MB/s writing the same lines three ways. Numbers only; absolute values
+// depend on the host and its filesystem.
+TEST(FileSinkBench, PerLineFlushVsBufferedWriter) {
+    const auto lines = make_lines(100000);
+    const std::uint64_t bytes = total_bytes(lines);
+    const auto path = temp_path("file_sink_bench.log");
+
+    // FilePolicy::write_impl: write + flush per line.
+    std::filesystem::remove(path);
+    const double flush_each = mb_per_s(bytes, [&] {
+        std::ofstream out(path, std::ios::out | std::ios::app);
+        for (const auto& l : lines) {
+            out.write(l.data(), static_cast<std::streamsize>(l.size()));
+            out.flush();
+        }
+    });
+
+    // SinkTraits<File> over a bare std::fstream.
+    std::filesystem::remove(path);
+    const double fstream = mb_per_s(bytes, [&] {
+        std::fstream out(path, std::ios::out | std::ios::app);
+        FileHandle handle{&out};
+        for (const auto& l : lines)
+            SinkTraits<SinkKind::File>::write(handle, l);
+        out.flush();
+    });
+
+    // SinkTraits<File> over a RotatingFile (default 1 MiB buffer).
+    std::filesystem::remove(path);
+    RotatingFile writer;
+    FileSinkConfig cfg;
+    cfg.path = path;
+    ASSERT_TRUE(writer.open(cfg));
+    const double rotating = mb_per_s(bytes, [&] {
+        FileHandle handle{nullptr, &writer};
+        for (const auto& l : lines)
+            SinkTraits<SinkKind::File>::write(handle, l);
+        writer.flush();
+    });
+    EXPECT_EQ(writer.bytes_written(), bytes);
+    writer.close();
+    std::filesystem::remove(path);
+
+    std::printf("\n%24s %10s\n", "file sink", "MB/s");
+    std::printf("%24s %10.1f\n", "ofstream flush per line", flush_each);
+    std::printf("%24s %10.1f\n", "fstream (SinkTraits)", fstream);
+    std::printf("%24s %10.1f\n", "RotatingFile", rotating);
+}
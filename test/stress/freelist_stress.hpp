@@ -2,8 +2,14 @@
 
 #include "harness/stress_builder.hpp"
 #include "logger/core/lockfree_queue.hpp"
+#include "logger/core/record_magazine.hpp"
+#include "logger/core/tagged_freelist.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 
 namespace stress {
@@ -11,6 +17,9 @@ namespace stress {
 using logger::core::detail::FreeList;
 using logger::core::detail::FreeNode;
 using logger::core::detail::LogRecord;
+using logger::core::detail::RecordMagazine;
+using logger::core::detail::RecycleBatch;
+using logger::core::detail::TaggedFreeList;
 
 // Production pattern: multiple threads pop concurrently (acquire_record),
 // popped nodes are collected per-thread for post-run verification.
@@ -61,4 +70,149 @@ private:
     std::vector<std::vector<LogRecord*>> per_thread_popped_;
 };
 
+// ABA provocation: every thread pops two nodes and pushes them back in
+// swapped order, as fast as it can. A head observed by a slow thread is
+// thereby popped and re-pushed with a different successor — the textbook
+// ABA interleaving that corrupts an untagged Treiber stack.
+// Only safe to run against TaggedFreeList.
+class AbaProvokeStress
+    : public harness::StressBuilder<AbaProvokeStress>
+{
+public:
+    AbaProvokeStress(harness::StressConfig cfg, std::size_t pool_size)
+        : StressBuilder(cfg)
+        , pool_(pool_size)
+        , freelist_(pool_.data(), pool_.size())
+    {
+        for (auto& rec : pool_) {
+            freelist_.push(&rec);
+        }
+    }
+
+    bool do_impl(std::size_t /*tid*/, std::size_t /*iteration*/) noexcept {
+        FreeNode* a = freelist_.try_pop();
+        FreeNode* b = freelist_.try_pop();
+        if (a) freelist_.push(a);
+        if (b) freelist_.push(b);
+        return a && b;
+    }
+
+    // Drain and verify: every node exactly once, no cycle, nothing lost.
+    bool intact() {
+        std::set<FreeNode*> seen;
+        std::size_t steps = 0;
+        while (FreeNode* n = freelist_.try_pop()) {
+            if (++steps > pool_.size() || !seen.insert(n).second) {
+                return false;
+            }
+        }
+        return seen.size() == pool_.size();
+    }
+
+private:
+    std::vector<LogRecord> pool_;
+    TaggedFreeList freelist_;
+};
+
+struct RecycleCycleResult {
+    std::size_t pops      = 0;
+    std::size_t recovered = 0;
+    std::size_t duplicates = 0;
+    std::chrono::nanoseconds elapsed{0};
+};
+
+// LogEngine acquire/recycle cycle: `poppers` threads acquire records and
+// hand them to one recycler thread that returns them to the freelist.
+// With magazine > 0 the poppers go through a RecordMagazine and the
+// recycler returns chains via RecycleBatch (LogEngine magazine mode);
+// with magazine == 0 it is one CAS per record on both sides.
+template <typename FreeListT = FreeList>
+RecycleCycleResult run_recycle_cycle(FreeListT& fl, std::vector<LogRecord>& pool,
+                                     std::size_t poppers, std::size_t iterations,
+                                     std::size_t magazine)
+{
+    fl.attach(pool.data(), pool.size());
+    {
+        RecycleBatch<FreeListT> seed{magazine ? magazine : 1};
+        for (auto& rec : pool) seed.add(&rec, fl);
+        seed.flush(fl);
+    }
+
+    const std::size_t total = poppers * iterations;
+    std::vector<std::atomic<LogRecord*>> channel(total);
+    for (auto& slot : channel) slot.store(nullptr, std::memory_order_relaxed);
+
+    std::atomic<std::size_t> write_idx{0};
+    std::atomic<std::size_t> pops{0};
+    std::atomic<std::size_t> poppers_done{0};
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> go{false};
+
+    auto popper = [&]() {
+        RecordMagazine<FreeListT> mag{magazine ? magazine : 1};
+        ready.fetch_add(1, std::memory_order_release);
+        while (!go.load(std::memory_order_acquire)) {}
+
+        std::size_t local = 0;
+        for (std::size_t i = 0; i < iterations; ++i) {
+            LogRecord* rec = magazine
+                ? mag.acquire(fl)
+                : static_cast<LogRecord*>(fl.try_pop());
+            if (rec) {
+                channel[write_idx.fetch_add(1, std::memory_order_relaxed)]
+                    .store(rec, std::memory_order_release);
+                ++local;
+            }
+        }
+        pops.fetch_add(local, std::memory_order_relaxed);
+        mag.flush(fl);
+        poppers_done.fetch_add(1, std::memory_order_release);
+    };
+
+    auto recycler = [&]() {
+        RecycleBatch<FreeListT> batch{magazine ? magazine : 1};
+        ready.fetch_add(1, std::memory_order_release);
+        while (!go.load(std::memory_order_acquire)) {}
+
+        std::size_t read_idx = 0;
+        while (poppers_done.load(std::memory_order_acquire) < poppers
+               || read_idx < write_idx.load(std::memory_order_acquire))
+        {
+            if (read_idx < write_idx.load(std::memory_order_acquire)) {
+                LogRecord* rec = channel[read_idx].load(std::memory_order_acquire);
+                if (rec) {
+                    batch.add(rec, fl);
+                    ++read_idx;
+                    continue;
+                }
+            }
+            // idle: never park records the poppers are waiting for
+            batch.flush(fl);
+        }
+        batch.flush(fl);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(poppers + 1);
+    for (std::size_t i = 0; i < poppers; ++i) threads.emplace_back(popper);
+    threads.emplace_back(recycler);
+
+    while (ready.load(std::memory_order_acquire) < poppers + 1) {}
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads) t.join();
+    auto t1 = std::chrono::steady_clock::now();
+
+    RecycleCycleResult result;
+    result.pops    = pops.load();
+    result.elapsed = t1 - t0;
+
+    std::set<FreeNode*> recovered;
+    while (FreeNode* n = fl.try_pop()) {
+        if (!recovered.insert(n).second) ++result.duplicates;
+    }
+    result.recovered = recovered.size();
+    return result;
+}
+
 } // namespace stress
@@ -3,6 +3,8 @@
 #include <thread>
 #include <atomic>
 #include <vector>
+#include <algorithm>
+#include <cstdio>
 #include "stress/freelist_stress.hpp"
 
 using namespace harness;
@@ -167,6 +169,23 @@ TEST_P(FreeListStressTest, MultiPopSinglePushRecycle) {
         << "Lost nodes during multi-pop/single-push recycling";
 }
 
+// Magazine mode: per-thread caches refill with one CAS per chain and the
+// recycler returns chains — same conservation guarantees as above
+TEST_P(FreeListStressTest, MagazineAcquireChainRecycle) {
+    auto [cfg, pool_size] = GetParam();
+
+    FreeList fl;
+    std::vector<LogRecord> pool(pool_size);
+    auto r = run_recycle_cycle(fl, pool, cfg.thread_count,
+                               cfg.iterations_per_thread, 16);
+
+    EXPECT_GE(r.pops, pool_size)
+        << "Expected recycling to enable more pops than pool_size";
+    EXPECT_EQ(r.duplicates, 0u);
+    EXPECT_EQ(r.recovered, pool_size)
+        << "Lost nodes during magazine/chain recycling";
+}
+
 INSTANTIATE_TEST_SUITE_P(
     FreeListVariants,
     FreeListStressTest,
@@ -181,3 +200,127 @@ INSTANTIATE_TEST_SUITE_P(
              + "_p" + std::to_string(info.param.pool_size);
     }
 );
+
+// Acquire/recycle throughput: one CAS per record vs magazines + chains.
+// Reports numbers only — absolute values depend on the host.
+TEST(FreeListMagazineThroughput, PerRecordVsMagazine) {
+    constexpr std::size_t kPool = 1024;
+    constexpr std::size_t kIterations = 100000;
+
+    std::printf("\n%8s %10s %18s %18s\n", "threads", "magazine", "acquires/s", "recovered");
+    for (std::size_t threads : {1u, 4u, 16u}) {
+        for (std::size_t magazine : {0u, 16u, 32u}) {
+            FreeList fl;
+            std::vector<LogRecord> pool(kPool);
+            auto r = run_recycle_cycle(fl, pool, threads, kIterations / threads, magazine);
+            const double s = std::chrono::duration<double>(r.elapsed).count();
+
+            std::printf("%8zu %10zu %18.0f %18zu\n", threads, magazine,
+                        static_cast<double>(r.pops) / s, r.recovered);
+            EXPECT_EQ(r.recovered, kPool);
+        }
+    }
+}
+
+// ─── TaggedFreeList ──────────────────────────────────────────────
+
+class TaggedFreeListAbaTest
+    : public ::testing::TestWithParam<FreeListTestConfig>
+{};
+
+TEST_P(TaggedFreeListAbaTest, SurvivesAbaInterleaving) {
+    auto [cfg, pool_size] = GetParam();
+    AbaProvokeStress stress{cfg, pool_size};
+
+    auto result = stress.run();
+
+    EXPECT_EQ(result.total_iterations(),
+              cfg.thread_count * cfg.iterations_per_thread);
+    EXPECT_TRUE(stress.intact())
+        << "TaggedFreeList lost, duplicated or cycled nodes under ABA load";
+}
+
+TEST_P(TaggedFreeListAbaTest, MagazineAcquireChainRecycle) {
+    auto [cfg, pool_size] = GetParam();
+
+    TaggedFreeList fl;
+    std::vector<LogRecord> pool(pool_size);
+    auto r = run_recycle_cycle(fl, pool, cfg.thread_count,
+                               cfg.iterations_per_thread, 16);
+
+    EXPECT_EQ(r.duplicates, 0u);
+    EXPECT_EQ(r.recovered, pool_size);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    TaggedFreeListVariants,
+    TaggedFreeListAbaTest,
+    ::testing::Values(
+        FreeListTestConfig{{.thread_count = 2,  .iterations_per_thread = 20000}, 4},
+        FreeListTestConfig{{.thread_count = 8,  .iterations_per_thread = 20000}, 8},
+        FreeListTestConfig{{.thread_count = 16, .iterations_per_thread = 10000}, 64}
+    ),
+    [](const auto& info) {
+        return "t" + std::to_string(info.param.stress.thread_count)
+             + "_i" + std::to_string(info.param.stress.iterations_per_thread)
+             + "_p" + std::to_string(info.param.pool_size);
+    }
+);
+
+// Cost of the generation tag on the production acquire/recycle cycle.
+// Best of several runs each. The target is <= 5% overhead; the
+// uncontended rate is asserted at 30%, loose enough for a loaded machine
+// (ctest -j) to pass, tight enough to catch a tag that costs a CAS loop
+// or a cache miss. The threaded cycle rates swing too much with
+// scheduling and are only reported.
+TEST(TaggedFreeListThroughput, TaggedVsPlain) {
+    constexpr double kMinRatio = 0.70;
+    constexpr std::size_t kPool = 1024;
+    constexpr std::size_t kIterations = 100000;
+    constexpr int kRuns = 5;
+
+    auto best_rate = [&](auto make_list, std::size_t threads) {
+        double best = 0;
+        for (int run = 0; run < kRuns; ++run) {
+            auto fl = make_list();
+            std::vector<LogRecord> pool(kPool);
+            auto r = run_recycle_cycle(fl, pool, threads, kIterations / threads, 0);
+            EXPECT_EQ(r.recovered, kPool);
+            best = std::max(best, static_cast<double>(r.pops) /
+                                      std::chrono::duration<double>(r.elapsed).count());
+        }
+        return best;
+    };
+
+    // Uncontended pop+push pairs isolate the intrinsic cost of the tag
+    // (index encode/decode + generation bump) from scheduler noise.
+    auto pair_rate = [&](auto fl) {
+        std::vector<LogRecord> pool(kPool);
+        fl.attach(pool.data(), pool.size());
+        for (auto& rec : pool) fl.push(&rec);
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < kIterations * 10; ++i) {
+            FreeNode* n = fl.try_pop();
+            fl.push(n);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        return static_cast<double>(kIterations * 10) / std::chrono::duration<double>(t1 - t0).count();
+    };
+    // Runs alternate so a burst of load elsewhere hits both lists.
+    double plain_pairs = 0, tagged_pairs = 0;
+    for (int run = 0; run < kRuns; ++run) {
+        plain_pairs  = std::max(plain_pairs, pair_rate(FreeList{}));
+        tagged_pairs = std::max(tagged_pairs, pair_rate(TaggedFreeList{}));
+    }
+    std::printf("\nuncontended pop+push/s: plain %.0f tagged %.0f (tagged/plain %.3f)\n",
+                plain_pairs, tagged_pairs, tagged_pairs / plain_pairs);
+    EXPECT_GE(tagged_pairs / plain_pairs, kMinRatio);
+
+    std::printf("%8s %16s %16s %10s\n", "threads", "plain acq/s", "tagged acq/s", "tagged/plain");
+    for (std::size_t threads : {1u, 4u, 16u}) {
+        const double plain  = best_rate([] { return FreeList{}; }, threads);
+        const double tagged = best_rate([] { return TaggedFreeList{}; }, threads);
+        std::printf("%8zu %16.0f %16.0f %10.3f\n", threads, plain, tagged, tagged / plain);
+    }
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/messages/payloads/json_escape.hpp"
+#include "logger/codec/json_codec.hpp"
+#include "publisher/sink_publisher.hpp"
+
+namespace codec = logger::codec;
+using logger::registry::RequestPayload;
+
+namespace {
+
+// codec::detail::write_json_string before the schema encoder: one
+// operator<< per character.
+void ostream_json_string(std::ostream& os, std::string_view s)
+{
+    static constexpr char kHex[] = "0123456789abcdef";
+    os << '"';
+    for (const char c : s)
+    {
+        switch (c)
+        {
+            case '"':  os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n";  break;
+            case '\r': os << "\\r";  break;
+            case '\t': os << "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    os << "\\u00" << kHex[(c >> 4) & 0xF] << kHex[c & 0xF];
+                else
+                    os << c;
+        }
+    }
+    os << '"';
+}
+
+std::vector<std::string> make_paths(std::size_t n, std::size_t len, unsigned escape_every) {
+    std::mt19937 rng(11);
+    const char specials[] = "\"\\\n\t\x01";
+    std::vector<std::string> paths;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string p = "/api/v1/orders/" + std::to_string(i) + "/";
+        while (p.size() < len)
+            p.push_back(escape_every && rng() % escape_every == 0 ? specials[rng() % 5]
+                                                                 : static_cast<char>('a' + rng() % 26));
+        paths.push_back(std::move(p));
+    }
+    return paths;
+}
+
+std::vector<RequestPayload> make_payloads(const std::vector<std::string>& paths) {
+    std::vector<RequestPayload> out;
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        RequestPayload p{};
+        p.severity       = Severity::Info;
+        p.timestamp      = 1'700'000'000'000'000ull + i * 997;
+        p.thread_id      = static_cast<std::uint32_t>(i % 8);
+        p.request_id     = static_cast<std::uint32_t>(i * 31);
+        p.class_id       = static_cast<std::uint16_t>(i % 2);
+        p.method_id      = static_cast<std::uint16_t>(i % 3);
+        p.schema_version = 1;
+        p.req_unique_id  = i * 7919;
+        p.path           = paths[i];
+        out.push_back(p);
+    }
+    return out;
+}
+
+// The engine's text for the same record: header fields, then the path.
+std::size_t text_line(const RequestPayload& p, char* dst, std::size_t cap) {
+    FieldWriter w{dst, cap};
+    p.format_header(w);
+    w.put("req_unique_id=");
+    w.put(p.req_unique_id);
+    w.put(" path=");
+    w.put(p.path);
+    return w.size();
+}
+
+template <typename T, typename Fn>
+double ns_per_item(const std::vector<T>& items, Fn&& fn, std::size_t rounds) {
+    std::size_t sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r)
+        for (const auto& x : items)
+            sink += fn(x);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    EXPECT_GT(sink, 0u);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(rounds * items.size());
+}
+
+} // namespace
+
+// The SIMD escaper writes exactly what the per-character ostream one did.
+TEST(JsonEncoderStress, EscaperMatchesOstreamVersion) {
+    for (unsigned every : {0u, 3u, 17u})
+        for (std::size_t len : {7u, 16u, 33u, 200u})
+            for (const auto& s : make_paths(200, len, every)) {
+                std::ostringstream os;
+                ostream_json_string(os, s);
+
+                std::string out(s.size() * 6 + 2, '\0');
+                FieldWriter w{out.data(), out.size()};
+                put_json_string(w, s);
+                out.resize(w.size());
+                ASSERT_EQ(out, os.str());
+            }
+}
+
+// ns per record. Numbers only; absolute values depend on the host.
+TEST(JsonEncoderBench, JsonVsText) {
+    const auto paths = make_paths(1024, 48, 0);
+    const auto payloads = make_payloads(paths);
+    constexpr std::size_t kRounds = 100;
+
+    std::vector<std::string> lines;
+    for (const auto& p : payloads) {
+        char buf[512];
+        lines.emplace_back(buf, text_line(p, buf, sizeof(buf)));
+    }
+
+    const double text_ns = ns_per_item(payloads, [](const RequestPayload& p) {
+        char buf[1024];
+        return text_line(p, buf, sizeof(buf));
+    }, kRounds);
+    const double sink_ns = ns_per_item(lines, [](const std::string& l) {
+        char buf[1024];
+        return TextSink::format_to(l, buf, sizeof(buf));
+    }, kRounds);
+    const double json_ns = ns_per_item(payloads, [](const RequestPayload& p) {
+        char buf[1024];
+        return codec::encode_json(p, buf, sizeof(buf));
+    }, kRounds);
+    const double jsink_ns = ns_per_item(lines, [](const std::string& l) {
+        char buf[1024];
+        return JsonSink::format_to(l, buf, sizeof(buf));
+    }, kRounds);
+
+    std::printf("\n%34s %10s %10s\n", "encoder", "ns/record", "vs text");
+    std::printf("%34s %10.1f %9.2fx\n", "payload -> text (engine Text)", text_ns, 1.0);
+    std::printf("%34s %10.1f %9.2fx\n", "text line -> TextSink", sink_ns, sink_ns / text_ns);
+    std::printf("%34s %10.1f %9.2fx\n", "payload -> encode_json (Json)", json_ns, json_ns / text_ns);
+    std::printf("%34s %10.1f %9.2fx\n", "text line -> JsonSink", jsink_ns, jsink_ns / text_ns);
+}
+
+// ns per string, SIMD scan vs byte at a time.
+TEST(JsonEncoderBench, EscapeSimdVsScalar) {
+    constexpr std::size_t kRounds = 200;
+    std::printf("\n%8s %8s %12s %12s %10s\n", "len", "escapes", "scalar ns", "simd ns", "speedup");
+    for (std::size_t len : {32u, 128u, 1024u})
+        for (unsigned every : {0u, 64u, 8u}) {
+            const auto paths = make_paths(256, len, every);
+            std::string out(len * 6 + 2, '\0');
+            const double scalar_ns = ns_per_item(paths, [&](const std::string& s) {
+                FieldWriter w{out.data(), out.size()};
+                put_json_chars_scalar(w, s);
+                return w.size();
+            }, kRounds);
+            const double simd_ns = ns_per_item(paths, [&](const std::string& s) {
+                FieldWriter w{out.data(), out.size()};
+                put_json_chars(w, s);
+                return w.size();
+            }, kRounds);
+            std::printf("%8zu %8s %12.1f %12.1f %9.2fx\n", len,
+                        every == 0 ? "none" : (every == 64 ? "1/64" : "1/8"), scalar_ns, simd_ns, scalar_ns / simd_ns);
+        }
+}
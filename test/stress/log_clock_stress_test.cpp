@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logger/core/log_clock.hpp"
+#include "publisher/sink_publisher.hpp"
+
+using logger::core::LogClock;
+
+namespace {
+
+template <typename Fn>
+double ns_per_call(Fn&& fn, std::size_t calls) {
+    std::uint64_t sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < calls; ++i)
+        sink += fn(i);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    EXPECT_NE(sink, 0u);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(calls);
+}
+
+// The TextSink timestamp before the cached prefix: localtime and an
+// ostringstream on every line.
+std::string ostream_timestamp(std::uint64_t us_since_epoch) {
+    const auto secs = static_cast<std::time_t>(us_since_epoch / 1'000'000);
+    std::ostringstream oss;
+    oss << std::put_time(std::localtime(&secs), "%Y-%m-%d %H:%M:%S")
+        << '.' << std::setfill('0') << std::setw(6) << us_since_epoch % 1'000'000;
+    return oss.str();
+}
+
+} // namespace
+
+// Readers on several threads while the clock is re-anchored over and over:
+// no thread may see time go backwards.
+TEST(LogClockStress, MonotonicAcrossRecalibration) {
+    LogClock clock;
+    if (!clock.uses_tsc())
+        GTEST_SKIP() << "no invariant TSC";
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            clock.recalibrate();
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    std::vector<std::size_t> backwards(4, 0);
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < backwards.size(); ++t) {
+        readers.emplace_back([&, t] {
+            std::uint64_t last = clock.now_ns();
+            for (int i = 0; i < 200000; ++i) {
+                const std::uint64_t now = clock.now_ns();
+                backwards[t] += now < last;
+                last = now;
+            }
+        });
+    }
+    for (auto& th : readers)
+        th.join();
+    stop = true;
+    writer.join();
+
+    for (std::size_t t = 0; t < backwards.size(); ++t)
+        EXPECT_EQ(backwards[t], 0u) << "thread " << t;
+}
+
+// ns per timestamp read and per rendered timestamp. Numbers only.
+TEST(LogClockBench, ReadAndFormatCost) {
+    constexpr std::size_t kCalls = 2'000'000;
+    LogClock tsc;
+    LogClock coarse{LogClock::Source::Coarse};
+
+    std::printf("\n%28s %10s\n", "clock read", "ns");
+    std::printf("%28s %10.1f%s\n", "LogClock (Auto)",
+                ns_per_call([&](std::size_t) { return tsc.now_ns(); }, kCalls),
+                tsc.uses_tsc() ? "" : "  (no invariant TSC: coarse)");
+    std::printf("%28s %10.1f\n", "LogClock (Coarse)",
+                ns_per_call([&](std::size_t) { return coarse.now_ns(); }, kCalls));
+    std::printf("%28s %10.1f\n", "steady_clock::now",
+                ns_per_call([](std::size_t) {
+                    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+                }, kCalls));
+    std::printf("%28s %10.1f\n", "system_clock::now",
+                ns_per_call([](std::size_t) {
+                    return static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+                }, kCalls));
+
+    // 1000 records per second of log time: the cached prefix is rebuilt
+    // on one line in a thousand.
+    constexpr std::size_t kLines = 200'000;
+    const std::uint64_t base_us = tsc.now_us();
+    const double old_ns = ns_per_call([&](std::size_t i) {
+        return ostream_timestamp(base_us + i * 1000).size();
+    }, kLines);
+    const double new_ns = ns_per_call([&](std::size_t i) {
+        return TextSink::format("timestamp=" + std::to_string(base_us + i * 1000)).size();
+    }, kLines);
+    const double line_ns = ns_per_call([&](std::size_t i) {
+        return TextSink::format("request_id=" + std::to_string(base_us + i * 1000)).size();
+    }, kLines);
+
+    std::printf("\n%28s %10s\n", "timestamp rendering", "ns");
+    std::printf("%28s %10.1f\n", "localtime + ostringstream", old_ns);
+    std::printf("%28s %10.1f\n", "cached date-second prefix", new_ns - line_ns);
+}
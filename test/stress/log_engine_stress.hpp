@@ -3,6 +3,8 @@
 #include "harness/stress_builder.hpp"
 #include "logger/core/lockfree_queue.hpp"
 #include "logger/core/log_record.hpp"
+#include "logger/core/overflow_policy.hpp"
+#include "logger/core/record_arena.hpp"
 #include "logger/core/stream_adapter.hpp"
 #include "common/messages/payloads/payloads.hpp"
 #include "logger/registry/payload_register.hpp"
@@ -21,17 +23,34 @@ using logger::core::detail::FreeList;
 using logger::core::detail::MpscQueue;
 using logger::core::detail::MpscNode;
 using logger::core::detail::LogRecord;
+using logger::core::detail::RecordArena;
+using logger::core::detail::PoolBackpressure;
+using logger::core::Overflow;
+using logger::core::OverflowConfig;
+using logger::core::OverflowStats;
+
+// Optional pool growth, mirroring EngineConfig::max_pool_slabs & co.
+struct PoolGrowth {
+    std::size_t max_slabs   = 0;
+    std::size_t slab_size   = 1024;
+    std::size_t after_drops = 64;
+};
 
 // Instancjowalny pipeline identyczny z LogEngine, ale bez singletona.
 // Pozwala na izolowane stress-testy.
 class StressableLogEngine {
 public:
-    explicit StressableLogEngine(std::size_t pool_size = 1024)
+    explicit StressableLogEngine(std::size_t pool_size = 1024,
+                                 PoolGrowth growth = {},
+                                 OverflowConfig overflow = {})
         : pool_size_(pool_size)
-        , pool_(std::make_unique<LogRecord[]>(pool_size))
+        , growth_(growth)
     {
+        backpressure_.configure(overflow);
+        arena_.reserve(pool_size + growth_.max_slabs * growth_.slab_size);
+        LogRecord* first = arena_.commit(pool_size_);
         for (std::size_t i = 0; i < pool_size_; ++i) {
-            freelist_.push(&pool_[i]);
+            freelist_.push(&first[i]);
         }
     }
 
@@ -49,9 +68,24 @@ public:
         }
     }
 
-    template <typename Envelope>
+    template <Overflow Policy = Overflow::DropNewest, typename Envelope>
     bool enqueue(Envelope&& env) {
+        if constexpr (Policy == Overflow::BySeverity) {
+            const uint64_t in_use = enqueued_.load(std::memory_order_relaxed) -
+                                    released_.load(std::memory_order_relaxed);
+            if (backpressure_.sheds(logger::core::severity_of(env), in_use, arena_.capacity())) {
+                backpressure_.count_severity_shed();
+                misses_.fetch_add(1, std::memory_order_relaxed);
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+
         LogRecord* rec = static_cast<LogRecord*>(freelist_.try_pop());
+        if (!rec) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            rec = on_overflow<Policy>(env);
+        }
         if (!rec) {
             dropped_.fetch_add(1, std::memory_order_relaxed);
             return false;
@@ -68,7 +102,8 @@ public:
         rec->destroy_fn = [](void* s) noexcept {
             static_cast<Stored*>(s)->~Stored();
         };
-        rec->submit_fn  = [](void*) {};
+        rec->format_fn  = [](void*, char*, std::size_t) -> std::size_t { return 0; };
+        rec->sheddable  = Policy == Overflow::DropOldest;
 
         queue_.push(rec);
         enqueued_.fetch_add(1, std::memory_order_relaxed);
@@ -87,15 +122,74 @@ public:
     uint64_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
     uint64_t enqueued() const noexcept { return enqueued_.load(std::memory_order_relaxed); }
     uint64_t written()  const noexcept { return written_.load(std::memory_order_relaxed); }
+    // Written records that were enqueued under DropOldest.
+    uint64_t written_sheddable() const noexcept { return written_sheddable_.load(std::memory_order_relaxed); }
+    bool shed_pending() const noexcept { return backpressure_.shed_pending(); }
     std::size_t pool_size() const noexcept { return pool_size_; }
+    std::size_t capacity()  const noexcept { return arena_.capacity(); }
+    std::size_t slabs()     const noexcept { return arena_.slabs(); }
+    OverflowStats overflow_stats() const noexcept { return backpressure_.stats(); }
 
 private:
+    template <Overflow Policy, typename Envelope>
+    LogRecord* on_overflow(const Envelope& env) {
+        auto try_acquire = [this] { return static_cast<LogRecord*>(freelist_.try_pop()); };
+
+        if constexpr (Policy == Overflow::DropOldest)
+            backpressure_.request_shed();
+
+        LogRecord* rec = nullptr;
+        if (logger::core::overflow_waits<Policy>(env))
+            rec = backpressure_.wait_for_record(try_acquire);
+        else
+            backpressure_.count_full_drop();
+
+        if constexpr (Policy == Overflow::DropOldest)
+            backpressure_.cancel_shed();
+        return rec;
+    }
+
+    void process(LogRecord* rec) {
+        char line[1];
+        rec->format_fn(rec->storage_ptr(), line, 0);
+        rec->destroy_fn(rec->storage_ptr());
+        released_.store(released_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (rec->sheddable && backpressure_.shed_pending() && backpressure_.take_shed()) {
+            backpressure_.count_shed_oldest();
+            return;
+        }
+        if (rec->sheddable)
+            written_sheddable_.fetch_add(1, std::memory_order_relaxed);
+        written_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void maybe_grow_pool() {
+        if (arena_.slabs() > growth_.max_slabs)
+            return;
+
+        const uint64_t misses = misses_.load(std::memory_order_relaxed);
+        if (misses - misses_at_last_slab_ < growth_.after_drops)
+            return;
+
+        misses_at_last_slab_ = misses;
+        if (LogRecord* first = arena_.commit(growth_.slab_size)) {
+            for (std::size_t i = 0; i < growth_.slab_size; ++i) {
+                freelist_.push(&first[i]);
+            }
+            backpressure_.notify_freed();
+        }
+    }
+
     void worker_loop() {
         using namespace std::chrono_literals;
 
         LogRecord* pending_recycle = nullptr;
 
         while (run_.load(std::memory_order_acquire) || !queue_.empty()) {
+            if (growth_.max_slabs)
+                maybe_grow_pool();
+
             MpscNode* node = queue_.pop();
             if (!node) {
                 std::this_thread::sleep_for(50us);
@@ -105,11 +199,10 @@ private:
 
             if (pending_recycle) {
                 freelist_.push(pending_recycle);
+                backpressure_.notify_freed();
             }
 
-            rec->destroy_fn(rec->storage_ptr());
-            written_.fetch_add(1, std::memory_order_relaxed);
-
+            process(rec);
             pending_recycle = rec;
         }
 
@@ -120,9 +213,7 @@ private:
                 freelist_.push(pending_recycle);
             }
 
-            rec->destroy_fn(rec->storage_ptr());
-            written_.fetch_add(1, std::memory_order_relaxed);
-
+            process(rec);
             pending_recycle = rec;
         }
 
@@ -132,15 +223,21 @@ private:
     }
 
     std::size_t pool_size_;
-    std::unique_ptr<LogRecord[]> pool_;
+    PoolGrowth growth_;
+    RecordArena arena_;
+    uint64_t misses_at_last_slab_{0};
     FreeList freelist_;
     MpscQueue queue_;
+    PoolBackpressure backpressure_;
     std::atomic<bool> run_{false};
     std::thread worker_;
 
     std::atomic<uint64_t> dropped_{0};
     std::atomic<uint64_t> enqueued_{0};
     std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> written_sheddable_{0};
+    std::atomic<uint64_t> released_{0};     // worker-written
+    std::atomic<uint64_t> misses_{0};       // enqueues that found the pool empty
 
 };
 
@@ -157,9 +254,10 @@ class LogEngineStress
 {
 public:
     explicit LogEngineStress(harness::StressConfig cfg,
-                             std::size_t pool_size = 1024)
+                             std::size_t pool_size = 1024,
+                             PoolGrowth growth = {})
         : StressBuilder(cfg)
-        , engine_(pool_size)
+        , engine_(pool_size, growth)
     {
         engine_.start();
     }
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <cstdio>
 #include <thread>
+#include <vector>
 #include "stress/log_engine_stress.hpp"
 
 using namespace harness;
@@ -117,3 +119,95 @@ INSTANTIATE_TEST_SUITE_P(
              + "_p" + std::to_string(info.param.pool_size);
     }
 );
+
+// Pool growth: a burst that overruns a tiny pool makes the worker add
+// slabs, never more than configured, and nothing is lost along the way.
+TEST(LogEnginePoolGrowth, BurstGrowsPoolUpToMaxSlabs) {
+    StressConfig cfg{.thread_count = 8, .iterations_per_thread = 20000};
+    PoolGrowth growth{.max_slabs = 4, .slab_size = 256, .after_drops = 32};
+
+    LogEngineStress stress{cfg, 64, growth};
+    stress.run();
+    stress.engine().shutdown();
+
+    auto& eng = stress.engine();
+    std::size_t total = cfg.thread_count * cfg.iterations_per_thread;
+
+    EXPECT_EQ(eng.enqueued() + eng.dropped(), total);
+    EXPECT_EQ(eng.written(), eng.enqueued());
+    EXPECT_GT(eng.slabs(), 1u) << "burst never triggered growth";
+    EXPECT_LE(eng.slabs(), 1 + growth.max_slabs);
+    EXPECT_EQ(eng.capacity(), 64 + (eng.slabs() - 1) * growth.slab_size);
+}
+
+// Block never drops, so growth has to come from the enqueues that waited:
+// otherwise producers queue up behind a pool that could have grown.
+TEST(LogEnginePoolGrowth, BlockingProducersGrowPool) {
+    constexpr std::size_t kThreads = 8;
+    constexpr std::size_t kPerThread = 20000;
+    PoolGrowth growth{.max_slabs = 4, .slab_size = 256, .after_drops = 32};
+    OverflowConfig overflow;
+    overflow.block_timeout = std::chrono::seconds(5);
+
+    StressableLogEngine eng{64, growth, overflow};
+    eng.start();
+
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < kThreads; ++t)
+        producers.emplace_back([&eng, t] {
+            for (std::size_t i = 0; i < kPerThread; ++i)
+                eng.enqueue<Overflow::Block>(StressEnvelope{t, i});
+        });
+    for (auto& p : producers)
+        p.join();
+    eng.shutdown();
+
+    EXPECT_EQ(eng.dropped(), 0u);
+    EXPECT_EQ(eng.enqueued(), kThreads * kPerThread);
+    EXPECT_GT(eng.overflow_stats().blocked, 0u);
+    EXPECT_GT(eng.slabs(), 1u) << "waiting producers never triggered growth";
+    EXPECT_LE(eng.slabs(), 1 + growth.max_slabs);
+}
+
+TEST(LogEnginePoolGrowth, FixedPoolNeverGrows) {
+    StressConfig cfg{.thread_count = 8, .iterations_per_thread = 20000};
+
+    LogEngineStress stress{cfg, 64};
+    stress.run();
+    stress.engine().shutdown();
+
+    auto& eng = stress.engine();
+    EXPECT_EQ(eng.slabs(), 1u);
+    EXPECT_EQ(eng.capacity(), 64u);
+    EXPECT_EQ(eng.written(), eng.enqueued());
+}
+
+// Drops per burst, fixed vs growable pool. Slabs added during early bursts
+// stay resident, so later bursts should drop less. Numbers only.
+TEST(LogEnginePoolGrowth, DropsFixedVsGrowable) {
+    constexpr int kBursts = 4;
+    StressConfig cfg{.thread_count = 8, .iterations_per_thread = 1024};
+    PoolGrowth growth{.max_slabs = 8, .slab_size = 1024, .after_drops = 64};
+
+    std::printf("\n%10s", "pool");
+    for (int b = 0; b < kBursts; ++b)
+        std::printf("   burst%d drops", b + 1);
+    std::printf(" %8s %10s\n", "slabs", "capacity");
+
+    for (bool grow : {false, true}) {
+        LogEngineStress stress{cfg, 1024, grow ? growth : PoolGrowth{}};
+        auto& eng = stress.engine();
+
+        std::printf("%10s", grow ? "growable" : "fixed");
+        for (int b = 0; b < kBursts; ++b) {
+            const uint64_t before = eng.dropped();
+            stress.run();
+            std::printf(" %15llu", static_cast<unsigned long long>(eng.dropped() - before));
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        eng.shutdown();
+        std::printf(" %8zu %10zu\n", eng.slabs(), eng.capacity());
+
+        EXPECT_EQ(eng.written(), eng.enqueued());
+    }
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "logger/logger.hpp"
+
+using logger::core::Overflow;
+using logger::limit::Folded;
+
+namespace {
+
+// Stands in for LogEngine: counts records and the suppressed counts
+// folded into them.
+struct CountingEngine {
+    static CountingEngine& instance() noexcept {
+        static CountingEngine eng;
+        return eng;
+    }
+
+    template <Overflow = Overflow::DropNewest, typename Envelope>
+    void enqueue(Envelope&& env) {
+        records.fetch_add(1, std::memory_order_relaxed);
+        if constexpr (requires { env.suppressed; })
+            folded.fetch_add(env.suppressed, std::memory_order_relaxed);
+    }
+
+    void reset() {
+        records.store(0);
+        folded.store(0);
+    }
+
+    std::atomic<std::uint64_t> records{0};
+    std::atomic<std::uint64_t> folded{0};
+};
+
+constexpr bool kSiteCompiled =
+    logger::filter::compiled_in<Severity::Info, LogClassId::Handler, MethodId::Handler_handlingEvent>;
+
+void every_1000(std::uint64_t i) {
+    LOGGER_LOG_EVERY_N_TO(CountingEngine, 1000, Generic, Info, Handler, handlingEvent,
+                          std::uint64_t{i}, std::uint32_t{1u}, std::uint32_t{2u}, std::uint16_t{1u});
+}
+
+void rate_100(std::uint64_t i) {
+    LOGGER_LOG_RATE_TO(CountingEngine, 100, 10, Generic, Info, Handler, handlingEvent,
+                       std::uint64_t{i}, std::uint32_t{1u}, std::uint32_t{2u}, std::uint16_t{1u});
+}
+
+void unlimited(std::uint64_t i) {
+    LOGGER_LOG_TO(CountingEngine, Generic, Info, Handler, handlingEvent,
+                  std::uint64_t{i}, std::uint32_t{1u}, std::uint32_t{2u}, std::uint16_t{1u});
+}
+
+// ns per call with `threads` threads hammering one call site.
+template <typename Fn>
+double ns_per_call(Fn fn, std::size_t threads, std::uint64_t per_thread) {
+    std::vector<std::thread> ts;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t)
+        ts.emplace_back([&] {
+            for (std::uint64_t i = 0; i < per_thread; ++i)
+                fn(i);
+        });
+    for (auto& t : ts)
+        t.join();
+    const auto t1 = std::chrono::steady_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(per_thread);
+}
+
+} // namespace
+
+// Every call is either emitted or counted in a later record's suppressed=,
+// except those a thread skipped after its last emitted record.
+TEST(LogLimitStress, SkippedCallsAreFolded) {
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    constexpr std::size_t kThreads = 4;
+    constexpr std::uint64_t kPer = 200'001;     // ends on an emitted call per thread
+    auto& eng = CountingEngine::instance();
+    eng.reset();
+
+    ns_per_call(every_1000, kThreads, kPer);
+    EXPECT_EQ(eng.records.load(), kThreads * 201);
+    EXPECT_EQ(eng.records.load() + eng.folded.load(), kThreads * kPer);
+}
+
+TEST(LogLimitStress, RateHoldsAcrossThreads) {
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    auto& eng = CountingEngine::instance();
+    eng.reset();
+
+    const auto t0 = std::chrono::steady_clock::now();
+    ns_per_call(rate_100, 4, 2'000'000);
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // Burst of 10, then 100 per second.
+    EXPECT_LE(static_cast<double>(eng.records.load()), 10 + 100 * secs + 1);
+    EXPECT_GE(eng.records.load(), 10u);
+}
+
+// ns per call at one call site. Numbers only; absolute values depend on
+// the host. "unlimited" builds the payload for a no-op engine.
+TEST(LogLimitBench, SuppressedPathCost) {
+    if constexpr (!kSiteCompiled)
+        GTEST_SKIP() << "Handler::handlingEvent compiled out in this build";
+
+    constexpr std::uint64_t kPer = 5'000'000;
+    std::printf("\n%14s %8s %10s\n", "site", "threads", "ns/call");
+    for (std::size_t threads : {1u, 4u}) {
+        std::printf("%14s %8zu %10.2f\n", "unlimited", threads, ns_per_call(unlimited, threads, kPer));
+        std::printf("%14s %8zu %10.2f\n", "every 1000", threads, ns_per_call(every_1000, threads, kPer));
+        std::printf("%14s %8zu %10.2f\n", "rate 100/s", threads, ns_per_call(rate_100, threads, kPer));
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "harness/stress_builder.hpp"
+#include "stress/log_engine_stress.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace stress {
+
+// Stress envelope carrying a severity so BySeverity has something to sort on
+struct SeverityEnvelope {
+    Severity    severity;
+    std::size_t thread_id;
+    std::size_t sequence;
+};
+static_assert(sizeof(SeverityEnvelope) <= LogRecord::StorageSize);
+
+// Severity cycles Info, Warn, Error per iteration.
+inline Severity severity_for(std::size_t iteration) noexcept {
+    return static_cast<Severity>(iteration % 3);
+}
+
+// StressBuilder derived: every enqueue goes through overflow policy `Policy`;
+// refusals are counted per severity.
+template <Overflow Policy>
+class OverflowStress
+    : public harness::StressBuilder<OverflowStress<Policy>>
+{
+    using Base = harness::StressBuilder<OverflowStress<Policy>>;
+
+public:
+    OverflowStress(harness::StressConfig cfg, std::size_t pool_size,
+                   OverflowConfig overflow = {})
+        : Base(cfg)
+        , engine_(pool_size, PoolGrowth{}, overflow)
+    {
+        engine_.start();
+    }
+
+    bool do_impl(std::size_t tid, std::size_t iteration) noexcept {
+        const Severity s = severity_for(iteration);
+        const bool ok = engine_.template enqueue<Policy>(SeverityEnvelope{s, tid, iteration});
+        if (!ok)
+            refused_[static_cast<std::size_t>(s)].fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    uint64_t refused(Severity s) const noexcept {
+        return refused_[static_cast<std::size_t>(s)].load(std::memory_order_relaxed);
+    }
+
+    StressableLogEngine& engine() noexcept { return engine_; }
+
+private:
+    StressableLogEngine engine_;
+    std::array<std::atomic<uint64_t>, 3> refused_{};
+};
+
+} // namespace stress
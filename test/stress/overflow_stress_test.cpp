@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "stress/overflow_stress.hpp"
+
+using namespace harness;
+using namespace stress;
+using namespace std::chrono_literals;
+
+struct OverflowTestConfig {
+    StressConfig stress;
+    std::size_t  pool_size;
+};
+
+class OverflowStressTest
+    : public ::testing::TestWithParam<OverflowTestConfig>
+{};
+
+template <Overflow Policy>
+void expect_accounting(OverflowStress<Policy>& stress, const StressConfig& cfg) {
+    auto& eng = stress.engine();
+    const auto stats = eng.overflow_stats();
+    std::size_t total = cfg.thread_count * cfg.iterations_per_thread;
+
+    EXPECT_EQ(eng.enqueued() + eng.dropped(), total)
+        << "enqueued=" << eng.enqueued() << " dropped=" << eng.dropped();
+    EXPECT_EQ(eng.written() + stats.shed_oldest, eng.enqueued())
+        << "written=" << eng.written() << " shed_oldest=" << stats.shed_oldest;
+    EXPECT_EQ(stats.dropped_full + stats.block_timeouts + stats.shed_by_severity,
+              eng.dropped());
+    EXPECT_LE(stats.block_timeouts, stats.blocked);
+}
+
+TEST_P(OverflowStressTest, DropNewestCountsEveryRefusal) {
+    auto [cfg, pool_size] = GetParam();
+    OverflowStress<Overflow::DropNewest> stress{cfg, pool_size};
+    stress.run();
+    stress.engine().shutdown();
+
+    expect_accounting(stress, cfg);
+    const auto stats = stress.engine().overflow_stats();
+    EXPECT_EQ(stats.blocked, 0u);
+    EXPECT_EQ(stats.shed_oldest, 0u);
+    EXPECT_EQ(stats.dropped_full, stress.engine().dropped());
+}
+
+// With a generous timeout a blocking producer always gets its record
+TEST_P(OverflowStressTest, BlockLosesNothing) {
+    auto [cfg, pool_size] = GetParam();
+    OverflowStress<Overflow::Block> stress{cfg, pool_size,
+                                           OverflowConfig{.block_timeout = 5s}};
+    stress.run();
+    stress.engine().shutdown();
+
+    expect_accounting(stress, cfg);
+    EXPECT_EQ(stress.engine().dropped(), 0u);
+    EXPECT_EQ(stress.engine().written(), cfg.thread_count * cfg.iterations_per_thread);
+}
+
+// A short timeout bounds the wait: the record is dropped, never stuck
+TEST_P(OverflowStressTest, BlockTimeoutIsBounded) {
+    auto [cfg, pool_size] = GetParam();
+    OverflowStress<Overflow::Block> stress{cfg, pool_size,
+                                           OverflowConfig{.block_spins = 0,
+                                                          .block_timeout = 1us}};
+    stress.run();
+    stress.engine().shutdown();
+
+    expect_accounting(stress, cfg);
+    EXPECT_EQ(stress.engine().overflow_stats().dropped_full, 0u);
+}
+
+// Dropped-oldest records were enqueued but never written
+TEST_P(OverflowStressTest, DropOldestShedsQueuedRecords) {
+    auto [cfg, pool_size] = GetParam();
+    OverflowStress<Overflow::DropOldest> stress{cfg, pool_size};
+    stress.run();
+    stress.engine().shutdown();
+
+    expect_accounting(stress, cfg);
+    EXPECT_EQ(stress.engine().overflow_stats().dropped_full, 0u);
+    EXPECT_FALSE(stress.engine().shed_pending()) << "a shed request outlived its producer's wait";
+}
+
+// Error is never shed early and never times out; Info goes first
+TEST_P(OverflowStressTest, BySeverityKeepsErrors) {
+    auto [cfg, pool_size] = GetParam();
+    OverflowStress<Overflow::BySeverity> stress{cfg, pool_size,
+                                                OverflowConfig{.block_timeout = 5s}};
+    stress.run();
+    stress.engine().shutdown();
+
+    expect_accounting(stress, cfg);
+    EXPECT_EQ(stress.refused(Severity::Error), 0u);
+    EXPECT_GE(stress.refused(Severity::Info), stress.refused(Severity::Warn));
+    EXPECT_EQ(stress.engine().overflow_stats().block_timeouts, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    OverflowVariants,
+    OverflowStressTest,
+    ::testing::Values(
+        OverflowTestConfig{{.thread_count = 4,  .iterations_per_thread = 10000}, 512},
+        OverflowTestConfig{{.thread_count = 8,  .iterations_per_thread = 5000},  64},
+        OverflowTestConfig{{.thread_count = 16, .iterations_per_thread = 2000},  16}
+    ),
+    [](const auto& info) {
+        return "t" + std::to_string(info.param.stress.thread_count)
+             + "_i" + std::to_string(info.param.stress.iterations_per_thread)
+             + "_p" + std::to_string(info.param.pool_size);
+    }
+);
+
+// DropOldest and Block call sites sharing one pool: sheds only ever take
+// DropOldest records, so every Block record is written.
+TEST(OverflowPolicies, DropOldestNeverShedsOtherPolicies) {
+    constexpr std::size_t kPerSide = 4;
+    constexpr std::size_t kIterations = 5000;
+    StressableLogEngine eng{32, PoolGrowth{}, OverflowConfig{.block_timeout = 5s}};
+    eng.start();
+
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < 2 * kPerSide; ++t)
+        producers.emplace_back([&eng, t] {
+            for (std::size_t i = 0; i < kIterations; ++i) {
+                const SeverityEnvelope env{Severity::Error, t, i};
+                if (t % 2)
+                    eng.enqueue<Overflow::DropOldest>(env);
+                else
+                    eng.enqueue<Overflow::Block>(env);
+            }
+        });
+    for (auto& p : producers)
+        p.join();
+    eng.shutdown();
+
+    EXPECT_EQ(eng.dropped(), 0u);
+    EXPECT_EQ(eng.written() - eng.written_sheddable(), kPerSide * kIterations)
+        << "a Block record was shed";
+    EXPECT_EQ(eng.written_sheddable() + eng.overflow_stats().shed_oldest, kPerSide * kIterations);
+    EXPECT_FALSE(eng.shed_pending());
+}
+
+// Per-policy outcome for the same overloaded burst; numbers only.
+TEST(OverflowPolicies, OutcomeTable) {
+    StressConfig cfg{.thread_count = 8, .iterations_per_thread = 20000};
+    constexpr std::size_t kPool = 256;
+
+    std::printf("\n%11s %9s %9s %9s %9s %9s %9s %9s %9s\n",
+                "policy", "written", "dropped", "full", "blocked", "timeouts",
+                "shed-old", "shed-sev", "err-lost");
+
+    auto report = [&](auto& stress, Overflow p) {
+        stress.run();
+        stress.engine().shutdown();
+        auto& eng = stress.engine();
+        const auto st = eng.overflow_stats();
+        std::printf("%11s %9llu %9llu %9llu %9llu %9llu %9llu %9llu %9llu\n",
+                    logger::core::toString(p),
+                    static_cast<unsigned long long>(eng.written()),
+                    static_cast<unsigned long long>(eng.dropped()),
+                    static_cast<unsigned long long>(st.dropped_full),
+                    static_cast<unsigned long long>(st.blocked),
+                    static_cast<unsigned long long>(st.block_timeouts),
+                    static_cast<unsigned long long>(st.shed_oldest),
+                    static_cast<unsigned long long>(st.shed_by_severity),
+                    static_cast<unsigned long long>(stress.refused(Severity::Error)));
+        expect_accounting(stress, cfg);
+    };
+
+    { OverflowStress<Overflow::DropNewest> s{cfg, kPool}; report(s, Overflow::DropNewest); }
+    { OverflowStress<Overflow::Block>      s{cfg, kPool}; report(s, Overflow::Block); }
+    { OverflowStress<Overflow::DropOldest> s{cfg, kPool}; report(s, Overflow::DropOldest); }
+    { OverflowStress<Overflow::BySeverity> s{cfg, kPool}; report(s, Overflow::BySeverity); }
+}
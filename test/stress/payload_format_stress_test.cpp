@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/messages/traits.hpp"
+#include "logger/core/stream_adapter.hpp"
+#include "logger/registry/payload_register.hpp"
+
+using logger::core::detail::SpanStringBuf;
+using logger::registry::GenericPayload;
+
+namespace {
+
+template <typename P>
+P make_payload(std::uint64_t i) {
+    P p{};
+    p.severity       = static_cast<Severity>(i % 3);
+    p.timestamp      = 1'700'000'000'000'000'000ull + i;
+    p.thread_id      = static_cast<std::uint32_t>(i % 64);
+    p.request_id     = static_cast<std::uint32_t>(i * 2654435761u);
+    p.class_id       = static_cast<std::uint16_t>(i % 500);
+    p.method_id      = static_cast<std::uint16_t>(i % 4000);
+    p.schema_version = 1;
+    if constexpr (requires { p.path; }) {
+        p.req_unique_id = i * 31;
+        p.path          = "/api/v1/orders/12345/items";
+    }
+    return p;
+}
+
+// The pre-format_to worker path: debug_print through a re-pointed streambuf.
+template <typename P>
+std::size_t ostream_format(const P& p, char* dst, std::size_t cap) {
+    thread_local SpanStringBuf buf;
+    thread_local std::ostream os(&buf);
+    buf.reset(dst, cap);
+    os.clear();
+    p.debug_print(os);
+    return buf.written();
+}
+
+template <typename P>
+std::size_t direct_format(const P& p, char* dst, std::size_t cap) {
+    const std::size_t need = p.format_to(dst, cap);
+    return need < cap ? need : cap;
+}
+
+template <typename P, typename Fn>
+double ns_per_record(const std::vector<P>& in, Fn&& fn, std::size_t rounds) {
+    std::array<char, 1024> buf{};
+    std::size_t sink = 0;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r)
+        for (const auto& p : in)
+            sink += fn(p, buf.data(), buf.size());
+    const auto t1 = std::chrono::steady_clock::now();
+
+    EXPECT_GT(sink, 0u);
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    return static_cast<double>(ns) / static_cast<double>(rounds * in.size());
+}
+
+template <typename P>
+void report(const char* name, std::size_t rounds) {
+    std::vector<P> in;
+    for (std::uint64_t i = 0; i < 1024; ++i)
+        in.push_back(make_payload<P>(i));
+
+    const double os_ns  = ns_per_record(in, ostream_format<P>, rounds);
+    const double fmt_ns = ns_per_record(in, direct_format<P>,  rounds);
+
+    std::printf("%18s %12.1f %12.1f %9.2fx\n", name, os_ns, fmt_ns, os_ns / fmt_ns);
+}
+
+} // namespace
+
+// Both paths from several threads at once must produce identical text.
+TEST(PayloadFormatStress, MatchesDebugPrintAcrossThreads) {
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kPerThread = 20000;
+
+    std::vector<std::size_t> mismatches(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            std::array<char, 1024> a{}, b{};
+            for (std::size_t i = 0; i < kPerThread; ++i) {
+                const auto p = make_payload<RequestPayload>(t * kPerThread + i);
+                const std::size_t na = ostream_format(p, a.data(), a.size());
+                const std::size_t nb = direct_format(p, b.data(), b.size());
+                if (std::string_view{a.data(), na} != std::string_view{b.data(), nb})
+                    ++mismatches[t];
+            }
+        });
+    }
+    for (auto& th : threads)
+        th.join();
+
+    for (std::size_t t = 0; t < kThreads; ++t)
+        EXPECT_EQ(mismatches[t], 0u) << "thread " << t;
+}
+
+// ns per record, debug_print via std::ostream vs format_to. Numbers only;
+// absolute values depend on the host.
+TEST(PayloadFormatBench, OstreamVsFormatTo) {
+    constexpr std::size_t kRounds = 200;
+
+    std::printf("\n%18s %12s %12s %10s\n", "payload", "ostream ns", "format ns", "speedup");
+    report<GenericPayload>("GenericPayload", kRounds);
+    report<logger::registry::RequestPayload>("registry::Request", kRounds);
+    report<RequestPayload>("RequestPayload", kRounds);
+}
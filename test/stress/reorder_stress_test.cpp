@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "logger/core/reorder_buffer.hpp"
+#include "logger/core/spsc_ring.hpp"
+
+using logger::core::detail::LaneSet;
+using logger::core::detail::LogRecord;
+using logger::core::detail::ReorderBuffer;
+using logger::core::detail::SpscLane;
+using logger::core::detail::StampKey;
+using logger::core::detail::producer_stamp;
+using logger::core::detail::stamp_now;
+
+namespace {
+
+struct Result {
+    std::vector<std::uint64_t> e2e_ns;      // stamp -> written
+    std::uint64_t out_of_order = 0;
+    std::uint64_t hold_ns_total = 0;
+    std::uint64_t forced = 0;
+};
+
+// Producers stamp records into their own lanes the way LogEngine::stamp
+// does; one consumer drains the lanes in bursts (the worker's round-robin)
+// and writes either directly (window 0) or through a ReorderBuffer.
+// Output order is checked against the stamps.
+Result run(std::size_t producers, std::size_t per_thread, std::chrono::microseconds window) {
+    LaneSet lanes{producers, 1024};
+    std::atomic<std::size_t> done{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < producers; ++t) {
+        threads.emplace_back([&] {
+            SpscLane* lane = lanes.local();
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                LogRecord* rec;
+                while (!(rec = lane->try_reserve()))
+                    std::this_thread::yield();
+                auto& p = producer_stamp();
+                rec->stamp    = stamp_now();
+                rec->producer = p.id;
+                rec->seq      = p.next_seq++;
+                lane->commit();
+            }
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    const std::uint64_t window_ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(window).count());
+    ReorderBuffer rb = window_ns ? ReorderBuffer{256 * 1024, 4096} : ReorderBuffer{};
+
+    Result r;
+    r.e2e_ns.reserve(producers * per_thread);
+    std::uint64_t last = 0;
+    auto write = [&](std::uint64_t stamp) {
+        if (stamp < last)
+            ++r.out_of_order;
+        last = std::max(last, stamp);
+        r.e2e_ns.push_back(stamp_now() - stamp);
+    };
+    auto emit = [&](std::string_view v) {
+        std::uint64_t stamp;
+        std::memcpy(&stamp, v.data(), sizeof(stamp));
+        write(stamp);
+    };
+
+    for (;;) {
+        const bool finished = done.load(std::memory_order_acquire) == producers;
+        const std::uint64_t now = stamp_now();
+        const std::size_t n = lanes.drain([&](LogRecord* rec) {
+            if (!window_ns) {
+                write(rec->stamp);
+                return;
+            }
+            while (!rb.has_room(64))
+                rb.release_oldest(now, emit);
+            rb.append(StampKey{rec->stamp, rec->producer, rec->seq}, now,
+                      [rec](char* dst, std::size_t) {
+                          std::memcpy(dst, &rec->stamp, sizeof(rec->stamp));
+                          return sizeof(rec->stamp);
+                      }, 64);
+        }, 32);
+
+        if (window_ns) {
+            const std::uint64_t t = stamp_now();
+            rb.release(t > window_ns ? t - window_ns : 0, t, emit);
+        }
+        if (n == 0 && finished && lanes.empty())
+            break;
+        if (n == 0)
+            std::this_thread::yield();
+    }
+    rb.release_all(stamp_now(), emit);
+
+    for (auto& th : threads)
+        th.join();
+
+    r.hold_ns_total = rb.stats().hold_ns_total;
+    r.forced = rb.stats().forced;
+    std::sort(r.e2e_ns.begin(), r.e2e_ns.end());
+    return r;
+}
+
+} // namespace
+
+TEST(ReorderStress, EveryRecordWrittenOnce) {
+    const auto r = run(4, 20000, std::chrono::microseconds{200});
+    EXPECT_EQ(r.e2e_ns.size(), 4u * 20000u);
+}
+
+// Out-of-order writes and the latency the window adds, per window size.
+// Numbers only: how much reordering there is to fix depends on scheduling.
+TEST(ReorderBench, WindowVsLatency) {
+    constexpr std::size_t kProducers = 4;
+    constexpr std::size_t kPerThread = 50000;
+
+    std::printf("\n%10s %12s %10s %10s %10s %10s\n",
+                "window us", "out-of-order", "p50 us", "p99 us", "hold us", "forced");
+    for (int us : {0, 10, 100, 1000}) {
+        const auto r = run(kProducers, kPerThread, std::chrono::microseconds{us});
+        ASSERT_EQ(r.e2e_ns.size(), kProducers * kPerThread);
+
+        auto pct = [&](double p) {
+            return static_cast<double>(r.e2e_ns[static_cast<std::size_t>(p * static_cast<double>(r.e2e_ns.size() - 1))]) / 1e3;
+        };
+        std::printf("%10d %12llu %10.1f %10.1f %10.1f %10llu\n", us,
+                    static_cast<unsigned long long>(r.out_of_order), pct(0.50), pct(0.99),
+                    static_cast<double>(r.hold_ns_total) / static_cast<double>(r.e2e_ns.size()) / 1e3,
+                    static_cast<unsigned long long>(r.forced));
+    }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "harness/stress_builder.hpp"
+#include "logger/core/lockfree_queue.hpp"
+#include "logger/core/log_record.hpp"
+#include "logger/core/record_arena.hpp"
+#include "logger/registry/payload_register.hpp"
+#include "stress/log_engine_stress.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+using logger::registry::GenericPayload;
+
+// Instantiable copy of the sharded LogEngine (EngineConfig::workers):
+// one shared record pool, one MPSC queue + worker per shard, every
+// producer sticks to one shard. LogEngine hands shards out round-robin on
+// a thread's first log call; here the harness thread id does the same job,
+// so a run is repeatable. Each worker formats its records for real and
+// checks per-producer FIFO order, which a shard must keep.
+class ShardedStressEngine {
+public:
+    ShardedStressEngine(std::size_t workers, std::size_t producers,
+                        std::size_t pool_size = 4096)
+        : workers_(workers)
+    {
+        arena_.reserve(pool_size);
+        LogRecord* first = arena_.commit(pool_size);
+        for (std::size_t i = 0; i < pool_size; ++i) {
+            freelist_.push(&first[i]);
+        }
+        for (std::size_t k = 0; k < workers_; ++k) {
+            shards_.push_back(std::make_unique<Shard>());
+            shards_.back()->last_seq.assign(producers, -1);
+        }
+    }
+
+    ~ShardedStressEngine() {
+        shutdown();
+    }
+
+    ShardedStressEngine(const ShardedStressEngine&) = delete;
+    ShardedStressEngine& operator=(const ShardedStressEngine&) = delete;
+
+    void start() {
+        bool expected = false;
+        if (run_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            for (auto& shard : shards_) {
+                shard->thread = std::thread(&ShardedStressEngine::worker_loop, this, std::ref(*shard));
+            }
+        }
+    }
+
+    bool enqueue(const StressEnvelope& env) {
+        LogRecord* rec = static_cast<LogRecord*>(freelist_.try_pop());
+        if (!rec) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        new (rec->storage_ptr()) StressEnvelope{env};
+        shards_[env.thread_id % workers_]->queue.push(rec);
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void shutdown() noexcept {
+        bool expected = true;
+        if (run_.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
+            for (auto& shard : shards_) {
+                if (shard->thread.joinable()) {
+                    shard->thread.join();
+                }
+            }
+        }
+    }
+
+    uint64_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t enqueued() const noexcept { return enqueued_.load(std::memory_order_relaxed); }
+
+    // Read after shutdown().
+    uint64_t written() const noexcept {
+        uint64_t sum = 0;
+        for (auto& shard : shards_) sum += shard->written;
+        return sum;
+    }
+    uint64_t bytes() const noexcept {
+        uint64_t sum = 0;
+        for (auto& shard : shards_) sum += shard->bytes;
+        return sum;
+    }
+    uint64_t order_violations() const noexcept {
+        uint64_t sum = 0;
+        for (auto& shard : shards_) sum += shard->order_violations;
+        return sum;
+    }
+    // Shards that saw at least one record.
+    std::size_t busy_shards() const noexcept {
+        std::size_t n = 0;
+        for (auto& shard : shards_) n += shard->written != 0;
+        return n;
+    }
+
+private:
+    struct Shard {
+        MpscQueue queue;
+        std::thread thread;
+
+        // worker-only
+        std::vector<std::int64_t> last_seq;
+        std::array<char, 512> buf{};
+        uint64_t written{0};
+        uint64_t bytes{0};
+        uint64_t order_violations{0};
+    };
+
+    static void consume(Shard& shard, LogRecord* rec) noexcept {
+        const auto env = *static_cast<const StressEnvelope*>(rec->storage_ptr());
+
+        auto& last = shard.last_seq[env.thread_id];
+        if (static_cast<std::int64_t>(env.sequence) <= last) {
+            ++shard.order_violations;
+        }
+        last = static_cast<std::int64_t>(env.sequence);
+
+        // Same per-record work as the engine's text path.
+        GenericPayload p{};
+        p.timestamp  = 1'700'000'000'000'000'000ull + env.sequence;
+        p.thread_id  = static_cast<std::uint32_t>(env.thread_id);
+        p.request_id = static_cast<std::uint32_t>(env.sequence * 2654435761u);
+        p.class_id   = static_cast<std::uint16_t>(env.sequence % 500);
+        p.method_id  = static_cast<std::uint16_t>(env.sequence % 4000);
+        shard.bytes += p.format_to(shard.buf.data(), shard.buf.size());
+        ++shard.written;
+    }
+
+    void worker_loop(Shard& shard) {
+        using namespace std::chrono_literals;
+
+        LogRecord* pending_recycle = nullptr;
+        auto take = [&](MpscNode* node) {
+            LogRecord* rec = static_cast<LogRecord*>(node);
+            if (pending_recycle) {
+                freelist_.push(pending_recycle);
+            }
+            consume(shard, rec);
+            pending_recycle = rec;
+        };
+
+        while (run_.load(std::memory_order_acquire) || !shard.queue.empty()) {
+            MpscNode* node = shard.queue.pop();
+            if (!node) {
+                std::this_thread::sleep_for(50us);
+                continue;
+            }
+            take(node);
+        }
+
+        while (MpscNode* node = shard.queue.pop()) {
+            take(node);
+        }
+
+        shard.queue.reset();
+        if (pending_recycle)
+            freelist_.push(pending_recycle);
+    }
+
+    std::size_t workers_;
+    RecordArena arena_;
+    FreeList freelist_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<bool> run_{false};
+
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> enqueued_{0};
+};
+
+// StressBuilder derived: producer `tid` logs through shard tid % workers
+class ShardedWorkersStress
+    : public harness::StressBuilder<ShardedWorkersStress>
+{
+public:
+    ShardedWorkersStress(harness::StressConfig cfg, std::size_t workers,
+                         std::size_t pool_size = 4096)
+        : StressBuilder(cfg)
+        , engine_(workers, cfg.thread_count, pool_size)
+    {
+        engine_.start();
+    }
+
+    bool do_impl(std::size_t tid, std::size_t iteration) noexcept {
+        // Block-style retry so every record is written: throughput, not drops.
+        while (!engine_.enqueue(StressEnvelope{tid, iteration})) {
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    ShardedStressEngine& engine() noexcept { return engine_; }
+
+private:
+    ShardedStressEngine engine_;
+};
+
+} // namespace stress
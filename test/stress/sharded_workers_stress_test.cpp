@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "stress/sharded_workers_stress.hpp"
+
+using namespace harness;
+using namespace stress;
+
+struct ShardedWorkersTestConfig {
+    StressConfig stress;
+    std::size_t  workers;
+};
+
+class ShardedWorkersStressTest
+    : public ::testing::TestWithParam<ShardedWorkersTestConfig>
+{};
+
+TEST_P(ShardedWorkersStressTest, EveryRecordWrittenOnce) {
+    auto [cfg, workers] = GetParam();
+    ShardedWorkersStress stress{cfg, workers};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    auto& eng = stress.engine();
+    EXPECT_EQ(eng.enqueued(), cfg.thread_count * cfg.iterations_per_thread);
+    EXPECT_EQ(eng.written(), eng.enqueued())
+        << "written=" << eng.written()
+        << " enqueued=" << eng.enqueued()
+        << " — a shard lost records";
+}
+
+TEST_P(ShardedWorkersStressTest, PerProducerOrderPreserved) {
+    auto [cfg, workers] = GetParam();
+    ShardedWorkersStress stress{cfg, workers};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    EXPECT_EQ(stress.engine().order_violations(), 0u);
+    EXPECT_EQ(stress.engine().busy_shards(), std::min(workers, cfg.thread_count));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ShardedWorkersVariants,
+    ShardedWorkersStressTest,
+    ::testing::Values(
+        ShardedWorkersTestConfig{{.thread_count = 4,  .iterations_per_thread = 20000}, 1},
+        ShardedWorkersTestConfig{{.thread_count = 4,  .iterations_per_thread = 20000}, 2},
+        ShardedWorkersTestConfig{{.thread_count = 8,  .iterations_per_thread = 10000}, 4},
+        ShardedWorkersTestConfig{{.thread_count = 2,  .iterations_per_thread = 20000}, 4}
+    ),
+    [](const auto& info) {
+        return "t" + std::to_string(info.param.stress.thread_count)
+             + "_i" + std::to_string(info.param.stress.iterations_per_thread)
+             + "_w" + std::to_string(info.param.workers);
+    }
+);
+
+// Records/s from producer start to the last worker finishing, for 1/2/4
+// workers. Numbers only; scaling needs at least workers + producers cores.
+TEST(ShardedWorkersBench, ThroughputByWorkerCount) {
+    constexpr std::size_t kProducers = 8;
+    constexpr std::size_t kPerThread = 50000;
+
+    std::printf("\n%8s %10s %14s %12s\n", "workers", "ms", "records/s", "pool empty");
+    for (std::size_t workers : {1u, 2u, 4u}) {
+        ShardedWorkersStress stress{{.thread_count = kProducers, .iterations_per_thread = kPerThread}, workers};
+
+        const auto t0 = std::chrono::steady_clock::now();
+        stress.run();
+        stress.engine().shutdown();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        auto& eng = stress.engine();
+        ASSERT_EQ(eng.written(), kProducers * kPerThread);
+
+        const double secs = std::chrono::duration<double>(t1 - t0).count();
+        std::printf("%8zu %10.1f %14.0f %12llu\n", workers, secs * 1e3,
+                    static_cast<double>(eng.written()) / secs,
+                    static_cast<unsigned long long>(eng.dropped()));
+    }
+}
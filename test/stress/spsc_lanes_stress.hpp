@@ -0,0 +1,142 @@
+#pragma once
+
+#include "harness/stress_builder.hpp"
+#include "logger/core/log_record.hpp"
+#include "logger/core/spsc_ring.hpp"
+#include "stress/log_engine_stress.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+using logger::core::detail::LaneSet;
+using logger::core::detail::SpscLane;
+
+// Instantiable copy of the LogEngine SpscLanes path: producers build records
+// in their own ring, the worker round-robins over the lanes. The worker also
+// checks per-producer FIFO order, which the lanes must preserve.
+class LanedStressEngine {
+public:
+    LanedStressEngine(std::size_t max_lanes, std::size_t lane_capacity,
+                      std::size_t burst = 32)
+        : lanes_(max_lanes, lane_capacity)
+        , burst_(burst)
+        , last_seq_(max_lanes, -1)
+    {}
+
+    ~LanedStressEngine() {
+        shutdown();
+    }
+
+    LanedStressEngine(const LanedStressEngine&) = delete;
+    LanedStressEngine& operator=(const LanedStressEngine&) = delete;
+
+    void start() {
+        bool expected = false;
+        if (run_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            worker_ = std::thread(&LanedStressEngine::worker_loop, this);
+        }
+    }
+
+    bool enqueue(const StressEnvelope& env) {
+        SpscLane* lane = lanes_.local();
+        if (!lane) {
+            no_lane_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        LogRecord* slot = lane->try_reserve();
+        if (!slot) {
+            lane->count_dropped();
+            return false;
+        }
+
+        new (slot->storage_ptr()) StressEnvelope{env};
+        lane->commit();
+        lane->count_enqueued();
+        return true;
+    }
+
+    void shutdown() noexcept {
+        bool expected = true;
+        if (run_.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+        }
+    }
+
+    uint64_t dropped()  const noexcept { return lanes_.dropped() + no_lane_.load(std::memory_order_relaxed); }
+    uint64_t enqueued() const noexcept { return lanes_.enqueued(); }
+    uint64_t written()  const noexcept { return written_; }
+    uint64_t order_violations() const noexcept { return order_violations_; }
+    LaneSet& lanes() noexcept { return lanes_; }
+
+private:
+    void consume(LogRecord* rec) noexcept {
+        auto* env = static_cast<StressEnvelope*>(rec->storage_ptr());
+
+        auto& last = last_seq_[env->thread_id];
+        if (static_cast<std::int64_t>(env->sequence) <= last) {
+            ++order_violations_;
+        }
+        last = static_cast<std::int64_t>(env->sequence);
+        ++written_;
+    }
+
+    void worker_loop() {
+        using namespace std::chrono_literals;
+
+        auto fn = [this](LogRecord* rec) { consume(rec); };
+
+        while (run_.load(std::memory_order_acquire) || !lanes_.empty()) {
+            if (lanes_.drain(fn, burst_) == 0) {
+                std::this_thread::sleep_for(50us);
+            }
+        }
+
+        while (lanes_.drain(fn, burst_) != 0) {}
+    }
+
+    LaneSet lanes_;
+    std::size_t burst_;
+    std::atomic<bool> run_{false};
+    std::thread worker_;
+
+    std::atomic<uint64_t> no_lane_{0};
+
+    // worker-only
+    std::vector<std::int64_t> last_seq_;
+    uint64_t written_{0};
+    uint64_t order_violations_{0};
+};
+
+// StressBuilder derived: each producer thread logs through its own lane
+class SpscLanesStress
+    : public harness::StressBuilder<SpscLanesStress>
+{
+public:
+    explicit SpscLanesStress(harness::StressConfig cfg,
+                             std::size_t lane_capacity = 256)
+        : StressBuilder(cfg)
+        , engine_(cfg.thread_count, lane_capacity)
+    {
+        engine_.start();
+    }
+
+    bool do_impl(std::size_t tid, std::size_t iteration) noexcept {
+        return engine_.enqueue(StressEnvelope{tid, iteration});
+    }
+
+    LanedStressEngine& engine() noexcept { return engine_; }
+
+private:
+    LanedStressEngine engine_;
+};
+
+} // namespace stress
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include "stress/spsc_lanes_stress.hpp"
+
+using namespace harness;
+using namespace stress;
+
+struct SpscLanesTestConfig {
+    StressConfig stress;
+    std::size_t  lane_capacity;
+};
+
+class SpscLanesStressTest
+    : public ::testing::TestWithParam<SpscLanesTestConfig>
+{};
+
+TEST_P(SpscLanesStressTest, EnqueuedPlusDroppedEqualsTotal) {
+    auto [cfg, lane_capacity] = GetParam();
+    SpscLanesStress stress{cfg, lane_capacity};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    std::size_t total = cfg.thread_count * cfg.iterations_per_thread;
+    auto& eng = stress.engine();
+
+    EXPECT_EQ(eng.enqueued() + eng.dropped(), total)
+        << "enqueued=" << eng.enqueued()
+        << " dropped=" << eng.dropped()
+        << " total=" << total;
+}
+
+TEST_P(SpscLanesStressTest, WrittenEqualsEnqueued) {
+    auto [cfg, lane_capacity] = GetParam();
+    SpscLanesStress stress{cfg, lane_capacity};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    auto& eng = stress.engine();
+    EXPECT_EQ(eng.written(), eng.enqueued())
+        << "written=" << eng.written()
+        << " enqueued=" << eng.enqueued()
+        << " — worker lost records";
+}
+
+TEST_P(SpscLanesStressTest, PerProducerOrderPreserved) {
+    auto [cfg, lane_capacity] = GetParam();
+    SpscLanesStress stress{cfg, lane_capacity};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    EXPECT_EQ(stress.engine().order_violations(), 0u);
+    // Threads that finish early release their lane, so later threads may
+    // reuse it — never more lanes than producers.
+    EXPECT_LE(stress.engine().lanes().lane_count(), cfg.thread_count);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SpscLanesVariants,
+    SpscLanesStressTest,
+    ::testing::Values(
+        SpscLanesTestConfig{{.thread_count = 1,  .iterations_per_thread = 50000}, 256},
+        SpscLanesTestConfig{{.thread_count = 4,  .iterations_per_thread = 20000}, 256},
+        SpscLanesTestConfig{{.thread_count = 16, .iterations_per_thread = 5000},  64},
+        SpscLanesTestConfig{{.thread_count = 64, .iterations_per_thread = 2000},  16}
+    ),
+    [](const auto& info) {
+        return "t" + std::to_string(info.param.stress.thread_count)
+             + "_i" + std::to_string(info.param.stress.iterations_per_thread)
+             + "_c" + std::to_string(info.param.lane_capacity);
+    }
+);
+
+// A lane released by an exited thread is reused by the next producer
+TEST(SpscLanes, LaneReusedAfterThreadExit) {
+    LanedStressEngine engine{2, 64};
+    engine.start();
+
+    for (int round = 0; round < 8; ++round) {
+        std::thread t([&] { engine.enqueue(StressEnvelope{0, std::size_t(round)}); });
+        t.join();
+    }
+    engine.shutdown();
+
+    EXPECT_EQ(engine.lanes().lane_count(), 1u);
+    EXPECT_EQ(engine.written(), 8u);
+    EXPECT_EQ(engine.order_violations(), 0u);
+}
+
+// Producers beyond max_lanes are refused (LogEngine falls back to MPSC)
+TEST(SpscLanes, ProducersBeyondMaxLanesAreRefused) {
+    LaneSet lanes{1, 16};
+    ASSERT_NE(lanes.local(), nullptr);
+
+    SpscLane* other = reinterpret_cast<SpscLane*>(1);
+    std::thread t([&] { other = lanes.local(); });
+    t.join();
+
+    EXPECT_EQ(other, nullptr);
+}
+
+// Throughput scaling, shared MPSC pipeline vs per-producer lanes.
+// Reports numbers only — absolute values depend on the host.
+TEST(SpscLanesScaling, ThroughputOneToSixtyFourProducers) {
+    constexpr std::size_t kTotal = 256000;
+    constexpr std::size_t kLaneCapacity = 1024;
+    constexpr std::size_t kPoolSize = 1024;
+
+    std::printf("\n%8s %16s %16s %16s %16s\n",
+                "threads", "mpsc calls/s", "mpsc delivered/s",
+                "lanes calls/s", "lanes delivered/s");
+
+    for (std::size_t threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u}) {
+        StressConfig cfg{.thread_count = threads,
+                         .iterations_per_thread = kTotal / threads};
+        const double total = static_cast<double>(cfg.thread_count * cfg.iterations_per_thread);
+
+        LogEngineStress mpsc{cfg, kPoolSize};
+        auto mpsc_result = mpsc.run();
+        mpsc.engine().shutdown();
+        const double mpsc_s = std::chrono::duration<double>(mpsc_result.total_elapsed).count();
+
+        SpscLanesStress lanes{cfg, kLaneCapacity};
+        auto lanes_result = lanes.run();
+        lanes.engine().shutdown();
+        const double lanes_s = std::chrono::duration<double>(lanes_result.total_elapsed).count();
+
+        std::printf("%8zu %16.0f %16.0f %16.0f %16.0f\n", threads,
+                    total / mpsc_s,
+                    static_cast<double>(mpsc.engine().written()) / mpsc_s,
+                    total / lanes_s,
+                    static_cast<double>(lanes.engine().written()) / lanes_s);
+
+        EXPECT_EQ(lanes.engine().written(), lanes.engine().enqueued());
+        EXPECT_EQ(lanes.engine().order_violations(), 0u);
+    }
+}
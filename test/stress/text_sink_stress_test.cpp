@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/log_names.hpp"
+#include "publisher/sink_publisher.hpp"
+
+namespace {
+
+std::string ostream_timestamp(std::uint64_t us_since_epoch) {
+    const auto secs = static_cast<std::time_t>(us_since_epoch / 1'000'000);
+    std::ostringstream oss;
+    oss << std::put_time(std::localtime(&secs), "%Y-%m-%d %H:%M:%S")
+        << '.' << std::setfill('0') << std::setw(6) << us_since_epoch % 1'000'000;
+    return oss.str();
+}
+
+// TextSink::format_impl before the single-pass rewrite: three finds per
+// step, a std::string per parsed number, a std::string result.
+std::string three_find_format(std::string_view line)
+{
+    std::string result;
+    result.reserve(line.size() + 100);
+
+    size_t pos = 0;
+
+    while (pos < line.size()) {
+        auto ts_pos = line.find("timestamp=", pos);
+        if (ts_pos != std::string_view::npos) {
+            result.append(line.substr(pos, ts_pos - pos));
+            result.append("timestamp=");
+
+            auto num_start = ts_pos + 10;
+            auto num_end   = line.find(' ', num_start);
+            if (num_end == std::string_view::npos) num_end = line.size();
+
+            auto ts_str = line.substr(num_start, num_end - num_start);
+            std::uint64_t us = std::stoull(std::string(ts_str));
+            result.append(ostream_timestamp(us));
+
+            pos = num_end;
+            continue;
+        }
+
+        auto class_pos = line.find("class_id=", pos);
+        if (class_pos != std::string_view::npos && (ts_pos == std::string_view::npos || class_pos < ts_pos)) {
+            result.append(line.substr(pos, class_pos - pos));
+            result.append("class_id=");
+
+            auto num_start = class_pos + 9;
+            auto num_end   = line.find(' ', num_start);
+            if (num_end == std::string_view::npos) num_end = line.size();
+
+            auto id_str = line.substr(num_start, num_end - num_start);
+            auto id = static_cast<LogClassId>(std::stoi(std::string(id_str)));
+            result.append(className(id));
+
+            pos = num_end;
+            continue;
+        }
+
+        auto method_pos = line.find("method_id=", pos);
+        if (method_pos != std::string_view::npos &&
+            (ts_pos == std::string_view::npos || method_pos < ts_pos) &&
+            (class_pos == std::string_view::npos || method_pos < class_pos)) {
+            result.append(line.substr(pos, method_pos - pos));
+            result.append("method_id=");
+
+            auto num_start = method_pos + 10;
+            auto num_end   = line.find(' ', num_start);
+            if (num_end == std::string_view::npos) num_end = line.size();
+
+            auto id_str = line.substr(num_start, num_end - num_start);
+            auto id = static_cast<MethodId>(std::stoi(std::string(id_str)));
+            result.append(methodName(id));
+
+            pos = num_end;
+            continue;
+        }
+
+        result.append(line.substr(pos));
+        break;
+    }
+
+    return result;
+}
+
+// Engine-shaped lines: timestamp first, then the ids, then a path.
+std::vector<std::string> make_lines(std::size_t n) {
+    std::vector<std::string> lines;
+    for (std::size_t i = 0; i < n; ++i) {
+        lines.push_back("[tag=1] severity=Info timestamp=" + std::to_string(1'700'000'000'000'000ull + i * 997) +
+                        " thread_id=" + std::to_string(i % 8) + " request_id=" + std::to_string(i * 31) +
+                        " class_id=" + std::to_string(i % 2) + " method_id=" + std::to_string(i % 3) +
+                        " schema_version=1 path=/api/v1/orders/" + std::to_string(i));
+    }
+    return lines;
+}
+
+template <typename Fn>
+double ns_per_line(const std::vector<std::string>& lines, Fn&& fn, std::size_t rounds) {
+    std::size_t sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t r = 0; r < rounds; ++r)
+        for (const auto& l : lines)
+            sink += fn(l);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    EXPECT_GT(sink, 0u);
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+           static_cast<double>(rounds * lines.size());
+}
+
+} // namespace
+
+// The rewrite must render engine-shaped lines exactly as before.
+TEST(TextSinkStress, MatchesThreeFindFormatter) {
+    for (const auto& l : make_lines(2000))
+        ASSERT_EQ(TextSink::format(l), three_find_format(l)) << l;
+}
+
+// ns per line. Numbers only; absolute values depend on the host.
+TEST(TextSinkBench, ThreeFindVsSinglePass) {
+    const auto lines = make_lines(1024);
+    constexpr std::size_t kRounds = 50;
+
+    const double old_ns = ns_per_line(lines, [](const std::string& l) { return three_find_format(l).size(); }, kRounds);
+    const double str_ns = ns_per_line(lines, [](const std::string& l) { return TextSink::format(l).size(); }, kRounds);
+    const double buf_ns = ns_per_line(lines, [](const std::string& l) {
+        char buf[512];
+        return TextSink::format_to(l, buf, sizeof(buf));
+    }, kRounds);
+
+    std::printf("\n%28s %10s %10s\n", "formatter", "ns/line", "speedup");
+    std::printf("%28s %10.1f %9.2fx\n", "three finds + std::string", old_ns, 1.0);
+    std::printf("%28s %10.1f %9.2fx\n", "single pass -> std::string", str_ns, old_ns / str_ns);
+    std::printf("%28s %10.1f %9.2fx\n", "single pass -> buffer", buf_ns, old_ns / buf_ns);
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "harness/stress_builder.hpp"
+#include "logger/core/lockfree_queue.hpp"
+#include "logger/core/log_record.hpp"
+#include "logger/core/wait_strategy.hpp"
+#include "stress/log_engine_stress.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace stress {
+
+using logger::core::WaitConfig;
+using logger::core::WaitStrategy;
+using logger::core::detail::WorkerWaiter;
+
+// Envelope stamped at enqueue; the worker measures enqueue-to-sink latency.
+struct TimedEnvelope {
+    std::chrono::steady_clock::time_point t0;
+};
+static_assert(sizeof(TimedEnvelope) <= LogRecord::StorageSize);
+
+// Copy of the LogEngine Mpsc path with the production WorkerWaiter in place
+// of the fixed sleep. The worker records one latency sample per record.
+class WaitingStressEngine {
+public:
+    WaitingStressEngine(const WaitConfig& wait, std::size_t pool_size = 1024,
+                        std::size_t max_samples = 0)
+        : pool_size_(pool_size)
+        , pool_(std::make_unique<LogRecord[]>(pool_size))
+        , waiter_(wait)
+    {
+        for (std::size_t i = 0; i < pool_size_; ++i) {
+            freelist_.push(&pool_[i]);
+        }
+        samples_.reserve(max_samples);
+    }
+
+    ~WaitingStressEngine() {
+        shutdown();
+    }
+
+    WaitingStressEngine(const WaitingStressEngine&) = delete;
+    WaitingStressEngine& operator=(const WaitingStressEngine&) = delete;
+
+    void start() {
+        bool expected = false;
+        if (run_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            worker_ = std::thread(&WaitingStressEngine::worker_loop, this);
+        }
+    }
+
+    bool enqueue() {
+        LogRecord* rec = static_cast<LogRecord*>(freelist_.try_pop());
+        if (!rec) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        new (rec->storage_ptr()) TimedEnvelope{std::chrono::steady_clock::now()};
+
+        queue_.push(rec);
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        waiter_.notify();
+        return true;
+    }
+
+    void shutdown() noexcept {
+        bool expected = true;
+        if (run_.compare_exchange_strong(expected, false, std::memory_order_seq_cst)) {
+            waiter_.wake_all();
+            if (worker_.joinable()) {
+                worker_.join();
+            }
+        }
+    }
+
+    uint64_t dropped()  const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t enqueued() const noexcept { return enqueued_.load(std::memory_order_relaxed); }
+    uint64_t written()  const noexcept { return written_.load(std::memory_order_relaxed); }
+    uint64_t parks()    const noexcept { return waiter_.parks(); }
+    uint64_t wakeups()  const noexcept { return waiter_.wakeups(); }
+
+    // Valid after shutdown(); samples in nanoseconds, sorted.
+    std::vector<uint64_t> sorted_samples() const {
+        std::vector<uint64_t> s = samples_;
+        std::sort(s.begin(), s.end());
+        return s;
+    }
+
+private:
+    bool has_work() const noexcept {
+        return !run_.load(std::memory_order_acquire) || !queue_.empty();
+    }
+
+    void process(LogRecord* rec) {
+        const auto now = std::chrono::steady_clock::now();
+        auto* env = std::launder(static_cast<TimedEnvelope*>(rec->storage_ptr()));
+        if (samples_.size() < samples_.capacity()) {
+            samples_.push_back(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - env->t0).count()));
+        }
+        written_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void worker_loop() {
+        LogRecord* pending_recycle = nullptr;
+
+        auto drain = [&] {
+            std::size_t n = 0;
+            while (MpscNode* node = queue_.pop()) {
+                if (pending_recycle) {
+                    freelist_.push(pending_recycle);
+                }
+                LogRecord* rec = static_cast<LogRecord*>(node);
+                process(rec);
+                pending_recycle = rec;
+                ++n;
+            }
+            return n;
+        };
+
+        while (run_.load(std::memory_order_acquire) || !queue_.empty()) {
+            if (drain() != 0) {
+                waiter_.reset();
+                continue;
+            }
+            waiter_.idle([this] { return has_work(); });
+        }
+
+        drain();
+        queue_.reset();
+        if (pending_recycle)
+            freelist_.push(pending_recycle);
+    }
+
+    std::size_t pool_size_;
+    std::unique_ptr<LogRecord[]> pool_;
+    FreeList freelist_;
+    MpscQueue queue_;
+    WorkerWaiter waiter_;
+    std::atomic<bool> run_{false};
+    std::thread worker_;
+
+    std::vector<uint64_t> samples_;     // worker-only until shutdown
+
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> written_{0};
+};
+
+// StressBuilder derived: concurrent producers against a waiting worker
+class WaitStrategyStress
+    : public harness::StressBuilder<WaitStrategyStress>
+{
+public:
+    WaitStrategyStress(harness::StressConfig cfg, const WaitConfig& wait)
+        : StressBuilder(cfg)
+        , engine_(wait)
+    {
+        engine_.start();
+    }
+
+    bool do_impl(std::size_t, std::size_t) noexcept {
+        return engine_.enqueue();
+    }
+
+    WaitingStressEngine& engine() noexcept { return engine_; }
+
+private:
+    WaitingStressEngine engine_;
+};
+
+} // namespace stress
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include "stress/wait_strategy_stress.hpp"
+
+using namespace harness;
+using namespace stress;
+using namespace std::chrono_literals;
+
+struct WaitStrategyTestConfig {
+    StressConfig stress;
+    WaitStrategy strategy;
+};
+
+class WaitStrategyStressTest
+    : public ::testing::TestWithParam<WaitStrategyTestConfig>
+{};
+
+TEST_P(WaitStrategyStressTest, WrittenEqualsEnqueued) {
+    auto [cfg, strategy] = GetParam();
+    WaitStrategyStress stress{cfg, WaitConfig{.strategy = strategy}};
+
+    stress.run();
+    stress.engine().shutdown();
+
+    std::size_t total = cfg.thread_count * cfg.iterations_per_thread;
+    auto& eng = stress.engine();
+
+    EXPECT_EQ(eng.enqueued() + eng.dropped(), total);
+    EXPECT_EQ(eng.written(), eng.enqueued())
+        << "written=" << eng.written()
+        << " enqueued=" << eng.enqueued()
+        << " — worker missed a wake-up";
+}
+
+// Producers that pause between records keep sending the worker to sleep;
+// every record must still be delivered without relying on shutdown.
+TEST_P(WaitStrategyStressTest, DeliversAcrossIdleGaps) {
+    auto [cfg, strategy] = GetParam();
+    WaitingStressEngine eng{WaitConfig{.strategy = strategy,
+                                       .spin_rounds = 16,
+                                       .yield_rounds = 4}};
+    eng.start();
+
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(eng.enqueue());
+        std::this_thread::sleep_for(200us);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (eng.written() != 50 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(1ms);
+
+    EXPECT_EQ(eng.written(), 50u);
+    eng.shutdown();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    WaitStrategyVariants,
+    WaitStrategyStressTest,
+    ::testing::Values(
+        WaitStrategyTestConfig{{.thread_count = 4, .iterations_per_thread = 20000}, WaitStrategy::Sleep},
+        WaitStrategyTestConfig{{.thread_count = 4, .iterations_per_thread = 20000}, WaitStrategy::Spin},
+        WaitStrategyTestConfig{{.thread_count = 4, .iterations_per_thread = 20000}, WaitStrategy::Yield},
+        WaitStrategyTestConfig{{.thread_count = 4, .iterations_per_thread = 20000}, WaitStrategy::Park},
+        WaitStrategyTestConfig{{.thread_count = 8, .iterations_per_thread = 10000}, WaitStrategy::Adaptive}
+    ),
+    [](const auto& info) {
+        return std::string(logger::core::toString(info.param.strategy))
+             + "_t" + std::to_string(info.param.stress.thread_count)
+             + "_i" + std::to_string(info.param.stress.iterations_per_thread);
+    }
+);
+
+// A parked worker must be released by shutdown() alone
+TEST(WaitStrategy, ShutdownWakesParkedWorker) {
+    WaitingStressEngine eng{WaitConfig{.strategy = WaitStrategy::Park}};
+    eng.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (eng.parks() == 0 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(1ms);
+    ASSERT_GT(eng.parks(), 0u);
+
+    eng.shutdown();
+    EXPECT_EQ(eng.written(), 0u);
+}
+
+// Producers only pay for a notify when the worker is actually parked
+TEST(WaitStrategy, BurstNotifiesAtMostOncePerPark) {
+    WaitingStressEngine eng{WaitConfig{.strategy = WaitStrategy::Park}};
+    eng.start();
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 100; ++i)
+            eng.enqueue();
+        std::this_thread::sleep_for(2ms);
+    }
+    eng.shutdown();
+
+    EXPECT_EQ(eng.written(), eng.enqueued());
+    EXPECT_LE(eng.wakeups(), eng.parks());
+    EXPECT_LT(eng.wakeups(), eng.enqueued());
+}
+
+// Enqueue-to-sink latency per strategy for a producer that goes quiet
+// between records — the case the fixed sleep punished. Reports numbers
+// only; absolute values depend on the host (and on core count: Spin on a
+// single core competes with the producer it is waiting for).
+TEST(WaitStrategyLatency, EnqueueToSinkPercentiles) {
+    constexpr std::size_t kSamples = 2000;
+
+    std::printf("\n%10s %12s %12s %12s %10s\n",
+                "strategy", "p50 ns", "p99 ns", "p999 ns", "parks");
+
+    for (WaitStrategy s : {WaitStrategy::Sleep, WaitStrategy::Spin,
+                           WaitStrategy::Yield, WaitStrategy::Park,
+                           WaitStrategy::Adaptive}) {
+        WaitingStressEngine eng{WaitConfig{.strategy = s}, 1024, kSamples};
+        eng.start();
+
+        for (std::size_t i = 0; i < kSamples; ++i) {
+            eng.enqueue();
+            // Idle gap long enough for Adaptive to reach its park phase
+            std::this_thread::sleep_for(100us);
+        }
+        eng.shutdown();
+
+        const auto samples = eng.sorted_samples();
+        ASSERT_EQ(samples.size(), kSamples);
+        auto pct = [&](double p) {
+            return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))];
+        };
+
+        std::printf("%10s %12llu %12llu %12llu %10llu\n",
+                    logger::core::toString(s),
+                    static_cast<unsigned long long>(pct(0.50)),
+                    static_cast<unsigned long long>(pct(0.99)),
+                    static_cast<unsigned long long>(pct(0.999)),
+                    static_cast<unsigned long long>(eng.parks()));
+    }
+}